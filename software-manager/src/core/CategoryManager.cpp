@@ -1,57 +1,79 @@
 #include "CategoryManager.hpp"
+#include "DatabaseExecutor.hpp"
+#include "DatabaseReaderPool.hpp"
 #include <QSettings>
-#include <QStandardPaths>
-#include <QDir>
 #include <QRegularExpression>
 #include "../utils/Logging.hpp"
 
-CategoryManager::CategoryManager(QObject* parent)
+CategoryManager::CategoryManager(DatabaseExecutor* databaseExecutor, DatabaseReaderPool* databaseReaders, QObject* parent)
     : QObject(parent)
+    , m_databaseExecutor(databaseExecutor)
+    , m_databaseReaders(databaseReaders)
+    , m_reloadPending(false)
+    , m_reloadGeneration(0)
 {
     // 添加默认分类
-    m_categories << "所有软件" << "未分类";
+    Snapshot initial;
+    initial.categories << "所有软件" << "未分类";
+    publish(initial);
     
-    // 加载保存的分类
-    loadCategories();
+    m_changeTimer.setSingleShot(true);
+    m_changeTimer.setInterval(100);
+    connect(&m_changeTimer, &QTimer::timeout, this, &CategoryManager::onChangeTimeout);
+}
+
+void CategoryManager::load()
+{
+    if (!m_databaseExecutor) {
+        return;
+    }
+    
+    // 导入在数据库线程中写入，提交后读连接才能读到导入的分类
+    importLegacyCategories().then(this, [this]() {
+        reload();
+    });
 }
 
 QStringList CategoryManager::getCategories() const
 {
-    QMutexLocker locker(&m_mutex);
-    return m_categories;
+    return snapshot()->categories;
 }
 
 bool CategoryManager::addCategory(const QString& name)
 {
-    QMutexLocker locker(&m_mutex);
-    
     if (!validateCategoryName(name)) {
         qCWarning(softwareManager) << "分类名称无效:" << name;
         return false;
     }
     
+    // 已存在视为成功
     if (categoryExists(name)) {
-        qCWarning(softwareManager) << "分类已存在:" << name;
-        return false;
+        return true;
     }
     
-    m_categories.append(name);
-    m_categorySoftwareCount[name] = 0;
-    
-    saveCategories();
-    
-    emit categoryAdded(name);
+    if (!m_databaseExecutor) {
+        return false;
+    }
     
-    qCInfo(softwareManager) << "成功添加分类:" << name;
+    m_databaseExecutor->run([name](DatabaseManager& databaseManager) {
+        return databaseManager.addCategory(name);
+    }).then(this, [this, name](bool success) {
+        if (!success) {
+            qCWarning(softwareManager) << "添加分类失败:" << name;
+            return;
+        }
+        
+        emit categoryAdded(name);
+        reload();
+        qCInfo(softwareManager) << "成功添加分类:" << name;
+    });
     return true;
 }
 
 bool CategoryManager::renameCategory(const QString& oldName, const QString& newName)
 {
-    QMutexLocker locker(&m_mutex);
-    
-    if (!categoryExists(oldName)) {
-        qCWarning(softwareManager) << "分类不存在:" << oldName;
+    if (!categoryExists(oldName) || isBuiltInCategory(oldName)) {
+        qCWarning(softwareManager) << "分类不存在或为内置分类:" << oldName;
         return false;
     }
     
@@ -65,31 +87,28 @@ bool CategoryManager::renameCategory(const QString& oldName, const QString& newN
         return false;
     }
     
-    // 更新分类列表
-    int index = m_categories.indexOf(oldName);
-    if (index != -1) {
-        m_categories[index] = newName;
-    }
-    
-    // 更新软件计数映射
-    if (m_categorySoftwareCount.contains(oldName)) {
-        int count = m_categorySoftwareCount[oldName];
-        m_categorySoftwareCount.remove(oldName);
-        m_categorySoftwareCount[newName] = count;
+    if (!m_databaseExecutor) {
+        return false;
     }
     
-    saveCategories();
-    
-    emit categoryRenamed(oldName, newName);
-    
-    qCInfo(softwareManager) << "成功重命名分类:" << oldName << "->" << newName;
+    // 软件项按id引用分类，数据库中只改名称，计数随之保留
+    m_databaseExecutor->run([oldName, newName](DatabaseManager& databaseManager) {
+        return databaseManager.renameCategory(oldName, newName);
+    }).then(this, [this, oldName, newName](bool success) {
+        if (!success) {
+            qCWarning(softwareManager) << "重命名分类失败:" << oldName << "->" << newName;
+            return;
+        }
+        
+        emit categoryRenamed(oldName, newName);
+        reload();
+        qCInfo(softwareManager) << "成功重命名分类:" << oldName << "->" << newName;
+    });
     return true;
 }
 
 bool CategoryManager::removeCategory(const QString& name)
 {
-    QMutexLocker locker(&m_mutex);
-    
     if (!categoryExists(name)) {
         qCWarning(softwareManager) << "分类不存在:" << name;
         return false;
@@ -101,27 +120,32 @@ bool CategoryManager::removeCategory(const QString& name)
         return false;
     }
     
-    m_categories.removeAll(name);
-    m_categorySoftwareCount.remove(name);
-    
-    saveCategories();
-    
-    emit categoryRemoved(name);
+    if (!m_databaseExecutor) {
+        return false;
+    }
     
-    qCInfo(softwareManager) << "成功删除分类:" << name;
+    m_databaseExecutor->run([name](DatabaseManager& databaseManager) {
+        return databaseManager.removeCategory(name);
+    }).then(this, [this, name](bool success) {
+        if (!success) {
+            qCWarning(softwareManager) << "删除分类失败:" << name;
+            return;
+        }
+        
+        emit categoryRemoved(name);
+        reload();
+        qCInfo(softwareManager) << "成功删除分类:" << name;
+    });
     return true;
 }
 
 bool CategoryManager::categoryExists(const QString& name) const
 {
-    QMutexLocker locker(&m_mutex);
-    return m_categories.contains(name);
+    return snapshot()->categories.contains(name);
 }
 
 bool CategoryManager::validateCategoryName(const QString& name) const
 {
-    QMutexLocker locker(&m_mutex);
-    
     // 检查名称是否为空
     if (name.trimmed().isEmpty()) {
         return false;
@@ -133,7 +157,7 @@ bool CategoryManager::validateCategoryName(const QString& name) const
     }
     
     // 检查是否包含非法字符
-    QRegularExpression invalidChars(QStringLiteral("[<>:\"/\\\\|?*]"));
+    static const QRegularExpression invalidChars(QStringLiteral("[<>:\"/\\\\|?*]"));
     if (invalidChars.match(name).hasMatch()) {
         return false;
     }
@@ -143,73 +167,140 @@ bool CategoryManager::validateCategoryName(const QString& name) const
 
 int CategoryManager::getCategoryCount(const QString& category) const
 {
-    QMutexLocker locker(&m_mutex);
-    
-    if (m_categorySoftwareCount.contains(category)) {
-        return m_categorySoftwareCount[category];
-    }
-    
-    return 0;
+    return snapshot()->counts.value(category, 0);
+}
+
+QHash<QString, int> CategoryManager::getCategoryCounts() const
+{
+    return snapshot()->counts;
 }
 
 bool CategoryManager::moveSoftwareToCategory(const QString& softwareId, const QString& newCategory)
 {
-    QMutexLocker locker(&m_mutex);
-    
-    // 检查分类是否存在
-    if (!categoryExists(newCategory)) {
+    // 检查分类是否存在（“所有软件”只用于显示，不能作为目标）
+    if (!categoryExists(newCategory) || newCategory == "所有软件") {
         qCWarning(softwareManager) << "目标分类不存在:" << newCategory;
         return false;
     }
     
-    // 更新软件计数（实际实现中需要从数据库获取当前分类）
-    // 这里简化处理，只更新目标分类计数
-    m_categorySoftwareCount[newCategory] = m_categorySoftwareCount[newCategory] + 1;
-    
-    emit softwareCategoryChanged(softwareId, newCategory);
+    if (!m_databaseExecutor) {
+        return false;
+    }
     
-    qCInfo(softwareManager) << "成功移动软件到分类:" << softwareId << "->" << newCategory;
+    // 原分类和新分类的计数由数据库触发器同时更新
+    m_databaseExecutor->run([softwareId, newCategory](DatabaseManager& databaseManager) {
+        return databaseManager.moveSoftwareToCategory(softwareId, newCategory);
+    }).then(this, [this, softwareId, newCategory](bool success) {
+        if (!success) {
+            qCWarning(softwareManager) << "移动软件到分类失败:" << softwareId << "->" << newCategory;
+            return;
+        }
+        
+        emit softwareCategoryChanged(softwareId, newCategory);
+        reload();
+        qCInfo(softwareManager) << "成功移动软件到分类:" << softwareId << "->" << newCategory;
+    });
     return true;
 }
 
+void CategoryManager::scheduleRefresh()
+{
+    m_reloadPending = true;
+    notifyChanged();
+}
+
 QString CategoryManager::getDefaultCategory() const
 {
     return "未分类";
 }
 
-void CategoryManager::loadCategories()
+std::shared_ptr<const CategoryManager::Snapshot> CategoryManager::snapshot() const
 {
-    QSettings settings;
-    QStringList savedCategories = settings.value("categories").toStringList();
+    // 旧的快照在最后一个读取者释放后才销毁
+    return std::atomic_load(&m_snapshot);
+}
+
+void CategoryManager::publish(Snapshot next)
+{
+    // 只有所属线程写入，直接替换即可，不需要比较交换
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::make_shared<Snapshot>(std::move(next))));
+}
+
+void CategoryManager::reload()
+{
+    if (!m_databaseReaders) {
+        return;
+    }
     
-    // 合并保存的分类和默认分类
-    for (const QString& category : savedCategories) {
-        if (!m_categories.contains(category) && !isBuiltInCategory(category)) {
-            m_categories.append(category);
+    // 计数表包含全部分类，一次查询同时得到名称和计数；结果回到所属线程后再发布
+    const int generation = ++m_reloadGeneration;
+    m_databaseReaders->getCategoryCountsAsync().then(this, [this, generation](const QHash<QString, int>& counts) {
+        if (generation != m_reloadGeneration) {
+            return;
+        }
+        
+        Snapshot next;
+        next.counts = counts;
+        
+        QStringList names = next.counts.keys();
+        names.sort();
+        next.categories << "所有软件" << "未分类";
+        for (const QString& name : names) {
+            if (!isBuiltInCategory(name)) {
+                next.categories.append(name);
+            }
         }
+        
+        publish(std::move(next));
+        notifyChanged();
+    });
+}
+
+void CategoryManager::notifyChanged()
+{
+    if (!m_changeTimer.isActive()) {
+        m_changeTimer.start();
     }
-    
-    qCInfo(softwareManager) << "成功加载分类列表，共" << m_categories.size() << "个分类";
 }
 
-void CategoryManager::saveCategories()
+void CategoryManager::onChangeTimeout()
 {
+    // 需要重新读取时等读取完成后再通知
+    if (m_reloadPending) {
+        m_reloadPending = false;
+        reload();
+        return;
+    }
+    emit categoriesChanged();
+}
+
+QFuture<void> CategoryManager::importLegacyCategories()
+{
+    // 旧版本把用户分类保存在QSettings中，导入数据库后删除，以后只以数据库为准
+    QStringList savedCategories;
     QSettings settings;
-    
-    // 只保存非内置分类
-    QStringList userCategories;
-    for (const QString& category : m_categories) {
-        if (!isBuiltInCategory(category)) {
-            userCategories.append(category);
+    for (const QString& category : settings.value("categories").toStringList()) {
+        if (validateCategoryName(category) && !isBuiltInCategory(category)) {
+            savedCategories.append(category);
         }
     }
+    const bool hasLegacyCategories = settings.contains("categories");
     
-    settings.setValue("categories", userCategories);
-    
-    qCInfo(softwareManager) << "成功保存分类列表";
+    return m_databaseExecutor->run([savedCategories](DatabaseManager& databaseManager) {
+        bool success = true;
+        for (const QString& category : savedCategories) {
+            success = databaseManager.addCategory(category) && success;
+        }
+        return success;
+    }).then(this, [hasLegacyCategories, savedCategories](bool success) {
+        if (hasLegacyCategories && success) {
+            QSettings().remove("categories");
+            qCInfo(softwareManager) << "已将" << savedCategories.size() << "个分类从设置导入数据库";
+        }
+    });
 }
 
 bool CategoryManager::isBuiltInCategory(const QString& name) const
 {
     return name == "所有软件" || name == "未分类";
-}
\ No newline at end of file
+}
@@ -3,16 +3,29 @@
 
 #include <QObject>
 #include <QStringList>
-#include <QMap>
-#include <QMutex>
+#include <QHash>
+#include <QTimer>
+#include <QFuture>
+#include <memory>
 
+class DatabaseExecutor;
+class DatabaseReaderPool;
+
+// 分类服务：分类和每个分类的软件项数以数据库为准，内存中只保留一份不可变的快照供读取。
+// 快照通过原子的共享指针发布，任何线程读取时都不加锁，拿到的快照在使用期间不会变化；
+// 写入交给数据库线程，计数从只读连接池读取，所属线程不等待数据库I/O，
+// 读取完成后在所属线程中构建新的快照整体替换，短时间内的多次变化合并为一次categoriesChanged通知
 class CategoryManager : public QObject {
     Q_OBJECT
 
 public:
-    explicit CategoryManager(QObject* parent = nullptr);
+    CategoryManager(DatabaseExecutor* databaseExecutor, DatabaseReaderPool* databaseReaders, QObject* parent = nullptr);
+    
+    // 从数据库异步加载分类，完成后通知categoriesChanged；第一次运行时导入旧版本保存在QSettings中的分类
+    void load();
     
-    // 分类管理方法
+    // 分类管理方法：修改只按当前快照检查参数，返回false表示请求无效；
+    // 写入在数据库线程中完成，成功后发出对应的信号并刷新快照
     QStringList getCategories() const;
     bool addCategory(const QString& name);
     bool renameCategory(const QString& oldName, const QString& newName);
@@ -22,8 +35,12 @@ public:
     
     // 软件分类关联方法
     int getCategoryCount(const QString& category) const;
+    QHash<QString, int> getCategoryCounts() const;
     bool moveSoftwareToCategory(const QString& softwareId, const QString& newCategory);
     
+    // 软件项在其他连接上增删后调用，稍后合并重新读取计数
+    void scheduleRefresh();
+    
     // 默认分类
     QString getDefaultCategory() const;
     
@@ -34,15 +51,35 @@ signals:
     void categoryRenamed(const QString& oldName, const QString& newName);
     void softwareCategoryChanged(const QString& softwareId, const QString& newCategory);
     
+    // 分类列表或计数发生变化
+    void categoriesChanged();
+    
 private:
-    QStringList m_categories;
-    QMap<QString, int> m_categorySoftwareCount;
-    mutable QMutex m_mutex;
+    // 分类列表（内置分类在前，其余按名称排序）和每个分类的软件项数
+    struct Snapshot {
+        QStringList categories;
+        QHash<QString, int> counts;
+    };
+    
+    DatabaseExecutor* m_databaseExecutor;
+    DatabaseReaderPool* m_databaseReaders;
+    
+    // 只通过std::atomic_load/std::atomic_store访问
+    std::shared_ptr<const Snapshot> m_snapshot;
+    QTimer m_changeTimer;
+    bool m_reloadPending;
+    
+    // 读连接池中的查询不一定按提交顺序完成，只发布最后一次读取的结果
+    int m_reloadGeneration;
     
     // 私有方法
-    void loadCategories();
-    void saveCategories();
+    std::shared_ptr<const Snapshot> snapshot() const;
+    void publish(Snapshot next);
+    void reload();
+    void notifyChanged();
+    void onChangeTimeout();
+    QFuture<void> importLegacyCategories();
     bool isBuiltInCategory(const QString& name) const;
 };
 
-#endif // CATEGORYMANAGER_H
\ No newline at end of file
+#endif // CATEGORYMANAGER_H
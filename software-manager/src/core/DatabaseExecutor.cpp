@@ -0,0 +1,156 @@
+#include "DatabaseExecutor.hpp"
+#include "../utils/Logging.hpp"
+#include <QPointer>
+
+DatabaseExecutor::DatabaseExecutor(const QString& dbPath, DatabaseManager::OpenMode mode, QObject* parent)
+    : QObject(parent)
+    , m_dbPath(dbPath.isEmpty() ? DatabaseManager::defaultDatabasePath() : dbPath)
+    , m_openMode(mode)
+    , m_pendingRequests(0)
+    , m_context(new QObject())
+    , m_databaseManager(nullptr)
+{
+    m_thread.setObjectName("DatabaseExecutor");
+    m_context->moveToThread(&m_thread);
+    m_thread.start();
+    
+    // 写连接的建表和迁移是线程中的第一个请求，之后提交的请求（包括第一页的读取）都排在它后面；
+    // 只读连接在第一个请求时才打开，首次运行时数据库文件由写连接创建
+    if (m_openMode == DatabaseManager::ReadWrite) {
+        QMetaObject::invokeMethod(m_context, [this]() {
+            connection();
+        }, Qt::QueuedConnection);
+    }
+}
+
+DatabaseExecutor::~DatabaseExecutor()
+{
+    // 排在此前所有请求之后关闭连接，阻塞到关闭完成
+    QMetaObject::invokeMethod(m_context, [this]() {
+        delete m_databaseManager;
+        m_databaseManager = nullptr;
+    }, Qt::BlockingQueuedConnection);
+    
+    m_thread.quit();
+    m_thread.wait();
+    delete m_context;
+}
+
+QFuture<QList<SoftwareItem>> DatabaseExecutor::getAllSoftwareItemsAsync()
+{
+    return run([](DatabaseManager& databaseManager) {
+        return databaseManager.getAllSoftwareItems();
+    });
+}
+
+QFuture<QList<SoftwareItem>> DatabaseExecutor::getSoftwareItemsByCategoryAsync(const QString& category)
+{
+    return run([category](DatabaseManager& databaseManager) {
+        return databaseManager.getSoftwareItemsByCategory(category);
+    });
+}
+
+QFuture<SoftwareItem> DatabaseExecutor::getSoftwareItemByIdAsync(const QString& id)
+{
+    return run([id](DatabaseManager& databaseManager) {
+        return databaseManager.getSoftwareItemById(id);
+    });
+}
+
+QFuture<bool> DatabaseExecutor::removeSoftwareItemAsync(const QString& id)
+{
+    return run([id](DatabaseManager& databaseManager) {
+        return databaseManager.removeSoftwareItem(id);
+    });
+}
+
+QFuture<QList<DirectorySnapshot>> DatabaseExecutor::getDirectorySnapshotsAsync()
+{
+    return run([](DatabaseManager& databaseManager) {
+        return databaseManager.getDirectorySnapshots();
+    });
+}
+
+QFuture<bool> DatabaseExecutor::restoreDatabaseAsync(const QString& backupPath)
+{
+    return run([backupPath](DatabaseManager& databaseManager) {
+        return databaseManager.restoreDatabase(backupPath);
+    });
+}
+
+QFuture<int> DatabaseExecutor::streamSoftwareItemsAsync(const QString& category, int pageSize, QObject* context,
+                                                         std::function<void(const QList<SoftwareItem>& page, int offset)> onPage,
+                                                         DatabaseManager::SortOrder order)
+{
+    pageSize = qMax(1, pageSize);
+    
+    // 取消通过返回的future进行，读取线程和送页回调都据此停止
+    auto promise = std::make_shared<QPromise<int>>();
+    QFuture<int> future = promise->future();
+    promise->start();
+    
+    QPointer<QObject> guard(context);
+    run([category, pageSize, guard, onPage, order, promise](DatabaseManager& databaseManager) {
+        QList<SoftwareItem> page;
+        page.reserve(pageSize);
+        int count = 0;
+        
+        auto deliver = [&]() {
+            const int offset = count - page.size();
+            QObject* receiver = guard.data();
+            if (receiver) {
+                QMetaObject::invokeMethod(receiver, [onPage, promise, page = std::move(page), offset]() {
+                    if (!promise->isCanceled()) {
+                        onPage(page, offset);
+                    }
+                }, Qt::QueuedConnection);
+            }
+            page = QList<SoftwareItem>();
+            page.reserve(pageSize);
+        };
+        
+        // context已销毁或读取已取消时停止遍历，其余的行不再读取
+        databaseManager.forEachSoftwareItem(category, [&](const SoftwareItem& item) {
+            if (guard.isNull() || promise->isCanceled()) {
+                return false;
+            }
+            page.append(item);
+            ++count;
+            if (page.size() == pageSize) {
+                deliver();
+            }
+            return true;
+        }, order);
+        if (!page.isEmpty() && !guard.isNull() && !promise->isCanceled()) {
+            deliver();
+        }
+        
+        promise->addResult(count);
+        promise->finish();
+    });
+    
+    return future;
+}
+
+DatabaseManager& DatabaseExecutor::connection()
+{
+    // 连接必须在使用它的线程中创建
+    if (!m_databaseManager) {
+        m_databaseManager = new DatabaseManager(m_dbPath, m_openMode);
+        if (!m_databaseManager->initializeDatabase()) {
+            qCWarning(softwareManager) << "数据库线程无法初始化数据库";
+        }
+    }
+    return *m_databaseManager;
+}
+
+int DatabaseExecutor::pendingRequests() const
+{
+    return m_pendingRequests.loadRelaxed();
+}
+
+void DatabaseExecutor::waitForIdle()
+{
+    // 请求按顺序执行，空请求执行完时此前的请求都已完成
+    QMetaObject::invokeMethod(m_context, []() {}, Qt::BlockingQueuedConnection);
+}
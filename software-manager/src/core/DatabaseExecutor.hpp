@@ -0,0 +1,93 @@
+#ifndef DATABASEEXECUTOR_H
+#define DATABASEEXECUTOR_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QPromise>
+#include <QAtomicInt>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include "DatabaseManager.hpp"
+
+// 专用的数据库线程：线程内有自己的DatabaseManager和数据库连接，
+// 所有请求按提交顺序逐个执行，GUI线程不再等待数据库I/O。
+// 结果通过QFuture返回，使用future.then(context, ...)时回调以排队方式在context所在线程执行
+class DatabaseExecutor : public QObject {
+    Q_OBJECT
+
+public:
+    // dbPath为空时使用默认的数据库文件；写执行器先在数据库线程中建表和迁移，
+    // 只读执行器用于读连接池，第一个请求时才打开，不建表
+    explicit DatabaseExecutor(const QString& dbPath = QString(),
+                              DatabaseManager::OpenMode mode = DatabaseManager::ReadWrite,
+                              QObject* parent = nullptr);
+    ~DatabaseExecutor();
+    
+    // 在数据库线程上执行任意操作，function的参数是线程内的DatabaseManager
+    template <typename Function>
+    QFuture<std::invoke_result_t<Function, DatabaseManager&>> run(Function function);
+    
+    // 常用操作的异步版本
+    QFuture<QList<SoftwareItem>> getAllSoftwareItemsAsync();
+    QFuture<QList<SoftwareItem>> getSoftwareItemsByCategoryAsync(const QString& category);
+    QFuture<SoftwareItem> getSoftwareItemByIdAsync(const QString& id);
+    QFuture<bool> removeSoftwareItemAsync(const QString& id);
+    QFuture<QList<DirectorySnapshot>> getDirectorySnapshotsAsync();
+    QFuture<bool> restoreDatabaseAsync(const QString& backupPath);
+    
+    // 按order的顺序分页读取软件项（category为空时读取全部），每读满一页就以排队方式在context所在线程调用onPage，
+    // 第一页不必等待其余的行；所有页在一个查询中读取，不会与其间的写入交错。返回读取的总数。
+    // 对返回的future调用cancel()或销毁context后，读取在下一行停止，尚未送达的页也被丢弃
+    QFuture<int> streamSoftwareItemsAsync(const QString& category, int pageSize, QObject* context,
+                                          std::function<void(const QList<SoftwareItem>& page, int offset)> onPage,
+                                          DatabaseManager::SortOrder order = DatabaseManager::SortByName);
+    
+    // 等待此前提交的所有请求执行完毕
+    void waitForIdle();
+    
+    // 已提交但尚未执行完的请求数，读连接池据此选择最空闲的连接
+    int pendingRequests() const;
+    
+private:
+    QString m_dbPath;
+    DatabaseManager::OpenMode m_openMode;
+    QThread m_thread;
+    QAtomicInt m_pendingRequests;
+    
+    // 生活在数据库线程中的对象，排队调用在其事件循环中按顺序执行
+    QObject* m_context;
+    
+    // 只在数据库线程中创建、使用和销毁
+    DatabaseManager* m_databaseManager;
+    
+    // 在数据库线程中调用，第一次使用时打开连接
+    DatabaseManager& connection();
+};
+
+template <typename Function>
+QFuture<std::invoke_result_t<Function, DatabaseManager&>> DatabaseExecutor::run(Function function)
+{
+    using Result = std::invoke_result_t<Function, DatabaseManager&>;
+    
+    // QPromise不可复制，由共享指针带入数据库线程
+    auto promise = std::make_shared<QPromise<Result>>();
+    QFuture<Result> future = promise->future();
+    promise->start();
+    m_pendingRequests.ref();
+    
+    QMetaObject::invokeMethod(m_context, [this, promise, function]() mutable {
+        if constexpr (std::is_void_v<Result>) {
+            function(connection());
+        } else {
+            promise->addResult(function(connection()));
+        }
+        m_pendingRequests.deref();
+        promise->finish();
+    }, Qt::QueuedConnection);
+    
+    return future;
+}
+
+#endif // DATABASEEXECUTOR_H
@@ -9,19 +9,155 @@
 #include <QLoggingCategory>
 #include <QFile>
 #include <QSaveFile>
+#include <QSettings>
 #include <QUuid>
+#include <QSet>
+#include <QRegularExpression>
+#include <utility>
 #include "../utils/Logging.hpp"
 
+namespace {
+
+// 软件项只按category_id引用分类，分类名称在读取时从categories连接得到，重命名分类只改一行
+const char* const SoftwareItemColumns =
+    "s.id, s.name, s.file_path, c.name, s.description, s.version, s.created_at, s.updated_at, s.icon_key";
+const char* const SoftwareItemSource =
+    "software_items s LEFT JOIN categories c ON c.id = s.category_id";
+
+// 单条和批量操作共用同一条SQL，语句缓存中只准备一次；
+// category_id按分类名称查出，分类行由ensureCategories事先建好，名称为空时为NULL
+const char* const InsertSoftwareItemSql =
+    "INSERT INTO software_items (id, name, file_path, description, version, icon_key, created_at, updated_at, category_id) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, (SELECT id FROM categories WHERE name = ?))";
+
+// 按路径合并扫描结果：分类和描述保留用户修改过的值，只在为空时使用扫描到的值；
+// 分类被删除后category_id为NULL，下次扫描时重新关联到扫描到的分类。
+// 没有任何变化时WHERE不成立，不写入也不返回行
+const char* const UpsertSoftwareItemSql =
+    "INSERT INTO software_items (id, name, file_path, description, version, icon_key, created_at, updated_at, category_id) "
+    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, (SELECT id FROM categories WHERE name = ?)) "
+    "ON CONFLICT(file_path) DO UPDATE SET "
+    "name = excluded.name, version = excluded.version, icon_key = excluded.icon_key, "
+    "category_id = COALESCE(software_items.category_id, excluded.category_id), "
+    "description = COALESCE(NULLIF(software_items.description, ''), excluded.description), "
+    "updated_at = excluded.updated_at "
+    "WHERE software_items.name IS NOT excluded.name "
+    "OR software_items.version IS NOT excluded.version "
+    "OR software_items.icon_key IS NOT excluded.icon_key "
+    "OR (software_items.category_id IS NULL AND excluded.category_id IS NOT NULL) "
+    "OR (COALESCE(software_items.description, '') = '' AND COALESCE(excluded.description, '') != '') "
+    "RETURNING id, name, file_path, (SELECT c.name FROM categories c WHERE c.id = software_items.category_id), "
+    "description, version, created_at, updated_at, icon_key";
+
+const char* const UpdateSoftwareItemSql =
+    "UPDATE software_items SET name = ?, file_path = ?, category_id = (SELECT id FROM categories WHERE name = ?), "
+    "description = ?, version = ?, icon_key = ?, updated_at = ? WHERE id = ?";
+
+// 时间保存为UTC毫秒时间戳，读写时不需要格式化和解析字符串；无效时间保存为0
+qint64 timestampFromDateTime(const QDateTime& dateTime)
+{
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : 0;
+}
+
+QDateTime dateTimeFromTimestamp(const QVariant& value)
+{
+    const qint64 timestamp = value.toLongLong();
+    return timestamp != 0 ? QDateTime::fromMSecsSinceEpoch(timestamp) : QDateTime();
+}
+
+// 一批软件项用到的分类名称，去重并去掉空名称
+QStringList categoryNames(const QList<SoftwareItem>& items)
+{
+    QStringList names;
+    QSet<QString> seen;
+    for (const SoftwareItem& item : items) {
+        const QString& category = item.getCategory();
+        if (!category.isEmpty() && !seen.contains(category)) {
+            seen.insert(category);
+            names.append(category);
+        }
+    }
+    return names;
+}
+
+}
+
+DatabaseManager::PerformanceProfile DatabaseManager::PerformanceProfile::tuned()
+{
+    PerformanceProfile profile;
+    profile.walEnabled = true;
+    profile.synchronousNormal = true;
+    profile.cacheSizeMb = 16;
+    profile.mmapSizeMb = 128;
+    profile.tempStoreMemory = true;
+    profile.busyTimeoutMs = 5000;
+    return profile;
+}
+
+DatabaseManager::PerformanceProfile DatabaseManager::PerformanceProfile::sqliteDefaults()
+{
+    // 回滚日志、synchronous=FULL、约2MB页缓存、不使用内存映射
+    PerformanceProfile profile;
+    profile.walEnabled = false;
+    profile.synchronousNormal = false;
+    profile.cacheSizeMb = 2;
+    profile.mmapSizeMb = 0;
+    profile.tempStoreMemory = false;
+    profile.busyTimeoutMs = 0;
+    return profile;
+}
+
+DatabaseManager::PerformanceProfile DatabaseManager::PerformanceProfile::fromSettings()
+{
+    const PerformanceProfile defaults = tuned();
+    QSettings settings;
+    
+    PerformanceProfile profile;
+    profile.walEnabled = settings.value("Database/WalEnabled", defaults.walEnabled).toBool();
+    profile.synchronousNormal = settings.value("Database/SynchronousNormal", defaults.synchronousNormal).toBool();
+    profile.cacheSizeMb = qBound(1, settings.value("Database/CacheSizeMb", defaults.cacheSizeMb).toInt(), 1024);
+    profile.mmapSizeMb = qBound(0, settings.value("Database/MmapSizeMb", defaults.mmapSizeMb).toInt(), 4096);
+    profile.tempStoreMemory = settings.value("Database/TempStoreMemory", defaults.tempStoreMemory).toBool();
+    profile.busyTimeoutMs = qBound(0, settings.value("Database/BusyTimeoutMs", defaults.busyTimeoutMs).toInt(), 60000);
+    return profile;
+}
+
+void DatabaseManager::PerformanceProfile::saveToSettings() const
+{
+    QSettings settings;
+    settings.setValue("Database/WalEnabled", walEnabled);
+    settings.setValue("Database/SynchronousNormal", synchronousNormal);
+    settings.setValue("Database/CacheSizeMb", cacheSizeMb);
+    settings.setValue("Database/MmapSizeMb", mmapSizeMb);
+    settings.setValue("Database/TempStoreMemory", tempStoreMemory);
+    settings.setValue("Database/BusyTimeoutMs", busyTimeoutMs);
+}
+
 DatabaseManager::DatabaseManager(QObject* parent)
     : QObject(parent)
+    , m_connectionName(QString("software_manager_%1").arg(reinterpret_cast<quintptr>(this)))
+    , m_openMode(ReadWrite)
+    , m_fullTextAvailable(false)
+    , m_profile(PerformanceProfile::fromSettings())
 {
     // 设置数据库路径
-    m_dbPath = getDatabasePath();
+    m_dbPath = defaultDatabasePath();
     
     // 打开数据库
     openDatabase();
 }
 
+DatabaseManager::DatabaseManager(const QString& dbPath, OpenMode mode, QObject* parent)
+    : QObject(parent)
+    , m_dbPath(dbPath)
+    , m_connectionName(QString("software_manager_%1").arg(reinterpret_cast<quintptr>(this)))
+    , m_openMode(mode)
+    , m_fullTextAvailable(false)
+    , m_profile(PerformanceProfile::fromSettings())
+{
+    openDatabase();
+}
+
 DatabaseManager::~DatabaseManager()
 {
     closeDatabase();
@@ -34,6 +170,11 @@ bool DatabaseManager::initializeDatabase()
         return false;
     }
     
+    // 只读连接使用写连接已经建好的表
+    if (m_openMode == ReadOnly) {
+        return true;
+    }
+    
     if (!createTables()) {
         qCWarning(softwareManager) << "无法创建数据库表";
         return false;
@@ -48,6 +189,48 @@ bool DatabaseManager::isDatabaseValid() const
     return m_database.isValid() && m_database.isOpen();
 }
 
+bool DatabaseManager::isReadOnly() const
+{
+    return m_openMode == ReadOnly;
+}
+
+int DatabaseManager::schemaVersion()
+{
+    const QVariant version = pragmaValue("user_version");
+    return version.isValid() ? version.toInt() : -1;
+}
+
+DatabaseManager::PerformanceProfile DatabaseManager::performanceProfile() const
+{
+    return m_profile;
+}
+
+bool DatabaseManager::setPerformanceProfile(const PerformanceProfile& profile)
+{
+    m_profile = profile;
+    if (!isDatabaseValid()) {
+        return true;
+    }
+    
+    // journal_mode不能在事务中切换，缓存的语句必须先结束
+    clearQueryCache();
+    return applyPerformanceProfile();
+}
+
+QVariant DatabaseManager::pragmaValue(const QString& pragma)
+{
+    if (!isDatabaseValid()) {
+        return QVariant();
+    }
+    
+    QSqlQuery query(m_database);
+    if (!query.exec("PRAGMA " + pragma) || !query.next()) {
+        qCWarning(softwareManager) << "读取PRAGMA失败:" << pragma << query.lastError().text();
+        return QVariant();
+    }
+    return query.value(0);
+}
+
 bool DatabaseManager::addSoftwareItem(const SoftwareItem& item)
 {
     if (!isDatabaseValid()) {
@@ -55,18 +238,21 @@ bool DatabaseManager::addSoftwareItem(const SoftwareItem& item)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO software_items (id, name, file_path, category, description, version, created_at, updated_at) "
-                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!ensureCategories(QStringList(item.getCategory()))) {
+        return false;
+    }
+    
+    QSqlQuery& query = cachedQuery(InsertSoftwareItemSql);
     
     query.addBindValue(item.getId());
     query.addBindValue(item.getName());
-    query.addBindValue(item.getFilePath());
-    query.addBindValue(item.getCategory());
+    query.addBindValue(normalizeFilePath(item.getFilePath()));
     query.addBindValue(item.getDescription());
     query.addBindValue(item.getVersion());
-    query.addBindValue(item.getCreatedAt().toString(Qt::ISODate));
-    query.addBindValue(item.getUpdatedAt().toString(Qt::ISODate));
+    query.addBindValue(item.getIconKey());
+    query.addBindValue(timestampFromDateTime(item.getCreatedAt()));
+    query.addBindValue(timestampFromDateTime(item.getUpdatedAt()));
+    query.addBindValue(item.getCategory());
     
     if (!query.exec()) {
         qCWarning(softwareManager) << "插入软件项失败:" << query.lastError().text();
@@ -84,16 +270,19 @@ bool DatabaseManager::updateSoftwareItem(const SoftwareItem& item)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE software_items SET name = ?, file_path = ?, category = ?, "
-                  "description = ?, version = ?, updated_at = ? WHERE id = ?");
+    if (!ensureCategories(QStringList(item.getCategory()))) {
+        return false;
+    }
+    
+    QSqlQuery& query = cachedQuery(UpdateSoftwareItemSql);
     
     query.addBindValue(item.getName());
-    query.addBindValue(item.getFilePath());
+    query.addBindValue(normalizeFilePath(item.getFilePath()));
     query.addBindValue(item.getCategory());
     query.addBindValue(item.getDescription());
     query.addBindValue(item.getVersion());
-    query.addBindValue(item.getUpdatedAt().toString(Qt::ISODate));
+    query.addBindValue(item.getIconKey());
+    query.addBindValue(timestampFromDateTime(item.getUpdatedAt()));
     query.addBindValue(item.getId());
     
     if (!query.exec()) {
@@ -112,8 +301,7 @@ bool DatabaseManager::removeSoftwareItem(const QString& id)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM software_items WHERE id = ?");
+    QSqlQuery& query = cachedQuery("DELETE FROM software_items WHERE id = ?");
     query.addBindValue(id);
     
     if (!query.exec()) {
@@ -122,8 +310,7 @@ bool DatabaseManager::removeSoftwareItem(const QString& id)
     }
     
     // 同时删除分类关联
-    QSqlQuery relationQuery(m_database);
-    relationQuery.prepare("DELETE FROM software_category_relations WHERE software_id = ?");
+    QSqlQuery& relationQuery = cachedQuery("DELETE FROM software_category_relations WHERE software_id = ?");
     relationQuery.addBindValue(id);
     relationQuery.exec();
     
@@ -132,6 +319,50 @@ bool DatabaseManager::removeSoftwareItem(const QString& id)
 }
 
 QList<SoftwareItem> DatabaseManager::getAllSoftwareItems()
+{
+    QList<SoftwareItem> items;
+    visitSoftwareItems(false, QString(), 0, -1, [&items](const SoftwareItem& item) {
+        items.append(item);
+        return true;
+    });
+    
+    qCInfo(softwareManager) << "查询到" << items.size() << "个软件项";
+    return items;
+}
+
+QList<SoftwareItem> DatabaseManager::getSoftwareItemsByCategory(const QString& category)
+{
+    QList<SoftwareItem> items;
+    visitSoftwareItems(true, category, 0, -1, [&items](const SoftwareItem& item) {
+        items.append(item);
+        return true;
+    });
+    
+    qCInfo(softwareManager) << "分类" << category << "下查询到" << items.size() << "个软件项";
+    return items;
+}
+
+bool DatabaseManager::forEachSoftwareItem(const QString& category, const SoftwareItemVisitor& visitor,
+                                          SortOrder order)
+{
+    return visitSoftwareItems(!category.isEmpty(), category, 0, -1, visitor, order);
+}
+
+QList<SoftwareItem> DatabaseManager::fetchSoftwareItems(const QString& category, int offset, int limit,
+                                                        SortOrder order)
+{
+    QList<SoftwareItem> items;
+    if (limit > 0) {
+        items.reserve(limit);
+    }
+    visitSoftwareItems(!category.isEmpty(), category, qMax(0, offset), limit, [&items](const SoftwareItem& item) {
+        items.append(item);
+        return true;
+    }, order);
+    return items;
+}
+
+QList<SoftwareItem> DatabaseManager::getSoftwareItemsAddedSince(const QDateTime& since, int limit)
 {
     QList<SoftwareItem> items;
     
@@ -140,70 +371,65 @@ QList<SoftwareItem> DatabaseManager::getAllSoftwareItems()
         return items;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, name, file_path, category, description, version, created_at, updated_at "
-                  "FROM software_items ORDER BY name");
+    QSqlQuery& query = cachedQuery(QString("SELECT %1 FROM %2 WHERE s.created_at >= ? ORDER BY s.created_at DESC LIMIT ?")
+                                   .arg(SoftwareItemColumns, SoftwareItemSource));
+    query.addBindValue(timestampFromDateTime(since));
+    query.addBindValue(limit);
     
     if (!query.exec()) {
-        qCWarning(softwareManager) << "查询所有软件项失败:" << query.lastError().text();
+        qCWarning(softwareManager) << "查询最近添加的软件项失败:" << query.lastError().text();
         return items;
     }
     
     while (query.next()) {
-        // 从查询结果创建软件项对象
-        QString id = query.value(0).toString();
-        QString name = query.value(1).toString();
-        QString filePath = query.value(2).toString();
-        QString category = query.value(3).toString();
-        QString description = query.value(4).toString();
-        QString version = query.value(5).toString();
-        QDateTime createdAt = QDateTime::fromString(query.value(6).toString(), Qt::ISODate);
-        QDateTime updatedAt = QDateTime::fromString(query.value(7).toString(), Qt::ISODate);
-        
-        SoftwareItem item(id, name, filePath, category, description, version, createdAt, updatedAt);
-        items.append(item);
+        items.append(softwareItemFromQuery(query));
     }
     
-    qCInfo(softwareManager) << "查询到" << items.size() << "个软件项";
     return items;
 }
 
-QList<SoftwareItem> DatabaseManager::getSoftwareItemsByCategory(const QString& category)
+bool DatabaseManager::visitSoftwareItems(bool filterByCategory, const QString& category, int offset, int limit,
+                                         const SoftwareItemVisitor& visitor, SortOrder order)
 {
-    QList<SoftwareItem> items;
-    
     if (!isDatabaseValid()) {
         qCWarning(softwareManager) << "数据库未初始化";
-        return items;
+        return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, name, file_path, category, description, version, created_at, updated_at "
-                  "FROM software_items WHERE category = ? ORDER BY name");
-    query.addBindValue(category);
+    // 按名称排序，名称相同时按rowid排序，分页的边界稳定；按分类过滤时先查出分类的id，
+    // (category_id, name)和(name)索引的条目本身按rowid排列，排序不需要临时B树。
+    // 按启动频率排序时在查询中连接启动统计，各页按最终顺序读出，不需要在内存中重新排序
+    QString sql = QString("SELECT %1 FROM %2").arg(SoftwareItemColumns, SoftwareItemSource);
+    if (order == SortByFrecency) {
+        sql += " LEFT JOIN launch_stats l ON l.software_id = s.id";
+    }
+    if (filterByCategory) {
+        sql += " WHERE s.category_id = (SELECT id FROM categories WHERE name = ?)";
+    }
+    sql += order == SortByFrecency ? " ORDER BY l.frecency IS NULL, l.frecency DESC, s.name, s.rowid"
+                                   : " ORDER BY s.name, s.rowid";
+    QSqlQuery& query = cachedQuery(sql + " LIMIT ? OFFSET ?");
+    if (filterByCategory) {
+        query.addBindValue(category);
+    }
+    query.addBindValue(limit);
+    query.addBindValue(offset);
     
     if (!query.exec()) {
-        qCWarning(softwareManager) << "按分类查询软件项失败:" << query.lastError().text();
-        return items;
+        qCWarning(softwareManager) << "查询软件项失败:" << query.lastError().text();
+        return false;
     }
     
+    // 只向前读取，SQLite每次只取出一行，已读过的行不保留在内存中
     while (query.next()) {
-        // 从查询结果创建软件项对象
-        QString id = query.value(0).toString();
-        QString name = query.value(1).toString();
-        QString filePath = query.value(2).toString();
-        QString itemCategory = query.value(3).toString();
-        QString description = query.value(4).toString();
-        QString version = query.value(5).toString();
-        QDateTime createdAt = QDateTime::fromString(query.value(6).toString(), Qt::ISODate);
-        QDateTime updatedAt = QDateTime::fromString(query.value(7).toString(), Qt::ISODate);
-        
-        SoftwareItem item(id, name, filePath, itemCategory, description, version, createdAt, updatedAt);
-        items.append(item);
+        if (!visitor(softwareItemFromQuery(query))) {
+            break;
+        }
     }
     
-    qCInfo(softwareManager) << "分类" << category << "下查询到" << items.size() << "个软件项";
-    return items;
+    // 提前停止时也结束语句，释放读事务
+    query.finish();
+    return true;
 }
 
 SoftwareItem DatabaseManager::getSoftwareItemById(const QString& id)
@@ -215,9 +441,7 @@ SoftwareItem DatabaseManager::getSoftwareItemById(const QString& id)
         return item;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id, name, file_path, category, description, version, created_at, updated_at "
-                  "FROM software_items WHERE id = ?");
+    QSqlQuery& query = cachedQuery(QString("SELECT %1 FROM %2 WHERE s.id = ?").arg(SoftwareItemColumns, SoftwareItemSource));
     query.addBindValue(id);
     
     if (!query.exec()) {
@@ -226,18 +450,9 @@ SoftwareItem DatabaseManager::getSoftwareItemById(const QString& id)
     }
     
     if (query.next()) {
-        // 从查询结果创建软件项对象
-        QString itemId = query.value(0).toString();
-        QString name = query.value(1).toString();
-        QString filePath = query.value(2).toString();
-        QString category = query.value(3).toString();
-        QString description = query.value(4).toString();
-        QString version = query.value(5).toString();
-        QDateTime createdAt = QDateTime::fromString(query.value(6).toString(), Qt::ISODate);
-        QDateTime updatedAt = QDateTime::fromString(query.value(7).toString(), Qt::ISODate);
-        
-        item = SoftwareItem(itemId, name, filePath, category, description, version, createdAt, updatedAt);
+        item = softwareItemFromQuery(query);
     }
+    query.finish();
     
     return item;
 }
@@ -248,15 +463,65 @@ bool DatabaseManager::softwareItemExists(const QString& id)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT COUNT(*) FROM software_items WHERE id = ?");
+    QSqlQuery& query = cachedQuery("SELECT COUNT(*) FROM software_items WHERE id = ?");
     query.addBindValue(id);
     
     if (!query.exec() || !query.next()) {
         return false;
     }
     
-    return query.value(0).toInt() > 0;
+    // 缓存的语句读完一行后仍处于活动状态，需要结束以释放读事务
+    bool exists = query.value(0).toInt() > 0;
+    query.finish();
+    return exists;
+}
+
+QList<SoftwareItem> DatabaseManager::searchSoftwareItems(const QString& query, int limit)
+{
+    QList<SoftwareItem> items;
+    
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return items;
+    }
+    
+    if (limit == 0) {
+        return items;
+    }
+    
+    if (!m_fullTextAvailable) {
+        return searchSoftwareItemsWithLike(query.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts), limit);
+    }
+    
+    QString matchExpression = buildFullTextQuery(query);
+    if (matchExpression.isEmpty()) {
+        return items;
+    }
+    
+    // 名称的权重最高，其次是描述和分类，路径中的公共目录名权重最低
+    QSqlQuery& searchQuery = cachedQuery(QString("SELECT %1 "
+                                                 "FROM software_items_fts JOIN %2 ON s.rowid = software_items_fts.rowid "
+                                                 "WHERE software_items_fts MATCH ? ").arg(SoftwareItemColumns, SoftwareItemSource) +
+                                         "ORDER BY bm25(software_items_fts, 10.0, 2.0, 1.0, 2.0), s.name "
+                                         "LIMIT ?");
+    searchQuery.addBindValue(matchExpression);
+    searchQuery.addBindValue(limit);
+    
+    if (!searchQuery.exec()) {
+        qCWarning(softwareManager) << "全文搜索失败:" << searchQuery.lastError().text();
+        return items;
+    }
+    
+    while (searchQuery.next()) {
+        items.append(softwareItemFromQuery(searchQuery));
+    }
+    
+    return items;
+}
+
+bool DatabaseManager::isFullTextSearchAvailable() const
+{
+    return m_fullTextAvailable;
 }
 
 bool DatabaseManager::addCategory(const QString& name)
@@ -271,11 +536,11 @@ bool DatabaseManager::addCategory(const QString& name)
         return true;  // 分类已存在，视为成功
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO categories (name, created_at, updated_at) VALUES (?, ?, ?)");
+    QSqlQuery& query = cachedQuery("INSERT INTO categories (name, created_at, updated_at) VALUES (?, ?, ?)");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
     query.addBindValue(name);
-    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
-    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    query.addBindValue(now);
+    query.addBindValue(now);
     
     if (!query.exec()) {
         qCWarning(softwareManager) << "添加分类失败:" << query.lastError().text();
@@ -293,8 +558,8 @@ bool DatabaseManager::removeCategory(const QString& name)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("DELETE FROM categories WHERE name = ?");
+    // 触发器把引用该分类的软件项的category_id置空，软件项不再属于任何分类，下次扫描时重新关联
+    QSqlQuery& query = cachedQuery("DELETE FROM categories WHERE name = ?");
     query.addBindValue(name);
     
     if (!query.exec()) {
@@ -315,8 +580,7 @@ QStringList DatabaseManager::getAllCategories()
         return categories;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT name FROM categories ORDER BY name");
+    QSqlQuery& query = cachedQuery("SELECT name FROM categories ORDER BY name");
     
     if (!query.exec()) {
         qCWarning(softwareManager) << "查询所有分类失败:" << query.lastError().text();
@@ -336,15 +600,17 @@ bool DatabaseManager::categoryExists(const QString& name)
         return false;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT COUNT(*) FROM categories WHERE name = ?");
+    QSqlQuery& query = cachedQuery("SELECT COUNT(*) FROM categories WHERE name = ?");
     query.addBindValue(name);
     
     if (!query.exec() || !query.next()) {
         return false;
     }
     
-    return query.value(0).toInt() > 0;
+    // 缓存的语句读完一行后仍处于活动状态，需要结束以释放读事务
+    bool exists = query.value(0).toInt() > 0;
+    query.finish();
+    return exists;
 }
 
 bool DatabaseManager::moveSoftwareToCategory(const QString& softwareId, const QString& categoryName)
@@ -354,11 +620,15 @@ bool DatabaseManager::moveSoftwareToCategory(const QString& softwareId, const QS
         return false;
     }
     
-    // 更新软件项的分类
-    QSqlQuery query(m_database);
-    query.prepare("UPDATE software_items SET category = ?, updated_at = ? WHERE id = ?");
+    if (!ensureCategories(QStringList(categoryName))) {
+        return false;
+    }
+    
+    // 更新软件项的分类，分类计数由触发器维护
+    QSqlQuery& query = cachedQuery("UPDATE software_items SET category_id = (SELECT id FROM categories WHERE name = ?), "
+                                   "updated_at = ? WHERE id = ?");
     query.addBindValue(categoryName);
-    query.addBindValue(QDateTime::currentDateTime().toString(Qt::ISODate));
+    query.addBindValue(QDateTime::currentMSecsSinceEpoch());
     query.addBindValue(softwareId);
     
     if (!query.exec()) {
@@ -376,15 +646,99 @@ int DatabaseManager::getCategoryCount(const QString& category)
         return 0;
     }
     
-    QSqlQuery query(m_database);
-    query.prepare("SELECT COUNT(*) FROM software_items WHERE category = ?");
+    // 计数由触发器随软件项的增删和移动维护，不再统计软件项表
+    QSqlQuery& query = cachedQuery("SELECT item_count FROM categories WHERE name = ?");
     query.addBindValue(category);
     
     if (!query.exec() || !query.next()) {
         return 0;
     }
     
-    return query.value(0).toInt();
+    int count = query.value(0).toInt();
+    query.finish();
+    return count;
+}
+
+QHash<QString, int> DatabaseManager::getCategoryCounts()
+{
+    QHash<QString, int> counts;
+    
+    if (!isDatabaseValid()) {
+        return counts;
+    }
+    
+    QSqlQuery& query = cachedQuery("SELECT name, item_count FROM categories");
+    
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "查询分类计数失败:" << query.lastError().text();
+        return counts;
+    }
+    
+    while (query.next()) {
+        counts.insert(query.value(0).toString(), query.value(1).toInt());
+    }
+    
+    return counts;
+}
+
+bool DatabaseManager::renameCategory(const QString& oldName, const QString& newName)
+{
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return false;
+    }
+    
+    if (newName.isEmpty() || categoryExists(newName)) {
+        qCWarning(softwareManager) << "分类名称为空或已存在:" << newName;
+        return false;
+    }
+    
+    // 软件项按id引用分类，只需修改分类行，计数不变；全文索引中的分类名称由触发器更新
+    QSqlQuery& query = cachedQuery("UPDATE categories SET name = ?, updated_at = ? WHERE name = ?");
+    query.addBindValue(newName);
+    query.addBindValue(QDateTime::currentMSecsSinceEpoch());
+    query.addBindValue(oldName);
+    
+    if (!query.exec() || query.numRowsAffected() != 1) {
+        qCWarning(softwareManager) << "重命名分类失败:" << oldName << "->" << newName << query.lastError().text();
+        return false;
+    }
+    
+    qCInfo(softwareManager) << "成功重命名分类:" << oldName << "->" << newName;
+    return true;
+}
+
+bool DatabaseManager::ensureCategories(const QStringList& names)
+{
+    QVariantList categories, timestamps;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (const QString& name : names) {
+        if (!name.isEmpty()) {
+            categories.append(name);
+            timestamps.append(now);
+        }
+    }
+    
+    if (categories.isEmpty()) {
+        return true;
+    }
+    
+    QSqlQuery& query = cachedQuery("INSERT OR IGNORE INTO categories (name, created_at, updated_at) VALUES (?, ?, ?)");
+    query.addBindValue(categories);
+    query.addBindValue(timestamps);
+    query.addBindValue(timestamps);
+    
+    if (!query.execBatch()) {
+        qCWarning(softwareManager) << "创建分类失败:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::refreshCategoryCounts()
+{
+    return executeQuery("UPDATE categories SET item_count = "
+                        "(SELECT COUNT(*) FROM software_items WHERE software_items.category_id = categories.id)");
 }
 
 bool DatabaseManager::batchInsertSoftwareItems(const QList<SoftwareItem>& items)
@@ -394,18 +748,50 @@ bool DatabaseManager::batchInsertSoftwareItems(const QList<SoftwareItem>& items)
         return false;
     }
     
+    if (items.isEmpty()) {
+        return true;
+    }
+    
+    // 按列收集绑定值，整批只执行一次execBatch，不再逐行准备语句和输出日志
+    QVariantList ids, names, filePaths, categories, descriptions, versions, iconKeys, createdAts, updatedAts;
+    for (QVariantList* column : {&ids, &names, &filePaths, &categories, &descriptions, &versions, &iconKeys, &createdAts, &updatedAts}) {
+        column->reserve(items.size());
+    }
+    
+    for (const SoftwareItem& item : items) {
+        ids.append(item.getId());
+        names.append(item.getName());
+        filePaths.append(normalizeFilePath(item.getFilePath()));
+        categories.append(item.getCategory());
+        descriptions.append(item.getDescription());
+        versions.append(item.getVersion());
+        iconKeys.append(item.getIconKey());
+        createdAts.append(timestampFromDateTime(item.getCreatedAt()));
+        updatedAts.append(timestampFromDateTime(item.getUpdatedAt()));
+    }
+    
     // 开始事务
     if (!m_database.transaction()) {
         qCWarning(softwareManager) << "无法开始数据库事务";
         return false;
     }
     
-    bool success = true;
-    
-    for (const SoftwareItem& item : items) {
-        if (!addSoftwareItem(item)) {
-            success = false;
-            break;
+    bool success = ensureCategories(categoryNames(items));
+    if (success) {
+        QSqlQuery& query = cachedQuery(InsertSoftwareItemSql);
+        query.addBindValue(ids);
+        query.addBindValue(names);
+        query.addBindValue(filePaths);
+        query.addBindValue(descriptions);
+        query.addBindValue(versions);
+        query.addBindValue(iconKeys);
+        query.addBindValue(createdAts);
+        query.addBindValue(updatedAts);
+        query.addBindValue(categories);
+        
+        success = query.execBatch();
+        if (!success) {
+            qCWarning(softwareManager) << "批量插入软件项失败:" << query.lastError().text();
         }
     }
     
@@ -421,8 +807,6 @@ bool DatabaseManager::batchInsertSoftwareItems(const QList<SoftwareItem>& items)
     
     if (success) {
         qCInfo(softwareManager) << "批量插入" << items.size() << "个软件项成功";
-    } else {
-        qCWarning(softwareManager) << "批量插入软件项失败";
     }
     
     return success;
@@ -435,18 +819,48 @@ bool DatabaseManager::batchUpdateSoftwareItems(const QList<SoftwareItem>& items)
         return false;
     }
     
+    if (items.isEmpty()) {
+        return true;
+    }
+    
+    // 按列收集绑定值，顺序与UPDATE语句中的占位符一致
+    QVariantList names, filePaths, categories, descriptions, versions, iconKeys, updatedAts, ids;
+    for (QVariantList* column : {&names, &filePaths, &categories, &descriptions, &versions, &iconKeys, &updatedAts, &ids}) {
+        column->reserve(items.size());
+    }
+    
+    for (const SoftwareItem& item : items) {
+        names.append(item.getName());
+        filePaths.append(normalizeFilePath(item.getFilePath()));
+        categories.append(item.getCategory());
+        descriptions.append(item.getDescription());
+        versions.append(item.getVersion());
+        iconKeys.append(item.getIconKey());
+        updatedAts.append(timestampFromDateTime(item.getUpdatedAt()));
+        ids.append(item.getId());
+    }
+    
     // 开始事务
     if (!m_database.transaction()) {
         qCWarning(softwareManager) << "无法开始数据库事务";
         return false;
     }
     
-    bool success = true;
-    
-    for (const SoftwareItem& item : items) {
-        if (!updateSoftwareItem(item)) {
-            success = false;
-            break;
+    bool success = ensureCategories(categoryNames(items));
+    if (success) {
+        QSqlQuery& query = cachedQuery(UpdateSoftwareItemSql);
+        query.addBindValue(names);
+        query.addBindValue(filePaths);
+        query.addBindValue(categories);
+        query.addBindValue(descriptions);
+        query.addBindValue(versions);
+        query.addBindValue(iconKeys);
+        query.addBindValue(updatedAts);
+        query.addBindValue(ids);
+        
+        success = query.execBatch();
+        if (!success) {
+            qCWarning(softwareManager) << "批量更新软件项失败:" << query.lastError().text();
         }
     }
     
@@ -462,55 +876,410 @@ bool DatabaseManager::batchUpdateSoftwareItems(const QList<SoftwareItem>& items)
     
     if (success) {
         qCInfo(softwareManager) << "批量更新" << items.size() << "个软件项成功";
-    } else {
-        qCWarning(softwareManager) << "批量更新软件项失败";
     }
     
     return success;
 }
 
-bool DatabaseManager::backupDatabase(const QString& backupPath)
+bool DatabaseManager::ingestSoftwareItems(const QList<SoftwareItem>& items, IngestResult* result)
 {
     if (!isDatabaseValid()) {
         qCWarning(softwareManager) << "数据库未初始化";
         return false;
     }
     
-    // 关闭数据库
-    closeDatabase();
-    
-    // 复制数据库文件
-    QFile sourceFile(m_dbPath);
-    bool success = sourceFile.copy(backupPath);
-    
-    // 重新打开数据库
-    openDatabase();
-    
-    if (success) {
-        qCInfo(softwareManager) << "数据库备份成功:" << backupPath;
-    } else {
-        qCWarning(softwareManager) << "数据库备份失败:" << backupPath;
+    IngestResult ingested;
+    if (items.isEmpty()) {
+        if (result) {
+            *result = ingested;
+        }
+        return true;
     }
     
-    return success;
-}
-
-bool DatabaseManager::restoreDatabase(const QString& backupPath)
-{
-    if (!QFile::exists(backupPath)) {
-        qCWarning(softwareManager) << "备份文件不存在:" << backupPath;
+    // 开始事务
+    if (!m_database.transaction()) {
+        qCWarning(softwareManager) << "无法开始数据库事务";
         return false;
     }
     
-    // 关闭数据库
-    closeDatabase();
+    bool success = ensureCategories(categoryNames(items));
+    QSqlQuery& query = cachedQuery(UpsertSoftwareItemSql);
     
-    // 复制备份文件到数据库位置
-    QFile::remove(m_dbPath);
-    bool success = QFile::copy(backupPath, m_dbPath);
+    for (int i = 0; success && i < items.size(); ++i) {
+        const SoftwareItem& item = items.at(i);
+        // 没有单独图标的软件项以文件路径作为图标来源，同样使用规范化的路径参与比较
+        const QString filePath = normalizeFilePath(item.getFilePath());
+        const QString iconKey = item.getIconKey() == item.getFilePath() ? filePath : item.getIconKey();
+        
+        query.addBindValue(item.getId());
+        query.addBindValue(item.getName());
+        query.addBindValue(filePath);
+        query.addBindValue(item.getDescription());
+        query.addBindValue(item.getVersion());
+        query.addBindValue(iconKey);
+        query.addBindValue(timestampFromDateTime(item.getCreatedAt()));
+        query.addBindValue(timestampFromDateTime(item.getUpdatedAt()));
+        query.addBindValue(item.getCategory());
+        
+        if (!query.exec()) {
+            qCWarning(softwareManager) << "合并软件项失败:" << item.getFilePath() << query.lastError().text();
+            success = false;
+            break;
+        }
+        
+        // 返回的是数据库中的记录：id与传入的相同说明是新插入的，否则是已有记录被更新
+        if (query.next()) {
+            SoftwareItem stored = softwareItemFromQuery(query);
+            if (stored.getId() == item.getId()) {
+                ingested.inserted.append(stored);
+            } else {
+                ingested.updated.append(stored);
+            }
+        } else {
+            ++ingested.unchanged;
+        }
+        query.finish();
+    }
     
-    // 重新打开数据库
-    openDatabase();
+    // 提交或回滚事务
+    if (success) {
+        if (!m_database.commit()) {
+            qCWarning(softwareManager) << "无法提交数据库事务";
+            success = false;
+        }
+    } else {
+        m_database.rollback();
+    }
+    
+    if (success) {
+        qCInfo(softwareManager) << "合并扫描结果: 新增" << ingested.inserted.size()
+                                << "，更新" << ingested.updated.size()
+                                << "，未变化" << ingested.unchanged;
+        if (result) {
+            *result = ingested;
+        }
+    }
+    
+    return success;
+}
+
+QString DatabaseManager::normalizeFilePath(const QString& filePath)
+{
+    // 统一分隔符并去掉多余的"."、".."和重复的斜杠，同一文件只对应一个键
+    return QDir::cleanPath(QDir::fromNativeSeparators(filePath));
+}
+
+bool DatabaseManager::removeSoftwareItemsByFilePaths(const QStringList& filePaths)
+{
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return false;
+    }
+    
+    if (filePaths.isEmpty()) {
+        return true;
+    }
+    
+    // 开始事务
+    if (!m_database.transaction()) {
+        qCWarning(softwareManager) << "无法开始数据库事务";
+        return false;
+    }
+    
+    QVariantList normalizedPaths;
+    normalizedPaths.reserve(filePaths.size());
+    for (const QString& filePath : filePaths) {
+        normalizedPaths.append(normalizeFilePath(filePath));
+    }
+    
+    QSqlQuery& query = cachedQuery("DELETE FROM software_items WHERE file_path = ?");
+    query.addBindValue(normalizedPaths);
+    
+    bool success = query.execBatch();
+    if (!success) {
+        qCWarning(softwareManager) << "按路径删除软件项失败:" << query.lastError().text();
+    }
+    
+    // 提交或回滚事务
+    if (success) {
+        if (!m_database.commit()) {
+            qCWarning(softwareManager) << "无法提交数据库事务";
+            success = false;
+        }
+    } else {
+        m_database.rollback();
+    }
+    
+    if (success) {
+        qCInfo(softwareManager) << "按路径删除" << filePaths.size() << "个软件项成功";
+    }
+    
+    return success;
+}
+
+QList<DirectorySnapshot> DatabaseManager::getDirectorySnapshots()
+{
+    QList<DirectorySnapshot> snapshots;
+    
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return snapshots;
+    }
+    
+    QSqlQuery& query = cachedQuery("SELECT path, mtime, inode, entry_count, scanned_at, sub_directories, files "
+                                   "FROM directory_snapshots");
+    
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "查询目录快照失败:" << query.lastError().text();
+        return snapshots;
+    }
+    
+    while (query.next()) {
+        DirectorySnapshot snapshot;
+        snapshot.path = query.value(0).toString();
+        snapshot.modifiedTime = query.value(1).toLongLong();
+        snapshot.inode = query.value(2).toULongLong();
+        snapshot.entryCount = query.value(3).toInt();
+        snapshot.scannedAt = query.value(4).toLongLong();
+        snapshot.subDirectories = query.value(5).toString().split('\n', Qt::SkipEmptyParts);
+        snapshot.files = query.value(6).toString().split('\n', Qt::SkipEmptyParts);
+        snapshots.append(snapshot);
+    }
+    
+    qCInfo(softwareManager) << "加载" << snapshots.size() << "个目录快照";
+    return snapshots;
+}
+
+bool DatabaseManager::saveDirectorySnapshots(const QList<DirectorySnapshot>& snapshots, const QStringList& removedPaths)
+{
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return false;
+    }
+    
+    if (snapshots.isEmpty() && removedPaths.isEmpty()) {
+        return true;
+    }
+    
+    // 开始事务
+    if (!m_database.transaction()) {
+        qCWarning(softwareManager) << "无法开始数据库事务";
+        return false;
+    }
+    
+    bool success = true;
+    
+    QSqlQuery& saveQuery = cachedQuery("INSERT OR REPLACE INTO directory_snapshots "
+                                       "(path, mtime, inode, entry_count, scanned_at, sub_directories, files) "
+                                       "VALUES (?, ?, ?, ?, ?, ?, ?)");
+    
+    for (const DirectorySnapshot& snapshot : snapshots) {
+        saveQuery.addBindValue(snapshot.path);
+        saveQuery.addBindValue(snapshot.modifiedTime);
+        saveQuery.addBindValue(static_cast<qint64>(snapshot.inode));
+        saveQuery.addBindValue(snapshot.entryCount);
+        saveQuery.addBindValue(snapshot.scannedAt);
+        saveQuery.addBindValue(snapshot.subDirectories.join('\n'));
+        saveQuery.addBindValue(snapshot.files.join('\n'));
+        
+        if (!saveQuery.exec()) {
+            qCWarning(softwareManager) << "保存目录快照失败:" << saveQuery.lastError().text();
+            success = false;
+            break;
+        }
+    }
+    
+    if (success) {
+        QSqlQuery& removeQuery = cachedQuery("DELETE FROM directory_snapshots WHERE path = ?");
+        
+        for (const QString& path : removedPaths) {
+            removeQuery.addBindValue(path);
+            if (!removeQuery.exec()) {
+                qCWarning(softwareManager) << "删除目录快照失败:" << removeQuery.lastError().text();
+                success = false;
+                break;
+            }
+        }
+    }
+    
+    // 提交或回滚事务
+    if (success) {
+        if (!m_database.commit()) {
+            qCWarning(softwareManager) << "无法提交数据库事务";
+            success = false;
+        }
+    } else {
+        m_database.rollback();
+    }
+    
+    return success;
+}
+
+QList<LaunchStats> DatabaseManager::getLaunchStats()
+{
+    QList<LaunchStats> stats;
+    
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return stats;
+    }
+    
+    QSqlQuery& query = cachedQuery("SELECT software_id, launch_count, last_launched, frecency FROM launch_stats");
+    
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "查询启动统计失败:" << query.lastError().text();
+        return stats;
+    }
+    
+    while (query.next()) {
+        LaunchStats entry;
+        entry.softwareId = query.value(0).toString();
+        entry.launchCount = query.value(1).toInt();
+        entry.lastLaunched = query.value(2).toLongLong();
+        entry.frecency = query.value(3).toDouble();
+        stats.append(entry);
+    }
+    
+    qCInfo(softwareManager) << "加载" << stats.size() << "条启动统计";
+    return stats;
+}
+
+bool DatabaseManager::saveLaunchStats(const QList<LaunchStats>& stats)
+{
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return false;
+    }
+    
+    if (stats.isEmpty()) {
+        return true;
+    }
+    
+    // 开始事务
+    if (!m_database.transaction()) {
+        qCWarning(softwareManager) << "无法开始数据库事务";
+        return false;
+    }
+    
+    QSqlQuery& query = cachedQuery("INSERT OR REPLACE INTO launch_stats (software_id, launch_count, last_launched, frecency) "
+                                   "VALUES (?, ?, ?, ?)");
+    
+    bool success = true;
+    for (const LaunchStats& entry : stats) {
+        query.addBindValue(entry.softwareId);
+        query.addBindValue(entry.launchCount);
+        query.addBindValue(entry.lastLaunched);
+        query.addBindValue(entry.frecency);
+        
+        if (!query.exec()) {
+            qCWarning(softwareManager) << "保存启动统计失败:" << query.lastError().text();
+            success = false;
+            break;
+        }
+    }
+    
+    // 提交或回滚事务
+    if (success) {
+        if (!m_database.commit()) {
+            qCWarning(softwareManager) << "无法提交数据库事务";
+            success = false;
+        }
+    } else {
+        m_database.rollback();
+    }
+    
+    return success;
+}
+
+QStringList DatabaseManager::getFrecentSoftwareIds(int limit)
+{
+    QStringList ids;
+    
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return ids;
+    }
+    
+    // 按frecency索引倒序读取，只访问前limit行
+    QSqlQuery& query = cachedQuery("SELECT software_id FROM launch_stats ORDER BY frecency DESC LIMIT ?");
+    query.addBindValue(limit);
+    
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "查询常用软件失败:" << query.lastError().text();
+        return ids;
+    }
+    
+    while (query.next()) {
+        ids.append(query.value(0).toString());
+    }
+    
+    return ids;
+}
+
+bool DatabaseManager::backupDatabase(const QString& backupPath)
+{
+    if (!isDatabaseValid()) {
+        qCWarning(softwareManager) << "数据库未初始化";
+        return false;
+    }
+    
+    // 执行中的缓存语句会让VACUUM失败
+    clearQueryCache();
+    
+    // VACUUM INTO在一个读事务中写出一致的快照，WAL模式下不阻塞其他连接的读写；
+    // 先写到临时文件，完成后再替换旧的备份，失败时不会留下不完整的备份
+    const QString tempPath = backupPath + ".tmp";
+    QFile::remove(tempPath);
+    
+    QSqlQuery query(m_database);
+    query.prepare("VACUUM INTO ?");
+    query.addBindValue(tempPath);
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "数据库备份失败:" << backupPath << ", 错误:" << query.lastError().text();
+        QFile::remove(tempPath);
+        return false;
+    }
+    
+    QFile::remove(backupPath);
+    if (!QFile::rename(tempPath, backupPath)) {
+        qCWarning(softwareManager) << "无法写入备份文件:" << backupPath;
+        QFile::remove(tempPath);
+        return false;
+    }
+    
+    qCInfo(softwareManager) << "数据库备份成功:" << backupPath;
+    return true;
+}
+
+bool DatabaseManager::restoreDatabase(const QString& backupPath)
+{
+    if (!QFile::exists(backupPath)) {
+        qCWarning(softwareManager) << "备份文件不存在:" << backupPath;
+        return false;
+    }
+    
+    if (!isDatabaseValid() || isReadOnly()) {
+        qCWarning(softwareManager) << "数据库未初始化或为只读连接";
+        return false;
+    }
+    
+    // 在备份的副本上建表和迁移，旧版本的备份也能按当前的表结构导入，备份文件本身保持不变
+    const QString stagingPath = m_dbPath + ".restore";
+    removeDatabaseFiles(stagingPath);
+    if (!QFile::copy(backupPath, stagingPath)) {
+        qCWarning(softwareManager) << "无法复制备份文件:" << backupPath;
+        return false;
+    }
+    
+    bool staged = false;
+    {
+        DatabaseManager staging(stagingPath);
+        staged = staging.initializeDatabase();
+    }
+    
+    // 在一个写事务中替换全部数据：连接不关闭，其他连接在提交前读到的都是恢复前的完整数据
+    bool success = staged && importDatabase(stagingPath);
+    removeDatabaseFiles(stagingPath);
     
     if (success) {
         qCInfo(softwareManager) << "数据库恢复成功:" << backupPath;
@@ -521,6 +1290,69 @@ bool DatabaseManager::restoreDatabase(const QString& backupPath)
     return success;
 }
 
+bool DatabaseManager::importDatabase(const QString& sourcePath)
+{
+    // 按外键依赖排列，删除时逆序
+    static const QStringList tables = {
+        "categories", "software_items", "software_category_relations", "launch_stats", "directory_snapshots"
+    };
+    
+    clearQueryCache();
+    
+    QSqlQuery attachQuery(m_database);
+    attachQuery.prepare("ATTACH DATABASE ? AS restore_source");
+    attachQuery.addBindValue(sourcePath);
+    if (!attachQuery.exec()) {
+        qCWarning(softwareManager) << "无法附加备份数据库:" << attachQuery.lastError().text();
+        return false;
+    }
+    
+    bool success = m_database.transaction();
+    for (int i = tables.size() - 1; success && i >= 0; --i) {
+        success = executeQuery(QString("DELETE FROM main.%1").arg(tables.at(i)));
+    }
+    
+    // 列名按当前表结构列出，不依赖两边列的先后顺序；全文索引由触发器随插入重建
+    for (int i = 0; success && i < tables.size(); ++i) {
+        const QString columns = tableColumns(tables.at(i)).join(", ");
+        success = !columns.isEmpty()
+            && executeQuery(QString("INSERT INTO main.%1 (%2) SELECT %2 FROM restore_source.%1").arg(tables.at(i), columns));
+    }
+    
+    // 插入时触发器在备份中已有的计数上又加了一遍，按导入的数据重新统计
+    success = success && refreshCategoryCounts();
+    
+    if (success && !m_database.commit()) {
+        qCWarning(softwareManager) << "提交恢复事务失败:" << m_database.lastError().text();
+        success = false;
+    }
+    if (!success) {
+        m_database.rollback();
+    }
+    
+    executeQuery("DETACH DATABASE restore_source");
+    return success;
+}
+
+QStringList DatabaseManager::tableColumns(const QString& table)
+{
+    QStringList columns;
+    QSqlQuery query(m_database);
+    if (query.exec(QString("PRAGMA main.table_info(%1)").arg(table))) {
+        while (query.next()) {
+            columns.append(query.value("name").toString());
+        }
+    }
+    return columns;
+}
+
+void DatabaseManager::removeDatabaseFiles(const QString& dbPath)
+{
+    QFile::remove(dbPath);
+    QFile::remove(dbPath + "-wal");
+    QFile::remove(dbPath + "-shm");
+}
+
 qint64 DatabaseManager::getDatabaseSize() const
 {
     QFile file(m_dbPath);
@@ -542,11 +1374,13 @@ bool DatabaseManager::createTables()
         "id TEXT PRIMARY KEY, "
         "name TEXT NOT NULL, "
         "file_path TEXT NOT NULL, "
-        "category TEXT, "
+        "category TEXT, "                // 旧版本保存的分类名称副本，版本3起为空，分类以category_id为准
         "description TEXT, "
         "version TEXT, "
-        "created_at DATETIME NOT NULL, "
-        "updated_at DATETIME NOT NULL"
+        "created_at INTEGER NOT NULL, "
+        "updated_at INTEGER NOT NULL, "
+        "icon_key TEXT, "
+        "category_id INTEGER REFERENCES categories(id)"
         ")";
     
     if (!executeQuery(createSoftwareItemsTable)) {
@@ -558,8 +1392,9 @@ bool DatabaseManager::createTables()
         "CREATE TABLE IF NOT EXISTS categories ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT, "
         "name TEXT NOT NULL UNIQUE, "
-        "created_at DATETIME NOT NULL, "
-        "updated_at DATETIME NOT NULL"
+        "created_at INTEGER NOT NULL, "
+        "updated_at INTEGER NOT NULL, "
+        "item_count INTEGER NOT NULL DEFAULT 0"
         ")";
     
     if (!executeQuery(createCategoriesTable)) {
@@ -580,9 +1415,495 @@ bool DatabaseManager::createTables()
         return false;
     }
     
+    // 创建directory_snapshots表（增量扫描）
+    QString createSnapshotsTable = 
+        "CREATE TABLE IF NOT EXISTS directory_snapshots ("
+        "path TEXT PRIMARY KEY, "
+        "mtime INTEGER NOT NULL, "
+        "inode INTEGER NOT NULL, "
+        "entry_count INTEGER NOT NULL, "
+        "scanned_at INTEGER NOT NULL, "
+        "sub_directories TEXT, "
+        "files TEXT"
+        ")";
+    
+    if (!executeQuery(createSnapshotsTable)) {
+        return false;
+    }
+    
+    // 创建launch_stats表（启动统计），frecency上的索引用于直接读取最常用的软件
+    QString createLaunchStatsTable = 
+        "CREATE TABLE IF NOT EXISTS launch_stats ("
+        "software_id TEXT PRIMARY KEY, "
+        "launch_count INTEGER NOT NULL, "
+        "last_launched INTEGER NOT NULL, "
+        "frecency REAL NOT NULL"
+        ")";
+    
+    if (!executeQuery(createLaunchStatsTable)) {
+        return false;
+    }
+    
+    if (!executeQuery("CREATE INDEX IF NOT EXISTS idx_launch_stats_frecency ON launch_stats(frecency DESC)")) {
+        return false;
+    }
+    
+    // 软件项被删除（包括按路径批量删除）时一并删除其启动统计
+    QString createLaunchStatsTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS launch_stats_cleanup AFTER DELETE ON software_items BEGIN "
+        "DELETE FROM launch_stats WHERE software_id = old.id; "
+        "END";
+    
+    if (!executeQuery(createLaunchStatsTrigger)) {
+        return false;
+    }
+    
+    // 表创建完成后按版本号升级旧数据库
+    if (!migrateSchema()) {
+        return false;
+    }
+    
+    // 全文索引从分类表读取分类名称，在迁移补上category_id之后创建；
+    // 不可用时搜索回退到LIKE查询，不影响其他功能
+    m_fullTextAvailable = createFullTextIndex();
+    if (!m_fullTextAvailable) {
+        qCWarning(softwareManager) << "SQLite不支持FTS5，搜索将回退到LIKE查询";
+    }
+    
+    return true;
+}
+
+bool DatabaseManager::migrateSchema()
+{
+    const int currentVersion = schemaVersion();
+    if (currentVersion < 0) {
+        return false;
+    }
+    
+    if (currentVersion > SchemaVersion) {
+        qCWarning(softwareManager) << "数据库版本" << currentVersion << "高于程序支持的版本" << SchemaVersion << "，跳过迁移";
+        return true;
+    }
+    
+    for (int version = currentVersion + 1; version <= SchemaVersion; ++version) {
+        // 每个版本在独立的事务中升级，失败时数据库停留在上一个版本，下次启动重试
+        if (!m_database.transaction()) {
+            qCWarning(softwareManager) << "开始迁移事务失败:" << m_database.lastError().text();
+            return false;
+        }
+        
+        if (!applyMigration(version) || !executeQuery(QString("PRAGMA user_version = %1").arg(version))) {
+            m_database.rollback();
+            qCWarning(softwareManager) << "数据库迁移到版本" << version << "失败";
+            return false;
+        }
+        
+        if (!m_database.commit()) {
+            qCWarning(softwareManager) << "提交迁移事务失败:" << m_database.lastError().text();
+            m_database.rollback();
+            return false;
+        }
+        
+        qCInfo(softwareManager) << "数据库已迁移到版本" << version;
+    }
+    
+    // 新建的索引需要统计信息才能被查询规划器正确选用
+    if (currentVersion < SchemaVersion) {
+        executeQuery("PRAGMA optimize");
+    }
+    
+    return true;
+}
+
+bool DatabaseManager::applyMigration(int version)
+{
+    switch (version) {
+    case 1:
+        return migrateToVersion1();
+    case 2:
+        return migrateToVersion2();
+    case 3:
+        return migrateToVersion3();
+    default:
+        qCWarning(softwareManager) << "未知的数据库版本:" << version;
+        return false;
+    }
+}
+
+bool DatabaseManager::migrateToVersion1()
+{
+    // 没有版本号的旧数据库创建的表没有icon_key列
+    if (!addColumnIfMissing("software_items", "icon_key", "TEXT")) {
+        return false;
+    }
+    
+    // 建立路径唯一索引前先去重：同一路径优先保留有启动统计的记录，其次保留最近更新的记录；
+    // 删除触发器会同步清理全文索引和被删除记录的启动统计
+    QSqlQuery deduplicateQuery(m_database);
+    if (!deduplicateQuery.exec("DELETE FROM software_items WHERE rowid IN ("
+                               "SELECT rowid FROM ("
+                               "SELECT s.rowid AS rowid, ROW_NUMBER() OVER ("
+                               "PARTITION BY s.file_path "
+                               "ORDER BY l.software_id IS NOT NULL DESC, s.updated_at DESC, s.rowid DESC"
+                               ") AS position "
+                               "FROM software_items s LEFT JOIN launch_stats l ON l.software_id = s.id"
+                               ") WHERE position > 1)")) {
+        qCWarning(softwareManager) << "删除重复路径失败:" << deduplicateQuery.lastError().text();
+        return false;
+    }
+    
+    if (deduplicateQuery.numRowsAffected() > 0) {
+        qCInfo(softwareManager) << "删除了" << deduplicateQuery.numRowsAffected() << "条路径重复的软件项";
+    }
+    
+    // 被删除软件项的分类关联
+    if (!executeQuery("DELETE FROM software_category_relations WHERE software_id NOT IN (SELECT id FROM software_items)")) {
+        return false;
+    }
+    
+    // (category, name)覆盖按分类计数和按分类列出时的排序，name覆盖全部列表的排序
+    const QStringList indexes = {
+        "CREATE UNIQUE INDEX IF NOT EXISTS idx_software_items_file_path ON software_items(file_path)",
+        "CREATE INDEX IF NOT EXISTS idx_software_items_category_name ON software_items(category, name)",
+        "CREATE INDEX IF NOT EXISTS idx_software_items_name ON software_items(name)",
+        "CREATE INDEX IF NOT EXISTS idx_relations_software_id ON software_category_relations(software_id)"
+    };
+    
+    for (const QString& index : indexes) {
+        if (!executeQuery(index)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool DatabaseManager::migrateToVersion2()
+{
+    // 旧版本把时间保存为本地时间的ISO字符串；DATETIME列是NUMERIC亲和性，可以直接写入整数，不需要重建表
+    static const QStringList tables = {"software_items", "categories"};
+    
+    auto timestampFromText = [](const QVariant& value) -> qint64 {
+        if (value.typeId() != QMetaType::QString) {
+            return value.toLongLong();
+        }
+        return timestampFromDateTime(QDateTime::fromString(value.toString(), Qt::ISODate));
+    };
+    
+    for (const QString& table : tables) {
+        QSqlQuery selectQuery(m_database);
+        if (!selectQuery.exec(QString("SELECT rowid, created_at, updated_at FROM %1 "
+                                      "WHERE typeof(created_at) = 'text' OR typeof(updated_at) = 'text'").arg(table))) {
+            qCWarning(softwareManager) << "读取" << table << "的时间失败:" << selectQuery.lastError().text();
+            return false;
+        }
+        
+        QVariantList rowIds, createdAts, updatedAts;
+        while (selectQuery.next()) {
+            rowIds.append(selectQuery.value(0));
+            createdAts.append(timestampFromText(selectQuery.value(1)));
+            updatedAts.append(timestampFromText(selectQuery.value(2)));
+        }
+        
+        if (rowIds.isEmpty()) {
+            continue;
+        }
+        
+        QSqlQuery updateQuery(m_database);
+        updateQuery.prepare(QString("UPDATE %1 SET created_at = ?, updated_at = ? WHERE rowid = ?").arg(table));
+        updateQuery.addBindValue(createdAts);
+        updateQuery.addBindValue(updatedAts);
+        updateQuery.addBindValue(rowIds);
+        if (!updateQuery.execBatch()) {
+            qCWarning(softwareManager) << "转换" << table << "的时间失败:" << updateQuery.lastError().text();
+            return false;
+        }
+        
+        qCInfo(softwareManager) << table << "中" << rowIds.size() << "行的时间已转换为时间戳";
+    }
+    
+    // 按添加时间的范围查询
+    return executeQuery("CREATE INDEX IF NOT EXISTS idx_software_items_created_at ON software_items(created_at)");
+}
+
+bool DatabaseManager::migrateToVersion3()
+{
+    // 软件项按id引用分类：旧数据库先补上列，再为已有的分类名称建立分类行并关联；
+    // 之后分类名称只保存在categories中，软件项上的名称副本清空
+    if (!addColumnIfMissing("software_items", "category_id", "INTEGER REFERENCES categories(id)")
+        || !addColumnIfMissing("categories", "item_count", "INTEGER NOT NULL DEFAULT 0")) {
+        return false;
+    }
+    
+    QSqlQuery categoriesQuery(m_database);
+    categoriesQuery.prepare("INSERT OR IGNORE INTO categories (name, created_at, updated_at) "
+                            "SELECT DISTINCT category, ?, ? FROM software_items WHERE COALESCE(category, '') != ''");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    categoriesQuery.addBindValue(now);
+    categoriesQuery.addBindValue(now);
+    if (!categoriesQuery.exec()) {
+        qCWarning(softwareManager) << "建立分类失败:" << categoriesQuery.lastError().text();
+        return false;
+    }
+    
+    // 旧的全文索引从名称副本读取分类，连同触发器一起删除，迁移后按分类表重新建立
+    QSqlQuery existsQuery(m_database);
+    const bool hasFullTextIndex = existsQuery.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'software_items_fts'")
+                                  && existsQuery.next();
+    existsQuery.finish();
+    
+    QStringList statements = {
+        "DROP TRIGGER IF EXISTS software_items_fts_insert",
+        "DROP TRIGGER IF EXISTS software_items_fts_delete",
+        "DROP TRIGGER IF EXISTS software_items_fts_update"
+    };
+    if (hasFullTextIndex) {
+        statements << "DROP TABLE software_items_fts";
+    }
+    
+    statements << QStringList{
+        "UPDATE software_items SET category_id = (SELECT id FROM categories WHERE name = software_items.category)",
+        "UPDATE software_items SET category = NULL",
+        
+        // 按分类计数和按分类列出时的排序都由(category_id, name)覆盖，版本1的(category, name)索引不再使用
+        "DROP INDEX IF EXISTS idx_software_items_category_name",
+        "CREATE INDEX IF NOT EXISTS idx_software_items_category_id_name ON software_items(category_id, name)",
+        
+        // 每个分类的软件项数随软件项的增删和移动增减，按分类计数只需读一行
+        "CREATE TRIGGER IF NOT EXISTS categories_count_insert AFTER INSERT ON software_items "
+        "WHEN new.category_id IS NOT NULL BEGIN "
+        "UPDATE categories SET item_count = item_count + 1 WHERE id = new.category_id; "
+        "END",
+        "CREATE TRIGGER IF NOT EXISTS categories_count_delete AFTER DELETE ON software_items "
+        "WHEN old.category_id IS NOT NULL BEGIN "
+        "UPDATE categories SET item_count = item_count - 1 WHERE id = old.category_id; "
+        "END",
+        "CREATE TRIGGER IF NOT EXISTS categories_count_update AFTER UPDATE OF category_id ON software_items "
+        "WHEN old.category_id IS NOT new.category_id BEGIN "
+        "UPDATE categories SET item_count = item_count - 1 WHERE id = old.category_id; "
+        "UPDATE categories SET item_count = item_count + 1 WHERE id = new.category_id; "
+        "END",
+        
+        // 删除分类时解除软件项的引用
+        "CREATE TRIGGER IF NOT EXISTS categories_cleanup AFTER DELETE ON categories BEGIN "
+        "UPDATE software_items SET category_id = NULL WHERE category_id = old.id; "
+        "END"
+    };
+    
+    for (const QString& statement : statements) {
+        if (!executeQuery(statement)) {
+            return false;
+        }
+    }
+    
+    return refreshCategoryCounts();
+}
+
+bool DatabaseManager::createFullTextIndex()
+{
+    QSqlQuery existsQuery(m_database);
+    bool existed = existsQuery.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'software_items_fts'")
+                   && existsQuery.next();
+    
+    // 外部内容表：索引只保存词项，内容从视图按rowid读取，分类名称由视图连接分类表得到
+    QString createContentView = 
+        "CREATE VIEW IF NOT EXISTS software_items_fts_content AS "
+        "SELECT s.rowid AS item_rowid, s.name AS name, s.description AS description, "
+        "s.file_path AS file_path, c.name AS category "
+        "FROM software_items s LEFT JOIN categories c ON c.id = s.category_id";
+    
+    QString createFtsTable = 
+        "CREATE VIRTUAL TABLE IF NOT EXISTS software_items_fts USING fts5("
+        "name, description, file_path, category, "
+        "content='software_items_fts_content', content_rowid='item_rowid', "
+        "tokenize='unicode61 remove_diacritics 2', prefix='2 3'"
+        ")";
+    
+    if (!executeQuery(createContentView) || !executeQuery(createFtsTable)) {
+        return false;
+    }
+    
+    // 触发器保证每次增删改都同步到全文索引，分类名称按category_id从分类表查出
+    QString createInsertTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS software_items_fts_insert AFTER INSERT ON software_items BEGIN "
+        "INSERT INTO software_items_fts(rowid, name, description, file_path, category) "
+        "VALUES (new.rowid, new.name, new.description, new.file_path, "
+        "(SELECT name FROM categories WHERE id = new.category_id)); "
+        "END";
+    
+    QString createDeleteTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS software_items_fts_delete AFTER DELETE ON software_items BEGIN "
+        "INSERT INTO software_items_fts(software_items_fts, rowid, name, description, file_path, category) "
+        "VALUES ('delete', old.rowid, old.name, old.description, old.file_path, "
+        "(SELECT name FROM categories WHERE id = old.category_id)); "
+        "END";
+    
+    QString createUpdateTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS software_items_fts_update "
+        "AFTER UPDATE OF name, description, file_path, category_id ON software_items BEGIN "
+        "INSERT INTO software_items_fts(software_items_fts, rowid, name, description, file_path, category) "
+        "VALUES ('delete', old.rowid, old.name, old.description, old.file_path, "
+        "(SELECT name FROM categories WHERE id = old.category_id)); "
+        "INSERT INTO software_items_fts(rowid, name, description, file_path, category) "
+        "VALUES (new.rowid, new.name, new.description, new.file_path, "
+        "(SELECT name FROM categories WHERE id = new.category_id)); "
+        "END";
+    
+    // 重命名分类时只重新索引该分类的软件项；删除分类前先把这些软件项的分类从索引中去掉，
+    // 随后置空category_id时分类行已不存在，更新触发器按空名称删除和写入
+    QString createCategoryRenameTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS categories_fts_rename AFTER UPDATE OF name ON categories "
+        "WHEN old.name IS NOT new.name BEGIN "
+        "INSERT INTO software_items_fts(software_items_fts, rowid, name, description, file_path, category) "
+        "SELECT 'delete', rowid, name, description, file_path, old.name FROM software_items WHERE category_id = old.id; "
+        "INSERT INTO software_items_fts(rowid, name, description, file_path, category) "
+        "SELECT rowid, name, description, file_path, new.name FROM software_items WHERE category_id = new.id; "
+        "END";
+    
+    QString createCategoryDeleteTrigger = 
+        "CREATE TRIGGER IF NOT EXISTS categories_fts_delete BEFORE DELETE ON categories BEGIN "
+        "INSERT INTO software_items_fts(software_items_fts, rowid, name, description, file_path, category) "
+        "SELECT 'delete', rowid, name, description, file_path, old.name FROM software_items WHERE category_id = old.id; "
+        "INSERT INTO software_items_fts(rowid, name, description, file_path, category) "
+        "SELECT rowid, name, description, file_path, NULL FROM software_items WHERE category_id = old.id; "
+        "END";
+    
+    if (!executeQuery(createInsertTrigger) || !executeQuery(createDeleteTrigger) || !executeQuery(createUpdateTrigger)
+        || !executeQuery(createCategoryRenameTrigger) || !executeQuery(createCategoryDeleteTrigger)) {
+        return false;
+    }
+    
+    // 旧数据库第一次创建索引时，为已有的软件项建立索引
+    if (!existed) {
+        if (!executeQuery("INSERT INTO software_items_fts(software_items_fts) VALUES ('rebuild')")) {
+            return false;
+        }
+        qCInfo(softwareManager) << "已为现有软件项建立全文索引";
+    }
+    
     return true;
 }
 
+QString DatabaseManager::buildFullTextQuery(const QString& query) const
+{
+    // 每个关键字作为带前缀匹配的短语，双引号内的FTS5语法字符不再生效
+    QStringList phrases;
+    const QStringList terms = query.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    for (QString term : terms) {
+        term.remove('"');
+        
+        // 只含标点的关键字不会产生任何词项
+        bool hasToken = false;
+        for (const QChar& ch : std::as_const(term)) {
+            if (ch.isLetterOrNumber()) {
+                hasToken = true;
+                break;
+            }
+        }
+        
+        if (hasToken) {
+            phrases.append(QString("\"%1\"*").arg(term));
+        }
+    }
+    
+    return phrases.join(' ');
+}
+
+QList<SoftwareItem> DatabaseManager::searchSoftwareItemsWithLike(const QStringList& terms, int limit)
+{
+    QList<SoftwareItem> items;
+    
+    if (terms.isEmpty()) {
+        return items;
+    }
+    
+    QStringList conditions;
+    for (int i = 0; i < terms.size(); ++i) {
+        conditions.append("(s.name LIKE ? ESCAPE '\\' OR s.description LIKE ? ESCAPE '\\' "
+                          "OR s.file_path LIKE ? ESCAPE '\\' OR c.name LIKE ? ESCAPE '\\')");
+    }
+    
+    QSqlQuery& query = cachedQuery(QString("SELECT %1 FROM %2 WHERE ").arg(SoftwareItemColumns, SoftwareItemSource)
+                                   + conditions.join(" AND ") + " ORDER BY s.name LIMIT ?");
+    
+    for (QString term : terms) {
+        term.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+        const QString pattern = "%" + term + "%";
+        for (int column = 0; column < 4; ++column) {
+            query.addBindValue(pattern);
+        }
+    }
+    query.addBindValue(limit);
+    
+    if (!query.exec()) {
+        qCWarning(softwareManager) << "搜索软件项失败:" << query.lastError().text();
+        return items;
+    }
+    
+    while (query.next()) {
+        items.append(softwareItemFromQuery(query));
+    }
+    
+    return items;
+}
+
+SoftwareItem DatabaseManager::softwareItemFromQuery(const QSqlQuery& query)
+{
+    // 列顺序：id, name, file_path, category, description, version, created_at, updated_at, icon_key
+    SoftwareItem item(query.value(0).toString(), query.value(1).toString(), query.value(2).toString(),
+                      query.value(3).toString(), query.value(4).toString(), query.value(5).toString(),
+                      dateTimeFromTimestamp(query.value(6)), dateTimeFromTimestamp(query.value(7)));
+    item.setIconKey(query.value(8).toString());
+    return item;
+}
+
+bool DatabaseManager::addColumnIfMissing(const QString& table, const QString& column, const QString& definition)
+{
+    QSqlQuery query(m_database);
+    if (!query.exec(QString("PRAGMA table_info(%1)").arg(table))) {
+        qCWarning(softwareManager) << "查询表结构失败:" << table << query.lastError().text();
+        return false;
+    }
+    
+    while (query.next()) {
+        if (query.value(1).toString() == column) {
+            return true;
+        }
+    }
+    
+    return executeQuery(QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(table, column, definition));
+}
+
+QSqlQuery& DatabaseManager::cachedQuery(const QString& sql)
+{
+    // 语句按SQL文本缓存，在连接的生命周期内只准备一次
+    auto it = m_queryCache.constFind(sql);
+    if (it != m_queryCache.constEnd()) {
+        return *it.value();
+    }
+    
+    QSqlQuery* query = new QSqlQuery(m_database);
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        // 准备失败（如表尚未创建）时不缓存，下次调用重新准备；exec会返回同样的错误
+        qCWarning(softwareManager) << "准备SQL失败:" << sql << ", 错误:" << query->lastError().text();
+        m_failedQuery = std::move(*query);
+        delete query;
+        return m_failedQuery;
+    }
+    
+    m_queryCache.insert(sql, query);
+    return *query;
+}
+
+void DatabaseManager::clearQueryCache()
+{
+    // 语句必须在连接关闭之前释放
+    qDeleteAll(m_queryCache);
+    m_queryCache.clear();
+    m_failedQuery = QSqlQuery();
+}
+
 bool DatabaseManager::executeQuery(const QString& sql)
 {
     if (!isDatabaseValid()) {
@@ -598,7 +1919,7 @@ bool DatabaseManager::executeQuery(const QString& sql)
     return true;
 }
 
-QString DatabaseManager::getDatabasePath() const
+QString DatabaseManager::defaultDatabasePath()
 {
     // 获取应用程序数据目录
     QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -618,27 +1939,82 @@ bool DatabaseManager::openDatabase()
     // 关闭现有连接
     closeDatabase();
     
-    // 创建数据库连接
-    m_database = QSqlDatabase::addDatabase("QSQLITE");
+    // 每个实例使用独立的命名连接，多个实例可以同时打开不同的数据库文件
+    m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
     m_database.setDatabaseName(m_dbPath);
+    if (m_openMode == ReadOnly) {
+        m_database.setConnectOptions("QSQLITE_OPEN_READONLY");
+    }
     
     if (!m_database.open()) {
         qCWarning(softwareManager) << "无法打开数据库:" << m_database.lastError().text();
         return false;
     }
     
-    qCInfo(softwareManager) << "成功打开数据库:" << m_dbPath;
+    qCInfo(softwareManager) << "成功打开数据库:" << m_dbPath << (m_openMode == ReadOnly ? "（只读）" : "");
+    
+    // 调优失败不影响使用，连接保持SQLite的默认行为
+    applyPerformanceProfile();
+    
+    // 只读连接不建表，全文索引是否可用以写连接创建的结果为准
+    if (m_openMode == ReadOnly) {
+        QSqlQuery query(m_database);
+        m_fullTextAvailable = query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'software_items_fts'")
+                              && query.next();
+    }
     return true;
 }
 
+bool DatabaseManager::applyPerformanceProfile()
+{
+    // busy_timeout放在最前，切换日志模式时也能等待其他连接释放锁
+    QStringList pragmas = {
+        QString("PRAGMA busy_timeout = %1").arg(m_profile.busyTimeoutMs),
+        QString("PRAGMA synchronous = %1").arg(m_profile.synchronousNormal ? "NORMAL" : "FULL"),
+        // 负数表示以KiB为单位
+        QString("PRAGMA cache_size = %1").arg(-qint64(m_profile.cacheSizeMb) * 1024),
+        QString("PRAGMA mmap_size = %1").arg(qint64(m_profile.mmapSizeMb) * 1024 * 1024),
+        QString("PRAGMA temp_store = %1").arg(m_profile.tempStoreMemory ? "MEMORY" : "DEFAULT")
+    };
+    
+    // 日志模式保存在数据库文件中，由写连接设置，只读连接沿用
+    if (m_openMode == ReadWrite) {
+        pragmas.insert(1, QString("PRAGMA journal_mode = %1").arg(m_profile.walEnabled ? "WAL" : "DELETE"));
+    }
+    
+    bool success = true;
+    for (const QString& pragma : pragmas) {
+        QSqlQuery query(m_database);
+        if (!query.exec(pragma)) {
+            qCWarning(softwareManager) << "设置PRAGMA失败:" << pragma << ", 错误:" << query.lastError().text();
+            success = false;
+        }
+    }
+    
+    // 网络文件系统等不支持WAL时，SQLite会保留原来的日志模式
+    const QString journalMode = pragmaValue("journal_mode").toString().toLower();
+    if (m_profile.walEnabled && journalMode != "wal") {
+        qCWarning(softwareManager) << "无法启用WAL模式，当前日志模式:" << journalMode;
+        success = false;
+    }
+    
+    qCInfo(softwareManager) << "数据库连接参数: journal_mode =" << journalMode
+                            << ", synchronous =" << (m_profile.synchronousNormal ? "NORMAL" : "FULL")
+                            << ", cache_size =" << m_profile.cacheSizeMb << "MB"
+                            << ", mmap_size =" << m_profile.mmapSizeMb << "MB";
+    return success;
+}
+
 void DatabaseManager::closeDatabase()
 {
-    if (m_database.isOpen()) {
+    clearQueryCache();
+    
+    // 移除数据库连接前必须释放所有引用
+    if (m_database.isValid()) {
         m_database.close();
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
     }
-    
-    // 移除数据库连接
-    QSqlDatabase::removeDatabase(m_database.connectionName());
 }
 
 QString DatabaseManager::escapeString(const QString& str) const
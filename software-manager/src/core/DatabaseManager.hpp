@@ -3,21 +3,78 @@
 
 #include <QObject>
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QHash>
 #include <QList>
 #include <QStringList>
-
-class SoftwareItem;
+#include <QVariant>
+#include <functional>
+#include "../model/SoftwareItem.hpp"
+#include "../model/DirectorySnapshot.hpp"
+#include "../model/LaunchStats.hpp"
 
 class DatabaseManager : public QObject {
     Q_OBJECT
 
 public:
+    // 连接调优参数，每次打开数据库时以PRAGMA应用到连接上
+    struct PerformanceProfile {
+        bool walEnabled;            // journal_mode=WAL，读写互不阻塞
+        bool synchronousNormal;     // synchronous=NORMAL，WAL下只在检查点时同步磁盘
+        int cacheSizeMb;            // 页缓存大小
+        int mmapSizeMb;             // 内存映射读取的上限，0表示不使用
+        bool tempStoreMemory;       // 临时表和排序使用内存
+        int busyTimeoutMs;          // 数据库被锁定时的等待时间
+        
+        // 推荐配置和SQLite的默认行为（用于对比测试）
+        static PerformanceProfile tuned();
+        static PerformanceProfile sqliteDefaults();
+        
+        // 从QSettings的Database/分组读取，未设置的项使用推荐配置
+        static PerformanceProfile fromSettings();
+        void saveToSettings() const;
+    };
+    
+    // 合并扫描结果的结果；inserted和updated中是写入后数据库中的记录，
+    // 更新的记录沿用原有的id，以及用户修改过的分类和描述
+    struct IngestResult {
+        QList<SoftwareItem> inserted;
+        QList<SoftwareItem> updated;
+        int unchanged = 0;
+    };
+    
+    // 当前程序的数据库结构版本，保存在PRAGMA user_version中
+    static constexpr int SchemaVersion = 3;
+    
+    // 只读连接用于读连接池，不建表也不迁移，写操作会失败
+    enum OpenMode {
+        ReadWrite,
+        ReadOnly
+    };
+    
+    // 列出软件项的顺序：按名称，或按启动频率从高到低（从未启动的按名称排在最后）
+    enum SortOrder {
+        SortByName,
+        SortByFrecency
+    };
+    
     explicit DatabaseManager(QObject* parent = nullptr);
+    explicit DatabaseManager(const QString& dbPath, OpenMode mode = ReadWrite, QObject* parent = nullptr);
     ~DatabaseManager();
     
+    // 应用程序数据目录下的默认数据库文件
+    static QString defaultDatabasePath();
+    
     // 数据库初始化
     bool initializeDatabase();
     bool isDatabaseValid() const;
+    bool isReadOnly() const;
+    int schemaVersion();
+    
+    // 连接调优：设置后立即应用到当前连接，重新打开时沿用
+    PerformanceProfile performanceProfile() const;
+    bool setPerformanceProfile(const PerformanceProfile& profile);
+    QVariant pragmaValue(const QString& pragma);
     
     // 软件项管理
     bool addSoftwareItem(const SoftwareItem& item);
@@ -25,37 +82,100 @@ public:
     bool removeSoftwareItem(const QString& id);
     QList<SoftwareItem> getAllSoftwareItems();
     QList<SoftwareItem> getSoftwareItemsByCategory(const QString& category);
+    
+    // 按order的顺序逐行读取软件项，不构建完整的列表；category为空时遍历全部软件项。
+    // visitor返回false时停止遍历；visitor中可以执行其他查询，但不能再读取软件项列表
+    using SoftwareItemVisitor = std::function<bool(const SoftwareItem&)>;
+    bool forEachSoftwareItem(const QString& category, const SoftwareItemVisitor& visitor,
+                             SortOrder order = SortByName);
+    
+    // 按order的顺序分页读取，limit小于0时读取offset之后的全部软件项
+    QList<SoftwareItem> fetchSoftwareItems(const QString& category, int offset, int limit,
+                                           SortOrder order = SortByName);
+    
+    // 按添加时间从新到旧返回since之后添加的软件项，limit小于0时返回全部
+    QList<SoftwareItem> getSoftwareItemsAddedSince(const QDateTime& since, int limit = -1);
+    
     SoftwareItem getSoftwareItemById(const QString& id);
     bool softwareItemExists(const QString& id);
     
-    // 分类管理
+    // 全文搜索：按空白分隔的每个关键字都按前缀匹配名称、描述、路径或分类，
+    // 结果按bm25相关度排序；limit小于0时返回全部结果
+    QList<SoftwareItem> searchSoftwareItems(const QString& query, int limit = -1);
+    bool isFullTextSearchAvailable() const;
+    
+    // 分类管理：软件项写入时自动建立所用的分类；软件项按id引用分类，重命名只改分类行
     bool addCategory(const QString& name);
     bool removeCategory(const QString& name);
+    bool renameCategory(const QString& oldName, const QString& newName);
     QStringList getAllCategories();
     bool categoryExists(const QString& name);
     
-    // 软件分类关联
+    // 软件分类关联：软件项按category_id引用分类，每个分类的软件项数由触发器维护
     bool moveSoftwareToCategory(const QString& softwareId, const QString& categoryName);
     int getCategoryCount(const QString& category);
+    QHash<QString, int> getCategoryCounts();
     
     // 批量操作
     bool batchInsertSoftwareItems(const QList<SoftwareItem>& items);
     bool batchUpdateSoftwareItems(const QList<SoftwareItem>& items);
+    bool removeSoftwareItemsByFilePaths(const QStringList& filePaths);
     
-    // 数据库维护
+    // 按规范化的文件路径合并扫描结果（INSERT ... ON CONFLICT DO UPDATE），
+    // 重新扫描时只写入有变化的软件项
+    bool ingestSoftwareItems(const QList<SoftwareItem>& items, IngestResult* result = nullptr);
+    static QString normalizeFilePath(const QString& filePath);
+    
+    // 增量扫描的目录快照
+    QList<DirectorySnapshot> getDirectorySnapshots();
+    bool saveDirectorySnapshots(const QList<DirectorySnapshot>& snapshots, const QStringList& removedPaths);
+    
+    // 启动统计
+    QList<LaunchStats> getLaunchStats();
+    bool saveLaunchStats(const QList<LaunchStats>& stats);
+    QStringList getFrecentSoftwareIds(int limit);
+    
+    // 数据库维护：备份时其他连接照常读写，恢复在一个事务中替换全部数据，不关闭连接
     bool backupDatabase(const QString& backupPath);
     bool restoreDatabase(const QString& backupPath);
     qint64 getDatabaseSize() const;
     
 private:
     QString m_dbPath;
+    QString m_connectionName;
+    OpenMode m_openMode;
     QSqlDatabase m_database;
+    bool m_fullTextAvailable;
+    PerformanceProfile m_profile;
+    
+    // 按SQL文本缓存的预编译语句，随连接关闭释放
+    QHash<QString, QSqlQuery*> m_queryCache;
+    QSqlQuery m_failedQuery;
     
     // 私有方法
     bool createTables();
+    bool createFullTextIndex();
+    bool migrateSchema();
+    bool applyMigration(int version);
+    bool migrateToVersion1();
+    bool migrateToVersion2();
+    bool migrateToVersion3();
+    QString buildFullTextQuery(const QString& query) const;
+    QList<SoftwareItem> searchSoftwareItemsWithLike(const QStringList& terms, int limit);
+    bool visitSoftwareItems(bool filterByCategory, const QString& category, int offset, int limit,
+                            const SoftwareItemVisitor& visitor, SortOrder order = SortByName);
+    static SoftwareItem softwareItemFromQuery(const QSqlQuery& query);
+    bool addColumnIfMissing(const QString& table, const QString& column, const QString& definition);
+    bool ensureCategories(const QStringList& names);
+    bool refreshCategoryCounts();
+    bool importDatabase(const QString& sourcePath);
+    QStringList tableColumns(const QString& table);
+    static void removeDatabaseFiles(const QString& dbPath);
     bool executeQuery(const QString& sql);
-    QString getDatabasePath() const;
+    QSqlQuery& cachedQuery(const QString& sql);
+    void clearQueryCache();
     bool openDatabase();
+    bool applyPerformanceProfile();
     void closeDatabase();
     
     // 工具方法
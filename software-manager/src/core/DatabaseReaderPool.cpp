@@ -0,0 +1,90 @@
+#include "DatabaseReaderPool.hpp"
+#include "../utils/Logging.hpp"
+
+DatabaseReaderPool::DatabaseReaderPool(const QString& dbPath, int readerCount, QObject* parent)
+    : QObject(parent)
+{
+    if (readerCount <= 0) {
+        readerCount = qBound(1, QThread::idealThreadCount(), 4);
+    }
+    
+    for (int i = 0; i < readerCount; ++i) {
+        m_readers.append(new DatabaseExecutor(dbPath, DatabaseManager::ReadOnly, this));
+    }
+    
+    qCInfo(softwareManager) << "只读连接池已创建，连接数:" << readerCount;
+}
+
+DatabaseReaderPool::~DatabaseReaderPool()
+{
+    // 各读连接在自己的线程中关闭
+    qDeleteAll(m_readers);
+    m_readers.clear();
+}
+
+DatabaseExecutor* DatabaseReaderPool::leastBusyReader() const
+{
+    DatabaseExecutor* reader = m_readers.first();
+    for (DatabaseExecutor* candidate : m_readers) {
+        if (candidate->pendingRequests() < reader->pendingRequests()) {
+            reader = candidate;
+        }
+    }
+    return reader;
+}
+
+QFuture<QList<SoftwareItem>> DatabaseReaderPool::searchSoftwareItemsAsync(const QString& query, int limit)
+{
+    return run([query, limit](DatabaseManager& databaseManager) {
+        return databaseManager.searchSoftwareItems(query, limit);
+    });
+}
+
+QFuture<int> DatabaseReaderPool::getCategoryCountAsync(const QString& category)
+{
+    return run([category](DatabaseManager& databaseManager) {
+        return databaseManager.getCategoryCount(category);
+    });
+}
+
+QFuture<QHash<QString, int>> DatabaseReaderPool::getCategoryCountsAsync()
+{
+    return run([](DatabaseManager& databaseManager) {
+        return databaseManager.getCategoryCounts();
+    });
+}
+
+QFuture<SoftwareItem> DatabaseReaderPool::getSoftwareItemByIdAsync(const QString& id)
+{
+    return run([id](DatabaseManager& databaseManager) {
+        return databaseManager.getSoftwareItemById(id);
+    });
+}
+
+QFuture<bool> DatabaseReaderPool::backupDatabaseAsync(const QString& backupPath)
+{
+    return run([backupPath](DatabaseManager& databaseManager) {
+        return databaseManager.backupDatabase(backupPath);
+    });
+}
+
+void DatabaseReaderPool::setPerformanceProfile(const DatabaseManager::PerformanceProfile& profile)
+{
+    for (DatabaseExecutor* reader : m_readers) {
+        reader->run([profile](DatabaseManager& databaseManager) {
+            return databaseManager.setPerformanceProfile(profile);
+        });
+    }
+}
+
+int DatabaseReaderPool::readerCount() const
+{
+    return m_readers.size();
+}
+
+void DatabaseReaderPool::waitForIdle()
+{
+    for (DatabaseExecutor* reader : m_readers) {
+        reader->waitForIdle();
+    }
+}
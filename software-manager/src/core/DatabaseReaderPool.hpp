@@ -0,0 +1,53 @@
+#ifndef DATABASEREADERPOOL_H
+#define DATABASEREADERPOOL_H
+
+#include <QObject>
+#include <QList>
+#include "DatabaseExecutor.hpp"
+
+// 只读连接池：每个读连接在自己的线程中打开同一个WAL数据库，
+// 搜索、分类计数等查询可以彼此并行，也不必排在扫描写入的后面。
+// 写入和依赖写入顺序的读取仍然交给写连接所在的DatabaseExecutor
+class DatabaseReaderPool : public QObject {
+    Q_OBJECT
+
+public:
+    // readerCount不大于0时按CPU核心数创建，最多4个；读连接在第一个查询时才打开，
+    // 提交查询前写连接必须已经建好数据库文件和表（例如在写执行器的请求完成之后再提交）
+    explicit DatabaseReaderPool(const QString& dbPath = QString(), int readerCount = 0, QObject* parent = nullptr);
+    ~DatabaseReaderPool();
+    
+    // 在当前最空闲的读连接上执行只读操作
+    template <typename Function>
+    QFuture<std::invoke_result_t<Function, DatabaseManager&>> run(Function function);
+    
+    // 常用查询的异步版本
+    QFuture<QList<SoftwareItem>> searchSoftwareItemsAsync(const QString& query, int limit = -1);
+    QFuture<int> getCategoryCountAsync(const QString& category);
+    QFuture<QHash<QString, int>> getCategoryCountsAsync();
+    QFuture<SoftwareItem> getSoftwareItemByIdAsync(const QString& id);
+    
+    // 在读连接上写出数据库的一致快照，备份期间写连接照常写入
+    QFuture<bool> backupDatabaseAsync(const QString& backupPath);
+    
+    // 在每个读连接上应用新的性能配置，尚未打开的读连接打开时读取已保存的配置
+    void setPerformanceProfile(const DatabaseManager::PerformanceProfile& profile);
+    
+    int readerCount() const;
+    
+    // 等待所有读连接上已提交的查询执行完毕
+    void waitForIdle();
+    
+private:
+    QList<DatabaseExecutor*> m_readers;
+    
+    DatabaseExecutor* leastBusyReader() const;
+};
+
+template <typename Function>
+QFuture<std::invoke_result_t<Function, DatabaseManager&>> DatabaseReaderPool::run(Function function)
+{
+    return leastBusyReader()->run(std::move(function));
+}
+
+#endif // DATABASEREADERPOOL_H
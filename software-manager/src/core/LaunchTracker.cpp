@@ -0,0 +1,133 @@
+#include "LaunchTracker.hpp"
+#include "DatabaseExecutor.hpp"
+#include <algorithm>
+#include <cmath>
+#include "../utils/Logging.hpp"
+
+namespace {
+
+// 半衰期14天：两周前的一次启动只相当于今天的半次
+const double HalfLifeDays = 14.0;
+const double MsPerDay = 24.0 * 60 * 60 * 1000;
+const double DecayPerMs = std::log(2.0) / (HalfLifeDays * MsPerDay);
+
+}
+
+LaunchTracker::LaunchTracker(DatabaseExecutor* databaseExecutor, QObject* parent)
+    : QObject(parent)
+    , m_databaseExecutor(databaseExecutor)
+{
+    // 合并短时间内的多次启动，写入在数据库线程中进行
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(2000);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LaunchTracker::flush);
+}
+
+LaunchTracker::~LaunchTracker()
+{
+    // 最后一次写入排在执行器关闭连接之前完成
+    flush();
+}
+
+void LaunchTracker::load()
+{
+    if (!m_databaseExecutor) {
+        return;
+    }
+    
+    m_databaseExecutor->run([](DatabaseManager& databaseManager) {
+        return databaseManager.getLaunchStats();
+    }).then(this, [this](const QList<LaunchStats>& stats) {
+        for (const LaunchStats& entry : stats) {
+            // 加载完成前已经记录过启动的软件以内存中的统计为准
+            if (!m_stats.contains(entry.softwareId)) {
+                m_stats.insert(entry.softwareId, entry);
+            }
+        }
+    });
+}
+
+void LaunchTracker::recordLaunch(const QString& softwareId, qint64 timestamp)
+{
+    LaunchStats& entry = m_stats[softwareId];
+    entry.softwareId = softwareId;
+    entry.frecency = frecencyKey(entry, timestamp);
+    entry.launchCount += 1;
+    entry.lastLaunched = std::max(entry.lastLaunched, timestamp);
+    
+    m_pendingIds.insert(softwareId);
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+    
+    emit launchRecorded(softwareId);
+}
+
+LaunchStats LaunchTracker::stats(const QString& softwareId) const
+{
+    return m_stats.value(softwareId);
+}
+
+double LaunchTracker::frecency(const QString& softwareId) const
+{
+    auto it = m_stats.constFind(softwareId);
+    return it != m_stats.constEnd() ? it->frecency : 0.0;
+}
+
+double LaunchTracker::score(const QString& softwareId, qint64 now) const
+{
+    auto it = m_stats.constFind(softwareId);
+    if (it == m_stats.constEnd() || it->launchCount == 0) {
+        return 0.0;
+    }
+    return std::exp(it->frecency - DecayPerMs * now);
+}
+
+void LaunchTracker::flush()
+{
+    m_flushTimer.stop();
+    
+    if (m_pendingIds.isEmpty() || !m_databaseExecutor) {
+        return;
+    }
+    
+    QList<LaunchStats> pending;
+    pending.reserve(m_pendingIds.size());
+    for (const QString& softwareId : std::as_const(m_pendingIds)) {
+        pending.append(m_stats.value(softwareId));
+    }
+    m_pendingIds.clear();
+    
+    // 写入失败时把这些软件重新标记为未保存，稍后与新的启动一起重试；
+    // 启动统计销毁后回调不再执行
+    m_databaseExecutor->run([pending](DatabaseManager& databaseManager) {
+        return databaseManager.saveLaunchStats(pending);
+    }).then(this, [this, pending](bool success) {
+        if (success) {
+            return;
+        }
+        
+        qCWarning(softwareManager) << "写入启动统计失败，稍后重试";
+        for (const LaunchStats& entry : pending) {
+            m_pendingIds.insert(entry.softwareId);
+        }
+        if (!m_flushTimer.isActive()) {
+            m_flushTimer.start();
+        }
+    });
+}
+
+double LaunchTracker::frecencyKey(const LaunchStats& previous, qint64 timestamp)
+{
+    // 衰减得分 sum(exp(-λ(now - t_i))) 等于 exp(key - λ·now)，其中 key = ln(sum(exp(λ·t_i)))；
+    // key与当前时间无关，任何时刻按key排序都等价于按衰减得分排序，已有记录不需要随时间重写
+    const double launchKey = DecayPerMs * timestamp;
+    if (previous.launchCount == 0) {
+        return launchKey;
+    }
+    
+    // ln(exp(a) + exp(b))，避免指数溢出
+    const double high = std::max(previous.frecency, launchKey);
+    const double low = std::min(previous.frecency, launchKey);
+    return high + std::log1p(std::exp(low - high));
+}
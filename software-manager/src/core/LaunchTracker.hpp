@@ -0,0 +1,53 @@
+#ifndef LAUNCHTRACKER_H
+#define LAUNCHTRACKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QTimer>
+#include <QDateTime>
+#include <QPointer>
+#include "../model/LaunchStats.hpp"
+
+class DatabaseExecutor;
+
+// 记录软件的启动次数和时间，按frecency（频率与最近程度）排序；
+// 统计常驻内存，启动时立即更新，读取和写入都交给数据库线程，写入合并后延迟提交，不阻塞启动操作
+class LaunchTracker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LaunchTracker(DatabaseExecutor* databaseExecutor, QObject* parent = nullptr);
+    ~LaunchTracker();
+    
+    // 从数据库异步加载已有的统计，完成前记录的启动不会被覆盖
+    void load();
+    
+    void recordLaunch(const QString& softwareId, qint64 timestamp = QDateTime::currentMSecsSinceEpoch());
+    LaunchStats stats(const QString& softwareId) const;
+    
+    // 排序键与时间无关，未启动过的软件为0
+    double frecency(const QString& softwareId) const;
+    
+    // 当前时刻的衰减得分：每次启动贡献1，每过一个半衰期减半
+    double score(const QString& softwareId, qint64 now = QDateTime::currentMSecsSinceEpoch()) const;
+    
+    // 立即把尚未保存的统计提交给数据库线程；之后提交的请求在写入完成后执行
+    void flush();
+    
+    // 在已有排序键上叠加一次启动
+    static double frecencyKey(const LaunchStats& previous, qint64 timestamp);
+    
+signals:
+    void launchRecorded(const QString& softwareId);
+    
+private:
+    // 执行器先于启动统计销毁时不再提交写入
+    QPointer<DatabaseExecutor> m_databaseExecutor;
+    QHash<QString, LaunchStats> m_stats;
+    QSet<QString> m_pendingIds;
+    QTimer m_flushTimer;
+};
+
+#endif // LAUNCHTRACKER_H
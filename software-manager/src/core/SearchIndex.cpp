@@ -0,0 +1,381 @@
+#include "SearchIndex.hpp"
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
+#include <QDateTime>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include "LaunchTracker.hpp"
+#include "../utils/FuzzyMatcher.hpp"
+#include "../utils/Logging.hpp"
+
+SearchIndex::SearchIndex(QObject* parent)
+    : QObject(parent)
+    , m_removedCount(0)
+    , m_launchTracker(nullptr)
+{
+}
+
+void SearchIndex::setSoftwareItems(const QList<SoftwareItem>& items)
+{
+    clear();
+    
+    m_documents.reserve(items.size());
+    m_nameMasks.reserve(items.size());
+    for (const SoftwareItem& item : items) {
+        indexDocument(item);
+    }
+    
+    qCInfo(softwareManager) << "搜索索引已建立，软件项:" << m_documents.size() << "三元组:" << m_postings.size();
+}
+
+void SearchIndex::addSoftwareItem(const SoftwareItem& item)
+{
+    // 同一ID重复添加时视为更新
+    removeSoftwareItem(item.getId());
+    indexDocument(item);
+}
+
+void SearchIndex::updateSoftwareItem(const SoftwareItem& item)
+{
+    addSoftwareItem(item);
+}
+
+void SearchIndex::removeSoftwareItem(const QString& id)
+{
+    const int document = m_documentById.value(id, -1);
+    if (document >= 0) {
+        removeDocument(document);
+        compactIfNeeded();
+    }
+}
+
+void SearchIndex::removeSoftwareItemsByFilePaths(const QStringList& filePaths)
+{
+    for (const QString& filePath : filePaths) {
+        const int document = m_documentByFilePath.value(filePath, -1);
+        if (document >= 0) {
+            removeDocument(document);
+        }
+    }
+    compactIfNeeded();
+}
+
+void SearchIndex::clear()
+{
+    m_documents.clear();
+    m_documentById.clear();
+    m_documentByFilePath.clear();
+    m_nameMasks.clear();
+    m_postings.clear();
+    m_removedCount = 0;
+}
+
+int SearchIndex::size() const
+{
+    return m_documentById.size();
+}
+
+void SearchIndex::setLaunchTracker(const LaunchTracker* launchTracker)
+{
+    m_launchTracker = launchTracker;
+}
+
+QList<SoftwareItem> SearchIndex::search(const QString& keyword, int limit) const
+{
+    static const QRegularExpression whitespace("\\s+");
+    const QStringList terms = keyword.toLower().split(whitespace, Qt::SkipEmptyParts);
+    if (terms.isEmpty() || limit == 0) {
+        return QList<SoftwareItem>();
+    }
+    
+    // 长度不少于3的关键字用倒排表求交集得到候选文档
+    QVector<int> candidates;
+    bool hasCandidates = false;
+    for (const QString& term : terms) {
+        if (term.length() < 3) {
+            continue;
+        }
+        
+        const QVector<int> termCandidates = candidatesFor(term);
+        if (!hasCandidates) {
+            candidates = termCandidates;
+            hasCandidates = true;
+        } else {
+            QVector<int> intersection;
+            std::set_intersection(candidates.constBegin(), candidates.constEnd(),
+                                  termCandidates.constBegin(), termCandidates.constEnd(),
+                                  std::back_inserter(intersection));
+            candidates.swap(intersection);
+        }
+        
+        if (candidates.isEmpty()) {
+            return QList<SoftwareItem>();
+        }
+    }
+    
+    // 只有短关键字时逐个检查全部文档
+    if (!hasCandidates) {
+        candidates.resize(m_documents.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+    
+    // 三元组只能排除不可能的文档，最后确认关键字确实出现
+    struct Hit {
+        int document;
+        int rank;
+        double frecency;
+    };
+    QVector<Hit> hits;
+    const QString& firstTerm = terms.first();
+    for (int document : std::as_const(candidates)) {
+        const Document& entry = m_documents.at(document);
+        if (!entry.alive) {
+            continue;
+        }
+        
+        bool matched = true;
+        for (const QString& term : terms) {
+            if (!entry.text.contains(term)) {
+                matched = false;
+                break;
+            }
+        }
+        if (!matched) {
+            continue;
+        }
+        
+        // 名称以关键字开头 > 名称包含关键字 > 描述或文件名包含关键字
+        int rank = 2;
+        if (entry.name.startsWith(firstTerm)) {
+            rank = 0;
+        } else if (entry.name.contains(firstTerm)) {
+            rank = 1;
+        }
+        const double frecency = m_launchTracker ? m_launchTracker->frecency(entry.item.getId()) : 0.0;
+        hits.append({document, rank, frecency});
+    }
+    
+    // 同一档次内常用的软件在前
+    auto lessThan = [this](const Hit& left, const Hit& right) {
+        if (left.rank != right.rank) {
+            return left.rank < right.rank;
+        }
+        if (left.frecency != right.frecency) {
+            return left.frecency > right.frecency;
+        }
+        return m_documents.at(left.document).name < m_documents.at(right.document).name;
+    };
+    
+    if (limit > 0 && limit < hits.size()) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), lessThan);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), lessThan);
+    }
+    
+    QList<SoftwareItem> results;
+    results.reserve(hits.size());
+    for (const Hit& hit : std::as_const(hits)) {
+        results.append(m_documents.at(hit.document).item);
+    }
+    return results;
+}
+
+QList<SoftwareItem> SearchIndex::fuzzySearch(const QString& keyword, int limit) const
+{
+    static const QRegularExpression whitespace("\\s+");
+    const QStringList terms = keyword.split(whitespace, Qt::SkipEmptyParts);
+    if (terms.isEmpty() || limit == 0) {
+        return QList<SoftwareItem>();
+    }
+    
+    QVector<FuzzyMatcher> matchers;
+    quint64 mask = 0;
+    for (const QString& term : terms) {
+        matchers.append(FuzzyMatcher(term));
+        mask |= matchers.last().patternMask();
+    }
+    
+    // 先用字符位图排除名称中缺少关键字字符的文档：每个文档只需一次按位与，
+    // 循环没有分支依赖，编译器可以向量化
+    QVector<int> candidates;
+    const quint64* masks = m_nameMasks.constData();
+    const int count = m_nameMasks.size();
+    for (int document = 0; document < count; ++document) {
+        if ((masks[document] & mask) == mask) {
+            candidates.append(document);
+        }
+    }
+    
+    // 只对通过预筛选的文档完整打分，每个关键字都必须匹配
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    struct Hit {
+        int document;
+        int score;
+    };
+    QVector<Hit> hits;
+    for (int document : std::as_const(candidates)) {
+        const Document& entry = m_documents.at(document);
+        if (!entry.alive) {
+            continue;
+        }
+        
+        const QString name = entry.item.getName();
+        int total = 0;
+        for (const FuzzyMatcher& matcher : std::as_const(matchers)) {
+            const int score = matcher.score(name, masks[document]);
+            if (score < 0) {
+                total = -1;
+                break;
+            }
+            total += score;
+        }
+        if (total >= 0) {
+            hits.append({document, total + launchBonus(entry.item.getId(), now)});
+        }
+    }
+    
+    // 得分相同时较短的名称更接近关键字
+    auto greaterThan = [this](const Hit& left, const Hit& right) {
+        if (left.score != right.score) {
+            return left.score > right.score;
+        }
+        const QString& leftName = m_documents.at(left.document).name;
+        const QString& rightName = m_documents.at(right.document).name;
+        if (leftName.length() != rightName.length()) {
+            return leftName.length() < rightName.length();
+        }
+        return leftName < rightName;
+    };
+    
+    if (limit > 0 && limit < hits.size()) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), greaterThan);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), greaterThan);
+    }
+    
+    QList<SoftwareItem> results;
+    results.reserve(hits.size());
+    for (const Hit& hit : std::as_const(hits)) {
+        results.append(m_documents.at(hit.document).item);
+    }
+    return results;
+}
+
+void SearchIndex::indexDocument(const SoftwareItem& item)
+{
+    const int document = m_documents.size();
+    
+    Document entry;
+    entry.item = item;
+    entry.name = item.getName().toLower();
+    entry.text = normalizedText(item);
+    entry.alive = true;
+    
+    // 文档编号递增，倒排表追加后仍保持有序
+    QSet<quint64> trigrams;
+    for (int i = 0; i + 3 <= entry.text.length(); ++i) {
+        trigrams.insert(trigramAt(entry.text, i));
+    }
+    for (quint64 trigram : std::as_const(trigrams)) {
+        m_postings[trigram].append(document);
+    }
+    
+    m_documents.append(entry);
+    m_nameMasks.append(FuzzyMatcher::characterMask(item.getName()));
+    m_documentById.insert(item.getId(), document);
+    m_documentByFilePath.insert(item.getFilePath(), document);
+}
+
+void SearchIndex::removeDocument(int document)
+{
+    Document& entry = m_documents[document];
+    if (!entry.alive) {
+        return;
+    }
+    
+    // 倒排表中的编号保留到下次压缩，搜索时跳过已删除的文档
+    entry.alive = false;
+    m_nameMasks[document] = 0;
+    m_documentById.remove(entry.item.getId());
+    if (m_documentByFilePath.value(entry.item.getFilePath(), -1) == document) {
+        m_documentByFilePath.remove(entry.item.getFilePath());
+    }
+    entry.item = SoftwareItem();
+    entry.text.clear();
+    entry.name.clear();
+    ++m_removedCount;
+}
+
+void SearchIndex::compactIfNeeded()
+{
+    // 已删除的文档超过一半时重建，避免倒排表无限增长
+    if (m_removedCount < 1024 || m_removedCount * 2 < m_documents.size()) {
+        return;
+    }
+    
+    QList<SoftwareItem> items;
+    items.reserve(m_documents.size() - m_removedCount);
+    for (const Document& entry : std::as_const(m_documents)) {
+        if (entry.alive) {
+            items.append(entry.item);
+        }
+    }
+    setSoftwareItems(items);
+}
+
+QVector<int> SearchIndex::candidatesFor(const QString& term) const
+{
+    // 从最短的倒排表开始求交集
+    QVector<const QVector<int>*> lists;
+    for (int i = 0; i + 3 <= term.length(); ++i) {
+        auto it = m_postings.constFind(trigramAt(term, i));
+        if (it == m_postings.constEnd()) {
+            return QVector<int>();
+        }
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<int>* left, const QVector<int>* right) {
+        return left->size() < right->size();
+    });
+    
+    QVector<int> result = *lists.first();
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i) {
+        QVector<int> intersection;
+        std::set_intersection(result.constBegin(), result.constEnd(),
+                              lists.at(i)->constBegin(), lists.at(i)->constEnd(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+    return result;
+}
+
+int SearchIndex::launchBonus(const QString& id, qint64 now) const
+{
+    if (!m_launchTracker) {
+        return 0;
+    }
+    
+    // 按当前衰减得分的对数加分，上限相当于两个单词开头匹配，
+    // 常用软件靠前但不会压过明显更好的匹配
+    const double score = m_launchTracker->score(id, now);
+    return qMin(32, qRound(8.0 * std::log2(1.0 + score)));
+}
+
+QString SearchIndex::normalizedText(const SoftwareItem& item)
+{
+    // 路径只取文件名，避免公共目录名（如applications）匹配所有软件；
+    // 字段之间用换行分隔，关键字不会跨字段匹配
+    QString fileName = QFileInfo(item.getFilePath()).completeBaseName();
+    return QString("%1\n%2\n%3").arg(item.getName(), item.getDescription(), fileName).toLower();
+}
+
+quint64 SearchIndex::trigramAt(const QString& text, int position)
+{
+    return (quint64(text.at(position).unicode()) << 32) |
+           (quint64(text.at(position + 1).unicode()) << 16) |
+           quint64(text.at(position + 2).unicode());
+}
@@ -0,0 +1,71 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QObject>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QStringList>
+#include "../model/SoftwareItem.hpp"
+
+class LaunchTracker;
+
+// 常驻内存的搜索索引：对名称、描述和文件名建立三元组倒排表，
+// 目录变化时增量更新，搜索时无需访问数据库
+class SearchIndex : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SearchIndex(QObject* parent = nullptr);
+    
+    // 索引维护
+    void setSoftwareItems(const QList<SoftwareItem>& items);
+    void addSoftwareItem(const SoftwareItem& item);
+    void updateSoftwareItem(const SoftwareItem& item);
+    void removeSoftwareItem(const QString& id);
+    void removeSoftwareItemsByFilePaths(const QStringList& filePaths);
+    void clear();
+    int size() const;
+    
+    // 设置后常用的软件在搜索结果中排名靠前
+    void setLaunchTracker(const LaunchTracker* launchTracker);
+    
+    // 按空白分隔的每个关键字都必须出现（不区分大小写），名称匹配的结果排在前面；
+    // limit小于0时返回全部结果
+    QList<SoftwareItem> search(const QString& keyword, int limit = -1) const;
+    
+    // 启动器风格的模糊搜索：每个关键字的字符按顺序出现在名称中即可，如"vsc"匹配Visual Studio Code；
+    // 结果按FuzzyMatcher的得分从高到低排列
+    QList<SoftwareItem> fuzzySearch(const QString& keyword, int limit = -1) const;
+    
+private:
+    struct Document {
+        SoftwareItem item;
+        QString name;   // 小写的名称，用于排序
+        QString text;   // 小写的名称、描述和文件名
+        bool alive;
+    };
+    
+    QVector<Document> m_documents;
+    QHash<QString, int> m_documentById;
+    QHash<QString, int> m_documentByFilePath;
+    
+    // 与m_documents一一对应的名称字符位图，连续存放便于快速预筛选；已删除的文档为0
+    QVector<quint64> m_nameMasks;
+    
+    // 三元组 -> 按升序排列的文档编号
+    QHash<quint64, QVector<int>> m_postings;
+    int m_removedCount;
+    const LaunchTracker* m_launchTracker;
+    
+    void indexDocument(const SoftwareItem& item);
+    void removeDocument(int document);
+    void compactIfNeeded();
+    QVector<int> candidatesFor(const QString& term) const;
+    int launchBonus(const QString& id, qint64 now) const;
+    
+    static QString normalizedText(const SoftwareItem& item);
+    static quint64 trigramAt(const QString& text, int position);
+};
+
+#endif // SEARCHINDEX_H
@@ -10,6 +10,7 @@ SettingsManager::SettingsManager(QObject* parent)
     , m_windowPosition(100, 100)
     , m_windowMaximized(false)
     , m_autoScanEnabled(true)
+    , m_watchEnabled(true)
     , m_viewMode("grid")
     , m_iconSize(64)
     , m_defaultCategory("未分类")
@@ -69,6 +70,16 @@ bool SettingsManager::autoScanEnabled() const
     return m_autoScanEnabled;
 }
 
+void SettingsManager::setWatchEnabled(bool enabled)
+{
+    m_watchEnabled = enabled;
+}
+
+bool SettingsManager::watchEnabled() const
+{
+    return m_watchEnabled;
+}
+
 void SettingsManager::setViewMode(const QString& mode)
 {
     m_viewMode = mode;
@@ -146,6 +157,7 @@ void SettingsManager::saveSettings()
     // 保存扫描设置
     settings.setValue("Scan/Paths", m_scanPaths);
     settings.setValue("Scan/AutoScan", m_autoScanEnabled);
+    settings.setValue("Scan/WatchEnabled", m_watchEnabled);
     
     // 保存视图设置
     settings.setValue("View/Mode", m_viewMode);
@@ -180,6 +192,7 @@ void SettingsManager::loadSettings()
     // 加载扫描设置
     m_scanPaths = settings.value("Scan/Paths", m_scanPaths).toStringList();
     m_autoScanEnabled = settings.value("Scan/AutoScan", m_autoScanEnabled).toBool();
+    m_watchEnabled = settings.value("Scan/WatchEnabled", m_watchEnabled).toBool();
     
     // 加载视图设置
     m_viewMode = settings.value("View/Mode", m_viewMode).toString();
@@ -30,6 +30,9 @@ public:
     void setAutoScanEnabled(bool enabled);
     bool autoScanEnabled() const;
     
+    void setWatchEnabled(bool enabled);
+    bool watchEnabled() const;
+    
     // 视图设置
     void setViewMode(const QString& mode);  // "grid" 或 "list"
     QString viewMode() const;
@@ -66,6 +69,7 @@ private:
     // 扫描设置
     QStringList m_scanPaths;
     bool m_autoScanEnabled;
+    bool m_watchEnabled;
     
     // 视图设置
     QString m_viewMode;
@@ -1,26 +1,126 @@
 #include "SoftwareScanner.hpp"
+#include "WorkStealingPool.hpp"
+#include "SoftwareWatcher.hpp"
 #include "model/SoftwareItem.hpp"
 #include <QDir>
+#include <QDirIterator>
 #include <QStandardPaths>
+#include <QFile>
 #include <QFileInfo>
 #include <QLoggingCategory>
 #include <QApplication>
 #include <QFileIconProvider>
 #include <QMimeDatabase>
 #include <QMimeType>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QDateTime>
+#include <algorithm>
+#include <vector>
 #include "../utils/Logging.hpp"
 
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace {
+// 快照生成前这段时间内修改过的目录不可信（文件系统时间精度有限，可能在同一时间单位内再次变化）
+const qint64 kRacyWindowMs = 2000;
+
+quint64 directoryInode(const QString& path)
+{
+#ifdef Q_OS_UNIX
+    struct stat st;
+    if (::stat(QFile::encodeName(path).constData(), &st) == 0) {
+        return static_cast<quint64>(st.st_ino);
+    }
+#else
+    Q_UNUSED(path)
+#endif
+    return 0;
+}
+
+bool lessByFilePath(const SoftwareItem& a, const SoftwareItem& b)
+{
+    return a.getFilePath() < b.getFilePath();
+}
+
+bool isSameOrSubPath(const QString& path, const QString& directory)
+{
+    const QString prefix = directory.endsWith('/') ? directory : directory + '/';
+    return path == directory || path.startsWith(prefix);
+}
+
+QString normalizedPath(const QString& path)
+{
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+// 与scanDirectory使用相同的过滤条件统计目录项，只读取目录，不逐个检查文件
+int directoryEntryCount(const QString& path)
+{
+    int count = 0;
+    QDirIterator it(path, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        it.next();
+        ++count;
+    }
+    return count;
+}
+}
+
+// 一次并行扫描的共享状态
+struct ScanWorker::ScanState {
+    explicit ScanState(int rootCount)
+        : totalRoots(rootCount)
+        , finishedRoots(0)
+        , startedAt(QDateTime::currentMSecsSinceEpoch())
+        , addedItems(rootCount)
+        , modifiedItems(rootCount)
+        , pendingTasks(rootCount)
+    {
+    }
+    
+    QStringList roots;
+    int totalRoots;
+    int finishedRoots;                           // 受progressMutex保护
+    qint64 startedAt;
+    
+    // 以下结果受resultMutex保护，软件项按扫描根分组
+    QList<QList<SoftwareItem>> addedItems;
+    QList<QList<SoftwareItem>> modifiedItems;
+    QStringList removedFilePaths;
+    QList<DirectorySnapshot> changedSnapshots;
+    QSet<QString> visitedDirectories;
+    QStringList vanishedDirectories;             // 重新枚举时发现已消失的子目录
+    
+    std::vector<std::atomic<int>> pendingTasks;  // 每个扫描根下未完成的目录任务数
+    QMutex resultMutex;
+    QMutex progressMutex;
+};
+
 SoftwareScanner::SoftwareScanner(QObject* parent)
     : QObject(parent)
     , m_isScanning(false)
+    , m_isWatchScan(false)
+    , m_fullScanPending(false)
     , m_workerThread(nullptr)
     , m_worker(nullptr)
+    , m_watcher(new SoftwareWatcher(this))
 {
     setupDefaultPaths();
+    
+    connect(m_watcher, &SoftwareWatcher::directoriesChanged,
+            this, &SoftwareScanner::scanDirectories);
 }
 
 SoftwareScanner::~SoftwareScanner()
 {
+    if (m_worker) {
+        m_worker->cancel();
+    }
+    
     if (m_workerThread) {
         m_workerThread->quit();
         m_workerThread->wait();
@@ -31,35 +131,90 @@ SoftwareScanner::~SoftwareScanner()
 void SoftwareScanner::scanSystemSoftware()
 {
     if (m_isScanning) {
+        if (m_isWatchScan) {
+            // 监视触发的局部扫描结束后再执行完整扫描，开始时才发出scanStarted
+            m_fullScanPending = true;
+            return;
+        }
         qCWarning(softwareManager) << "扫描已在进行中";
         return;
     }
     
-    m_isScanning = true;
+    // 完整扫描会覆盖所有等待中的目录变化
+    m_fullScanPending = false;
+    m_pendingDirectories.clear();
+    
     emit scanStarted();
+    startWorker(m_scanPaths, false);
+    
+    qCInfo(softwareManager) << "开始扫描系统软件，路径数量:" << m_scanPaths.size();
+}
+
+void SoftwareScanner::scanDirectories(const QStringList& directories)
+{
+    for (const QString& directory : directories) {
+        const QString path = normalizedPath(directory);
+        if (!m_pendingDirectories.contains(path)) {
+            m_pendingDirectories.append(path);
+        }
+    }
+    
+    // 正在扫描时先记下，扫描结束后再处理
+    if (m_isScanning || m_pendingDirectories.isEmpty()) {
+        return;
+    }
+    
+    const QStringList paths = m_pendingDirectories;
+    m_pendingDirectories.clear();
+    startWorker(paths, true);
+    
+    qCInfo(softwareManager) << "重新扫描变化的目录，数量:" << paths.size();
+}
+
+void SoftwareScanner::startWorker(const QStringList& paths, bool watchScan)
+{
+    m_isScanning = true;
+    m_isWatchScan = watchScan;
     
     // 创建工作线程
     m_workerThread = new QThread(this);
-    m_worker = new ScanWorker(m_scanPaths);
+    m_worker = new ScanWorker(paths, m_snapshots,
+                              watchScan ? ScanWorker::ChangedDirectoriesScan : ScanWorker::FullScan);
     
     // 移动到工作线程
     m_worker->moveToThread(m_workerThread);
     
-    // 连接信号槽
+    // 连接信号槽（监视触发的扫描在后台静默进行，不报告进度）
     connect(m_workerThread, &QThread::started, m_worker, &ScanWorker::process);
-    connect(m_worker, &ScanWorker::progress, this, &SoftwareScanner::scanProgress);
-    connect(m_worker, &ScanWorker::finished, this, &SoftwareScanner::scanFinished);
-    connect(m_worker, &ScanWorker::cancelled, this, &SoftwareScanner::scanCancelled);
+    if (!watchScan) {
+        connect(m_worker, &ScanWorker::progress, this, &SoftwareScanner::scanProgress);
+        connect(m_worker, &ScanWorker::cancelled, this, &SoftwareScanner::scanCancelled);
+    }
+    connect(m_worker, &ScanWorker::finished, this, &SoftwareScanner::onWorkerFinished);
     connect(m_worker, &ScanWorker::error, this, &SoftwareScanner::scanError);
     connect(m_worker, &ScanWorker::finished, m_workerThread, &QThread::quit);
     connect(m_worker, &ScanWorker::cancelled, m_workerThread, &QThread::quit);
     connect(m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
     connect(m_workerThread, &QThread::finished, m_workerThread, &QObject::deleteLater);
+    connect(m_workerThread, &QThread::finished, this, &SoftwareScanner::onWorkerThreadFinished);
     
     // 启动线程
     m_workerThread->start();
+}
+
+void SoftwareScanner::onWorkerThreadFinished()
+{
+    m_isScanning = false;
+    m_isWatchScan = false;
+    m_workerThread = nullptr;
+    m_worker = nullptr;
     
-    qCInfo(softwareManager) << "开始扫描系统软件，路径数量:" << m_scanPaths.size();
+    // 处理扫描期间积累的请求
+    if (m_fullScanPending) {
+        scanSystemSoftware();
+    } else if (!m_pendingDirectories.isEmpty()) {
+        scanDirectories(QStringList());
+    }
 }
 
 void SoftwareScanner::cancelScan()
@@ -78,6 +233,7 @@ void SoftwareScanner::addCustomPath(const QString& path)
 {
     if (!m_scanPaths.contains(path)) {
         m_scanPaths.append(path);
+        updateWatchedDirectories();
         qCInfo(softwareManager) << "添加自定义扫描路径:" << path;
     }
 }
@@ -85,6 +241,7 @@ void SoftwareScanner::addCustomPath(const QString& path)
 void SoftwareScanner::removeCustomPath(const QString& path)
 {
     m_scanPaths.removeAll(path);
+    updateWatchedDirectories();
     qCInfo(softwareManager) << "移除自定义扫描路径:" << path;
 }
 
@@ -96,14 +253,84 @@ QStringList SoftwareScanner::getScanPaths() const
 void SoftwareScanner::setScanPaths(const QStringList& paths)
 {
     m_scanPaths = paths;
+    updateWatchedDirectories();
     qCInfo(softwareManager) << "设置扫描路径，共" << paths.size() << "个路径";
 }
 
+void SoftwareScanner::setDirectorySnapshots(const QList<DirectorySnapshot>& snapshots)
+{
+    m_snapshots.clear();
+    for (const DirectorySnapshot& snapshot : snapshots) {
+        m_snapshots.insert(snapshot.path, snapshot);
+    }
+    updateWatchedDirectories();
+    qCInfo(softwareManager) << "设置目录快照，共" << snapshots.size() << "个目录";
+}
+
+QList<DirectorySnapshot> SoftwareScanner::directorySnapshots() const
+{
+    return m_snapshots.values();
+}
+
+void SoftwareScanner::clearDirectorySnapshots()
+{
+    m_snapshots.clear();
+    updateWatchedDirectories();
+    qCInfo(softwareManager) << "清除目录快照，下次将完整扫描";
+}
+
+void SoftwareScanner::setWatchingEnabled(bool enabled)
+{
+    updateWatchedDirectories();
+    m_watcher->setEnabled(enabled);
+}
+
+bool SoftwareScanner::isWatchingEnabled() const
+{
+    return m_watcher->isEnabled();
+}
+
 SoftwareItem SoftwareScanner::createSoftwareItem(const QString& filePath)
 {
     return SoftwareItem(filePath);
 }
 
+void SoftwareScanner::onWorkerFinished(const ScanDelta& delta)
+{
+    // 更新内存中的快照，供下次增量扫描使用
+    for (const DirectorySnapshot& snapshot : delta.changedSnapshots) {
+        m_snapshots.insert(snapshot.path, snapshot);
+    }
+    for (const QString& path : delta.removedDirectories) {
+        m_snapshots.remove(path);
+    }
+    updateWatchedDirectories();
+    
+    emit scanDelta(delta);
+    
+    const QList<SoftwareItem> items = delta.addedItems + delta.modifiedItems;
+    if (!m_isWatchScan) {
+        emit scanFinished(items);
+    } else if (!items.isEmpty() || !delta.removedFilePaths.isEmpty()) {
+        emit softwareChanged(items);
+    }
+}
+
+void SoftwareScanner::updateWatchedDirectories()
+{
+    // 监视扫描根以及快照中的全部目录，新目录在扫描生成快照后加入
+    QStringList directories;
+    for (const QString& path : std::as_const(m_scanPaths)) {
+        QFileInfo rootInfo(path);
+        if (rootInfo.isDir()) {
+            directories << QDir::cleanPath(rootInfo.absoluteFilePath());
+        }
+    }
+    directories << m_snapshots.keys();
+    
+    m_watcher->setWatchedDirectories(directories);
+}
+
 void SoftwareScanner::setupDefaultPaths()
 {
 #ifdef Q_OS_WIN
@@ -174,35 +401,105 @@ bool SoftwareScanner::isValidExecutablePath(const QString& path) const
 }
 
 // ScanWorker实现
-ScanWorker::ScanWorker(const QStringList& paths, QObject* parent)
+ScanWorker::ScanWorker(const QStringList& paths, const QHash<QString, DirectorySnapshot>& snapshots,
+                       ScanMode mode, QObject* parent)
     : QObject(parent)
     , m_paths(paths)
+    , m_snapshots(snapshots)
+    , m_mode(mode)
     , m_cancelled(false)
 {
 }
 
 void ScanWorker::process()
 {
-    QList<SoftwareItem> items;
+    // 统一扫描根的路径格式，与快照中记录的路径保持一致
+    QStringList roots;
+    QList<bool> rootAvailable;
+    if (m_mode == ChangedDirectoriesScan) {
+        roots = changedDirectoryRoots();
+    } else {
+        for (const QString& path : m_paths) {
+            roots << normalizedPath(path);
+        }
+    }
+    for (const QString& root : roots) {
+        rootAvailable << QFileInfo(root).isDir();
+    }
     
-    int totalPaths = m_paths.size();
-    int processedPaths = 0;
+    const int totalPaths = roots.size();
+    if (totalPaths == 0) {
+        emit finished(ScanDelta());
+        return;
+    }
     
-    for (const QString& path : m_paths) {
-        if (m_cancelled) {
-            emit cancelled();
-            return;
-        }
+    // 按CPU核心数创建工作窃取线程池，各扫描根的子树并行遍历
+    WorkStealingPool pool;
+    ScanState state(totalPaths);
+    state.roots = roots;
+    
+    for (int i = 0; i < totalPaths; ++i) {
+        state.pendingTasks[i] = 1;
+        const QString root = roots.at(i);
+        pool.submit([this, &pool, &state, i, root]() {
+            scanDirectoryTask(pool, state, i, root);
+        });
+    }
+    
+    pool.waitForDone();
+    
+    if (m_cancelled) {
+        emit cancelled();
+        return;
+    }
+    
+    // 按扫描根顺序合并结果，根内按路径排序，保证结果与线程调度无关
+    ScanDelta delta;
+    for (int i = 0; i < totalPaths; ++i) {
+        std::sort(state.addedItems[i].begin(), state.addedItems[i].end(), lessByFilePath);
+        std::sort(state.modifiedItems[i].begin(), state.modifiedItems[i].end(), lessByFilePath);
+        delta.addedItems.append(state.addedItems[i]);
+        delta.modifiedItems.append(state.modifiedItems[i]);
+    }
+    
+    // 完整扫描：上次存在但本次没有访问到的目录已被删除，其中的软件一并移除，
+    // 不可访问的扫描根（例如未挂载的网络共享）保留原有记录
+    // 变化目录扫描：只有重新枚举时消失的子目录及其下的目录被删除
+    delta.removedFilePaths = state.removedFilePaths;
+    for (auto it = m_snapshots.constBegin(); it != m_snapshots.constEnd(); ++it) {
+        const QString& dirPath = it.key();
+        bool removed = false;
         
-        QList<SoftwareItem> pathItems = scanDirectory(path);
-        items.append(pathItems);
+        if (m_mode == ChangedDirectoriesScan) {
+            for (const QString& vanished : std::as_const(state.vanishedDirectories)) {
+                if (isSameOrSubPath(dirPath, vanished)) {
+                    removed = true;
+                    break;
+                }
+            }
+        } else if (!state.visitedDirectories.contains(dirPath)) {
+            for (int i = 0; i < totalPaths; ++i) {
+                if (rootAvailable.at(i) && isSameOrSubPath(dirPath, roots.at(i))) {
+                    removed = true;
+                    break;
+                }
+            }
+        }
         
-        processedPaths++;
-        int progressValue = (processedPaths * 100) / totalPaths;
-        emit progress(progressValue);
+        if (removed) {
+            delta.removedDirectories << dirPath;
+            delta.removedFilePaths << it->files;
+        }
     }
+    delta.removedFilePaths.sort();
+    delta.changedSnapshots = state.changedSnapshots;
     
-    emit finished(items);
+    qCInfo(softwareManager) << "扫描完成，线程数:" << pool.threadCount()
+                            << "，重新枚举" << delta.changedSnapshots.size() << "个目录"
+                            << "，新增" << delta.addedItems.size()
+                            << "，更新" << delta.modifiedItems.size()
+                            << "，移除" << delta.removedFilePaths.size();
+    emit finished(delta);
 }
 
 void ScanWorker::cancel()
@@ -210,55 +507,204 @@ void ScanWorker::cancel()
     m_cancelled = true;
 }
 
-QList<SoftwareItem> ScanWorker::scanDirectory(const QString& path)
+void ScanWorker::scanDirectoryTask(WorkStealingPool& pool, ScanState& state, int rootIndex, const QString& path)
+{
+    if (!m_cancelled) {
+        QFileInfo dirInfo(path);
+        const quint64 inode = directoryInode(path);
+        const auto previous = m_snapshots.constFind(path);
+        const bool hasPrevious = previous != m_snapshots.constEnd();
+        // 监视到变化的目录总是重新枚举（文件内容变化不一定改变目录的修改时间）
+        const bool forceRescan = m_mode == ChangedDirectoriesScan && path == state.roots.at(rootIndex);
+        QStringList subDirectories;
+        
+        if (hasPrevious && !forceRescan && isSnapshotUnchanged(*previous, dirInfo, inode)) {
+            // 目录未变化：不重新枚举，只继续检查已知的子目录
+            subDirectories = previous->subDirectories;
+            
+            QMutexLocker locker(&state.resultMutex);
+            state.visitedDirectories.insert(path);
+        } else if (dirInfo.isDir()) {
+            DirectorySnapshot snapshot;
+            snapshot.path = path;
+            snapshot.modifiedTime = dirInfo.lastModified().toMSecsSinceEpoch();
+            snapshot.inode = inode;
+            snapshot.scannedAt = state.startedAt;
+            
+            QFileInfoList files = scanDirectory(path, &snapshot);
+            subDirectories = snapshot.subDirectories;
+            
+            // 变化目录扫描不再深入已有快照的子目录，它们的变化会单独通知
+            if (m_mode == ChangedDirectoriesScan) {
+                subDirectories.erase(std::remove_if(subDirectories.begin(), subDirectories.end(),
+                                                    [this](const QString& subDirectory) {
+                                                        return m_snapshots.contains(subDirectory);
+                                                    }),
+                                     subDirectories.end());
+            }
+            
+            QStringList vanishedDirectories;
+            if (hasPrevious) {
+                const QSet<QString> currentSubDirectories(snapshot.subDirectories.begin(),
+                                                          snapshot.subDirectories.end());
+                for (const QString& subDirectory : previous->subDirectories) {
+                    if (!currentSubDirectories.contains(subDirectory)) {
+                        vanishedDirectories << subDirectory;
+                    }
+                }
+            }
+            
+            // 与上次快照比较，只为新增或修改过的文件创建软件项
+            QSet<QString> previousFiles;
+            if (hasPrevious) {
+                previousFiles = QSet<QString>(previous->files.begin(), previous->files.end());
+            }
+            
+            QList<SoftwareItem> addedItems;
+            QList<SoftwareItem> modifiedItems;
+            QStringList invalidatedFiles;
+            for (const QFileInfo& fileInfo : files) {
+                const bool known = previousFiles.remove(fileInfo.absoluteFilePath());
+                if (known && fileInfo.lastModified().toMSecsSinceEpoch() < previous->scannedAt - kRacyWindowMs) {
+                    continue;
+                }
+                
+                SoftwareItem item(fileInfo.absoluteFilePath());
+                if (item.isValid()) {
+                    if (known) {
+                        modifiedItems.append(item);
+                    } else {
+                        addedItems.append(item);
+                    }
+                } else if (known) {
+                    // 已收录的文件不再有效（例如.desktop文件设置了NoDisplay或Hidden），移除其软件项
+                    invalidatedFiles.append(fileInfo.absoluteFilePath());
+                }
+            }
+            
+            QMutexLocker locker(&state.resultMutex);
+            state.visitedDirectories.insert(path);
+            state.changedSnapshots.append(snapshot);
+            state.addedItems[rootIndex].append(addedItems);
+            state.modifiedItems[rootIndex].append(modifiedItems);
+            state.vanishedDirectories.append(vanishedDirectories);
+            state.removedFilePaths.append(invalidatedFiles);
+            // 上次存在、本次不存在的文件已被删除
+            for (const QString& filePath : std::as_const(previousFiles)) {
+                state.removedFilePaths.append(filePath);
+            }
+        } else if (m_mode == ChangedDirectoriesScan) {
+            // 监视的目录本身被删除
+            QMutexLocker locker(&state.resultMutex);
+            state.vanishedDirectories.append(path);
+        } else {
+            qCWarning(softwareManager) << "扫描路径不存在:" << path;
+        }
+        
+        // 子目录作为新任务提交，空闲线程可以窃取
+        for (const QString& subDirectory : subDirectories) {
+            state.pendingTasks[rootIndex].fetch_add(1);
+            pool.submit([this, &pool, &state, rootIndex, subDirectory]() {
+                scanDirectoryTask(pool, state, rootIndex, subDirectory);
+            });
+        }
+    }
+    
+    // 该扫描根下的全部子树已完成，更新进度
+    if (state.pendingTasks[rootIndex].fetch_sub(1) == 1) {
+        QMutexLocker locker(&state.progressMutex);
+        state.finishedRoots++;
+        emit progress((state.finishedRoots * 100) / state.totalRoots);
+    }
+}
+
+QStringList ScanWorker::changedDirectoryRoots() const
 {
-    QList<SoftwareItem> items;
+    QStringList directories;
+    for (const QString& path : m_paths) {
+        const QString directory = normalizedPath(path);
+        if (!directories.contains(directory)) {
+            directories << directory;
+        }
+    }
     
-    QDir dir(path);
-    if (!dir.exists()) {
-        qCWarning(softwareManager) << "扫描路径不存在:" << path;
-        return items;
+    // 没有快照的新目录会在父目录重新枚举时一并扫描，不再单独作为扫描根
+    QStringList roots;
+    for (const QString& directory : std::as_const(directories)) {
+        const QString parent = QFileInfo(directory).path();
+        if (m_snapshots.contains(directory) || !directories.contains(parent)) {
+            roots << directory;
+        }
     }
+    return roots;
+}
+
+QFileInfoList ScanWorker::scanDirectory(const QString& path, DirectorySnapshot* snapshot)
+{
+    QFileInfoList candidates;
+    
+    QDir dir(path);
     
     // 获取目录中的所有文件
     QFileInfoList fileInfos = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    snapshot->entryCount = fileInfos.size();
     
     for (const QFileInfo& fileInfo : fileInfos) {
         if (m_cancelled) {
-            return items;
+            return candidates;
         }
         
-        QString filePath = fileInfo.absoluteFilePath();
-        
-        // 如果是目录，递归扫描
+        // 如果是目录，交给调用者作为子任务扫描（不跟随目录符号链接，避免循环）
         if (fileInfo.isDir()) {
-            QList<SoftwareItem> subItems = scanDirectory(filePath);
-            items.append(subItems);
+            if (!fileInfo.isSymLink()) {
+                snapshot->subDirectories.append(fileInfo.absoluteFilePath());
+            }
         }
         // 如果是有效的可执行文件或快捷方式
-        else if (fileInfo.isFile()) {
-            // 检查是否为有效的可执行文件路径
-            // 这里简化处理，实际应该根据文件扩展名和系统类型判断
-            if (filePath.endsWith(".exe", Qt::CaseInsensitive) || 
-                filePath.endsWith(".lnk", Qt::CaseInsensitive) ||
-                filePath.endsWith(".app", Qt::CaseInsensitive) ||
-                (fileInfo.isExecutable() && !filePath.endsWith(".desktop"))) {
-                
-                SoftwareItem item(filePath);
-                if (item.isValid()) {
-                    items.append(item);
-                }
-            }
+        else if (fileInfo.isFile() && isCandidateFile(fileInfo)) {
+            snapshot->files.append(fileInfo.absoluteFilePath());
+            candidates.append(fileInfo);
         }
     }
     
-    return items;
+    return candidates;
+}
+
+bool ScanWorker::isSnapshotUnchanged(const DirectorySnapshot& previous, const QFileInfo& dirInfo, quint64 inode) const
+{
+    if (!dirInfo.isDir()) {
+        return false;
+    }
+    
+    // 目录的修改时间只在增删、重命名目录项时变化
+    const qint64 modifiedTime = dirInfo.lastModified().toMSecsSinceEpoch();
+    if (previous.modifiedTime != modifiedTime || previous.inode != inode ||
+        modifiedTime >= previous.scannedAt - kRacyWindowMs) {
+        return false;
+    }
+    
+    // 修改时间精度较粗的文件系统（如FAT的2秒）可能漏掉增删，再核对目录项数量。
+    // 注意：判定为未变化的目录跳过逐个文件的检查，就地修改的文件（如更新.desktop的内容）
+    // 只能由目录监视发现；关闭Scan/WatchEnabled时，完整扫描也不会发现这类修改
+    return directoryEntryCount(dirInfo.absoluteFilePath()) == previous.entryCount;
+}
+
+bool ScanWorker::isCandidateFile(const QFileInfo& fileInfo) const
+{
+    // 检查是否为有效的可执行文件路径
+    // 这里简化处理，实际应该根据文件扩展名和系统类型判断
+    const QString filePath = fileInfo.absoluteFilePath();
+    return filePath.endsWith(".exe", Qt::CaseInsensitive) || 
+           filePath.endsWith(".lnk", Qt::CaseInsensitive) ||
+           filePath.endsWith(".app", Qt::CaseInsensitive) ||
+           filePath.endsWith(".desktop") ||
+           fileInfo.isExecutable();
 }
 
 SoftwareItem ScanWorker::parseShortcutFile(const QString& filePath)
 {
-    // 这里应该解析快捷方式文件(.lnk, .desktop等)获取目标路径
-    // 简化处理，直接返回基于文件路径的软件项
+    // .desktop文件由SoftwareItem解析名称、分类和图标
+    // .lnk等快捷方式尚未解析目标路径，直接返回基于文件路径的软件项
     return SoftwareItem(filePath);
 }
 
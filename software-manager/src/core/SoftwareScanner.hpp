@@ -5,11 +5,28 @@
 #include <QThread>
 #include <QStringList>
 #include <QList>
+#include <QHash>
 #include <QIcon>
+#include <QFileInfo>
+#include <atomic>
 #include "../model/SoftwareItem.hpp"
+#include "../model/DirectorySnapshot.hpp"
 
 // 前向声明
 class ScanWorker;
+class WorkStealingPool;
+class SoftwareWatcher;
+
+// 一次扫描相对上次快照的变化
+struct ScanDelta {
+    QList<SoftwareItem> addedItems;
+    QList<SoftwareItem> modifiedItems;
+    QStringList removedFilePaths;
+    
+    // 需要持久化的快照变化
+    QList<DirectorySnapshot> changedSnapshots;
+    QStringList removedDirectories;
+};
 
 class SoftwareScanner : public QObject {
     Q_OBJECT
@@ -29,6 +46,16 @@ public:
     QStringList getScanPaths() const;
     void setScanPaths(const QStringList& paths);
     
+    // 增量扫描快照：已有快照的未变化目录不会重新枚举
+    void setDirectorySnapshots(const QList<DirectorySnapshot>& snapshots);
+    QList<DirectorySnapshot> directorySnapshots() const;
+    void clearDirectorySnapshots();
+    
+    // 实时监视：扫描目录变化时只重新扫描变化的目录
+    void setWatchingEnabled(bool enabled);
+    bool isWatchingEnabled() const;
+    void scanDirectories(const QStringList& directories);
+    
     // 手动添加
     SoftwareItem createSoftwareItem(const QString& filePath);
     
@@ -38,17 +65,28 @@ public:
 signals:
     void scanStarted();
     void scanProgress(int progress);
-    void scanFinished(const QList<SoftwareItem>& items);
+    void scanDelta(const ScanDelta& delta);
+    void scanFinished(const QList<SoftwareItem>& items);  // 新增和更新的软件项
     void scanCancelled();
     void scanError(const QString& error);
+    void softwareChanged(const QList<SoftwareItem>& items);  // 监视到变化后重新扫描的结果
     
 private:
     QStringList m_scanPaths;
     bool m_isScanning;
+    bool m_isWatchScan;
+    bool m_fullScanPending;
     QThread* m_workerThread;
     ScanWorker* m_worker;
+    QHash<QString, DirectorySnapshot> m_snapshots;
+    SoftwareWatcher* m_watcher;
+    QStringList m_pendingDirectories;
     
     // 私有方法
+    void startWorker(const QStringList& paths, bool watchScan);
+    void onWorkerFinished(const ScanDelta& delta);
+    void onWorkerThreadFinished();
+    void updateWatchedDirectories();
     void setupDefaultPaths();
     QStringList getDefaultScanPaths() const;
 };
@@ -58,7 +96,14 @@ class ScanWorker : public QObject {
     Q_OBJECT
 
 public:
-    explicit ScanWorker(const QStringList& paths, QObject* parent = nullptr);
+    // 完整扫描遍历整个目录树；变化目录扫描只重新枚举给定目录，已知子目录不再深入
+    enum ScanMode {
+        FullScan,
+        ChangedDirectoriesScan
+    };
+    
+    ScanWorker(const QStringList& paths, const QHash<QString, DirectorySnapshot>& snapshots,
+               ScanMode mode = FullScan, QObject* parent = nullptr);
     
 public slots:
     void process();
@@ -66,15 +111,24 @@ public slots:
     
 signals:
     void progress(int progress);
-    void finished(const QList<SoftwareItem>& items);
+    void finished(const ScanDelta& delta);
     void cancelled();
     void error(const QString& error);
     
 private:
+    struct ScanState;
+    
     QStringList m_paths;
-    bool m_cancelled;
+    QHash<QString, DirectorySnapshot> m_snapshots;
+    ScanMode m_mode;
+    std::atomic<bool> m_cancelled;
     
-    QList<SoftwareItem> scanDirectory(const QString& path);
+    // 并行扫描：每个目录作为一个任务，子目录派生为新任务
+    void scanDirectoryTask(WorkStealingPool& pool, ScanState& state, int rootIndex, const QString& path);
+    QStringList changedDirectoryRoots() const;
+    QFileInfoList scanDirectory(const QString& path, DirectorySnapshot* snapshot);
+    bool isSnapshotUnchanged(const DirectorySnapshot& previous, const QFileInfo& dirInfo, quint64 inode) const;
+    bool isCandidateFile(const QFileInfo& fileInfo) const;
     SoftwareItem parseShortcutFile(const QString& filePath);
     QIcon extractIcon(const QString& filePath);
 };
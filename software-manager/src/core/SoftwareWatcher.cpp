@@ -0,0 +1,152 @@
+#include "SoftwareWatcher.hpp"
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <algorithm>
+#include "../utils/Logging.hpp"
+
+namespace {
+// inotify等机制的监视数量有限，超出时优先保留层级较浅的目录
+const int kMaxWatchedDirectories = 4096;
+}
+
+SoftwareWatcher::SoftwareWatcher(QObject* parent)
+    : QObject(parent)
+    , m_watcher(new QFileSystemWatcher(this))
+    , m_coalesceTimer(new QTimer(this))
+    , m_enabled(false)
+    , m_maxLatency(3000)
+{
+    m_coalesceTimer->setSingleShot(true);
+    m_coalesceTimer->setInterval(500);
+    
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &SoftwareWatcher::onDirectoryChanged);
+    connect(m_coalesceTimer, &QTimer::timeout,
+            this, &SoftwareWatcher::flushPendingChanges);
+}
+
+void SoftwareWatcher::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    
+    m_enabled = enabled;
+    applyWatchedDirectories();
+    
+    if (!m_enabled) {
+        m_coalesceTimer->stop();
+        m_pendingDirectories.clear();
+    }
+    
+    qCInfo(softwareManager) << (enabled ? "启用" : "停用") << "目录监视";
+}
+
+bool SoftwareWatcher::isEnabled() const
+{
+    return m_enabled;
+}
+
+void SoftwareWatcher::setWatchedDirectories(const QStringList& directories)
+{
+    QStringList sorted = directories;
+    sorted.removeDuplicates();
+    
+    // 按目录层级排序，层级相同时保持原顺序
+    std::stable_sort(sorted.begin(), sorted.end(), [](const QString& a, const QString& b) {
+        return a.count('/') < b.count('/');
+    });
+    
+    if (sorted.size() > kMaxWatchedDirectories) {
+        qCWarning(softwareManager) << "监视目录过多，只监视前" << kMaxWatchedDirectories
+                                   << "个，共" << sorted.size() << "个";
+        sorted = sorted.mid(0, kMaxWatchedDirectories);
+    }
+    
+    m_directories = sorted;
+    applyWatchedDirectories();
+}
+
+QStringList SoftwareWatcher::watchedDirectories() const
+{
+    return m_watcher->directories();
+}
+
+void SoftwareWatcher::setCoalesceInterval(int msec)
+{
+    m_coalesceTimer->setInterval(msec);
+}
+
+void SoftwareWatcher::setMaxLatency(int msec)
+{
+    m_maxLatency = msec;
+}
+
+void SoftwareWatcher::onDirectoryChanged(const QString& path)
+{
+    if (!m_enabled) {
+        return;
+    }
+    
+    if (m_pendingDirectories.isEmpty()) {
+        m_pendingSince.start();
+    }
+    m_pendingDirectories.insert(path);
+    
+    // 持续有事件时也不能无限推迟，超过最长延迟立即提交
+    if (m_pendingSince.elapsed() >= m_maxLatency) {
+        flushPendingChanges();
+    } else {
+        m_coalesceTimer->start();
+    }
+}
+
+void SoftwareWatcher::flushPendingChanges()
+{
+    m_coalesceTimer->stop();
+    
+    if (m_pendingDirectories.isEmpty()) {
+        return;
+    }
+    
+    QStringList directories(m_pendingDirectories.begin(), m_pendingDirectories.end());
+    directories.sort();
+    m_pendingDirectories.clear();
+    
+    qCInfo(softwareManager) << "检测到" << directories.size() << "个目录发生变化";
+    emit directoriesChanged(directories);
+}
+
+void SoftwareWatcher::applyWatchedDirectories()
+{
+    const QStringList current = m_watcher->directories();
+    const QSet<QString> wanted = m_enabled ? QSet<QString>(m_directories.begin(), m_directories.end())
+                                           : QSet<QString>();
+    
+    // 只增删有差异的目录，避免重建监视时漏掉事件
+    QStringList removed;
+    for (const QString& path : current) {
+        if (!wanted.contains(path)) {
+            removed << path;
+        }
+    }
+    if (!removed.isEmpty()) {
+        m_watcher->removePaths(removed);
+    }
+    
+    const QSet<QString> watched(current.begin(), current.end());
+    QStringList added;
+    for (const QString& path : std::as_const(m_directories)) {
+        if (wanted.contains(path) && !watched.contains(path)) {
+            added << path;
+        }
+    }
+    if (added.isEmpty()) {
+        return;
+    }
+    
+    const QStringList failed = m_watcher->addPaths(added);
+    if (!failed.isEmpty()) {
+        qCWarning(softwareManager) << "无法监视" << failed.size() << "个目录";
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef SOFTWAREWATCHER_H
+#define SOFTWAREWATCHER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QSet>
+#include <QElapsedTimer>
+
+class QFileSystemWatcher;
+class QTimer;
+
+// 监视扫描目录的增删改事件（Linux下基于inotify），
+// 把短时间内的大量事件合并成一批变化的目录再通知
+class SoftwareWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SoftwareWatcher(QObject* parent = nullptr);
+
+    // 监视控制
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    // 设置需要监视的目录（替换原有集合）
+    void setWatchedDirectories(const QStringList& directories);
+    QStringList watchedDirectories() const;
+
+    // 合并窗口：最后一个事件后等待的时间，以及持续事件下的最长延迟
+    void setCoalesceInterval(int msec);
+    void setMaxLatency(int msec);
+
+signals:
+    void directoriesChanged(const QStringList& directories);
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+    void flushPendingChanges();
+
+private:
+    QFileSystemWatcher* m_watcher;
+    QTimer* m_coalesceTimer;
+    QElapsedTimer m_pendingSince;
+    QSet<QString> m_pendingDirectories;
+    QStringList m_directories;
+    bool m_enabled;
+    int m_maxLatency;
+
+    // 私有方法
+    void applyWatchedDirectories();
+};
+
+#endif // SOFTWAREWATCHER_H
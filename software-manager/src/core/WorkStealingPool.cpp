@@ -0,0 +1,138 @@
+#include "WorkStealingPool.hpp"
+#include <QMutexLocker>
+
+namespace {
+// 当前线程所属的线程池及其队列索引，用于把子任务放回本线程队列
+thread_local WorkStealingPool* t_currentPool = nullptr;
+thread_local int t_workerIndex = -1;
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : m_pendingTasks(0)
+    , m_queuedTasks(0)
+    , m_nextQueue(0)
+    , m_stopping(false)
+{
+    int count = qMax(1, threadCount);
+
+    for (int i = 0; i < count; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (int i = 0; i < count; ++i) {
+        QThread* thread = QThread::create([this, i]() { workerLoop(i); });
+        m_threads.append(thread);
+        thread->start();
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        QMutexLocker locker(&m_idleMutex);
+        m_stopping = true;
+        m_idleCondition.wakeAll();
+    }
+
+    for (QThread* thread : m_threads) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    int index;
+    if (t_currentPool == this) {
+        index = t_workerIndex;
+    } else {
+        index = static_cast<int>(m_nextQueue.fetch_add(1) % m_queues.size());
+    }
+
+    m_pendingTasks.fetch_add(1);
+    {
+        QMutexLocker locker(&m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_queuedTasks.fetch_add(1);
+
+    // 唤醒一个空闲线程（可能去窃取这个任务）
+    QMutexLocker locker(&m_idleMutex);
+    m_idleCondition.wakeOne();
+}
+
+void WorkStealingPool::waitForDone()
+{
+    QMutexLocker locker(&m_doneMutex);
+    while (m_pendingTasks.load() > 0) {
+        m_doneCondition.wait(&m_doneMutex);
+    }
+}
+
+int WorkStealingPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+    t_currentPool = this;
+    t_workerIndex = index;
+
+    Task task;
+    while (true) {
+        if (popLocal(index, task) || steal(index, task)) {
+            m_queuedTasks.fetch_sub(1);
+            task();
+            task = nullptr;
+
+            if (m_pendingTasks.fetch_sub(1) == 1) {
+                QMutexLocker locker(&m_doneMutex);
+                m_doneCondition.wakeAll();
+            }
+            continue;
+        }
+
+        // 没有可执行的任务，等待新任务或停止信号
+        QMutexLocker locker(&m_idleMutex);
+        if (m_stopping) {
+            break;
+        }
+        if (m_queuedTasks.load() == 0) {
+            m_idleCondition.wait(&m_idleMutex);
+        }
+    }
+
+    t_currentPool = nullptr;
+    t_workerIndex = -1;
+}
+
+bool WorkStealingPool::popLocal(int index, Task& task)
+{
+    WorkerQueue* queue = m_queues[index].get();
+    QMutexLocker locker(&queue->mutex);
+    if (queue->tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue->tasks.back());
+    queue->tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thiefIndex, Task& task)
+{
+    const int count = static_cast<int>(m_queues.size());
+
+    for (int offset = 1; offset < count; ++offset) {
+        WorkerQueue* queue = m_queues[(thiefIndex + offset) % count].get();
+        QMutexLocker locker(&queue->mutex);
+        if (!queue->tasks.empty()) {
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
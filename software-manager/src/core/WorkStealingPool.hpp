@@ -0,0 +1,60 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// 工作窃取线程池
+// 每个工作线程拥有独立的任务队列：自己从队尾取任务（深度优先），
+// 空闲时从其他线程的队头窃取任务（通常是更大的子树），使负载自动均衡
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(int threadCount = QThread::idealThreadCount());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 提交任务：在工作线程内提交时放入本线程队列，否则轮流分发到各队列
+    void submit(Task task);
+
+    // 阻塞等待所有任务（包括执行期间派生的子任务）完成
+    void waitForDone();
+
+    int threadCount() const;
+
+private:
+    struct WorkerQueue {
+        QMutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    QList<QThread*> m_threads;
+
+    std::atomic<int> m_pendingTasks;   // 已提交但尚未执行完成的任务数
+    std::atomic<int> m_queuedTasks;    // 仍在队列中等待执行的任务数
+    std::atomic<unsigned> m_nextQueue;
+    std::atomic<bool> m_stopping;
+
+    QMutex m_idleMutex;
+    QWaitCondition m_idleCondition;
+    QMutex m_doneMutex;
+    QWaitCondition m_doneCondition;
+
+    // 私有方法
+    void workerLoop(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int thiefIndex, Task& task);
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -1,6 +1,7 @@
 #include <QApplication>
 #include <QLoggingCategory>
 #include "utils/Logging.hpp"
+#include "utils/IconExtractor.hpp"
 #include "ui/MainWindow.hpp"
 
 int main(int argc, char *argv[])
@@ -16,6 +17,9 @@ int main(int argc, char *argv[])
     // 启用日志
     QLoggingCategory::setFilterRules("softwaremanager.debug=true");
     
+    // 启用持久化的图标缓存，与软件数据库放在同一目录
+    IconExtractor::instance()->enableDiskCache(IconDiskCache::defaultCachePath());
+    
     // 创建主窗口
     MainWindow window;
     window.show();
@@ -0,0 +1,18 @@
+#ifndef DIRECTORYSNAPSHOT_H
+#define DIRECTORYSNAPSHOT_H
+
+#include <QString>
+#include <QStringList>
+
+// 目录快照：记录上次扫描时目录的状态，用于增量扫描时跳过未变化的目录
+struct DirectorySnapshot {
+    QString path;
+    qint64 modifiedTime = 0;     // 目录修改时间（毫秒时间戳）
+    quint64 inode = 0;           // 目录inode（不支持的平台为0）
+    int entryCount = 0;          // 目录项数量
+    qint64 scannedAt = 0;        // 快照生成时间（毫秒时间戳）
+    QStringList subDirectories;  // 子目录完整路径
+    QStringList files;           // 目录中候选软件文件的完整路径
+};
+
+#endif // DIRECTORYSNAPSHOT_H
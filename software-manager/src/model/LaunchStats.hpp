@@ -0,0 +1,14 @@
+#ifndef LAUNCHSTATS_H
+#define LAUNCHSTATS_H
+
+#include <QString>
+
+// 软件的启动统计，用于按常用程度（frecency）排序
+struct LaunchStats {
+    QString softwareId;
+    int launchCount = 0;         // 累计启动次数
+    qint64 lastLaunched = 0;     // 最近一次启动时间（毫秒时间戳）
+    double frecency = 0.0;       // 与时间无关的对数衰减得分，越大越常用；未启动过为0
+};
+
+#endif // LAUNCHSTATS_H
@@ -4,11 +4,9 @@
 #include <QMimeType>
 #include <QDir>
 #include <QStandardPaths>
-#include <QApplication>
-#include <QStyle>
-#include <QPixmap>
-#include <QFileIconProvider>
 #include <QVariantMap>
+#include "../utils/DesktopEntryParser.hpp"
+#include "../utils/IconExtractor.hpp"
 #include "../utils/Logging.hpp"
 
 SoftwareItem::SoftwareItem()
@@ -40,17 +38,7 @@ SoftwareItem::SoftwareItem(const QString& id, const QString& name, const QString
     , m_createdAt(createdAt)
     , m_updatedAt(updatedAt)
 {
-    // 初始化图标
-    if (!m_filePath.isEmpty() && QFile::exists(m_filePath)) {
-        QFileInfo fileInfo(m_filePath);
-        QFileIconProvider iconProvider;
-        m_icon = iconProvider.icon(fileInfo);
-        
-        // 如果图标为空，使用默认图标
-        if (m_icon.isNull()) {
-            m_icon = QApplication::style()->standardIcon(QStyle::SP_FileIcon);
-        }
-    }
+    // 不访问文件系统，图标在首次显示时加载
 }
 
 QString SoftwareItem::getId() const
@@ -75,7 +63,26 @@ QString SoftwareItem::getCategory() const
 
 QIcon SoftwareItem::getIcon() const
 {
-    return m_icon;
+    if (!m_icon.isNull()) {
+        return m_icon;
+    }
+    
+    // 由共享的图标服务加载和缓存，相同来源的软件项共用一个图标
+    return IconExtractor::instance()->extractIcon(getIconKey());
+}
+
+QIcon SoftwareItem::getLoadedIcon() const
+{
+    if (!m_icon.isNull()) {
+        return m_icon;
+    }
+    
+    return IconExtractor::instance()->cachedIcon(getIconKey());
+}
+
+QString SoftwareItem::getIconKey() const
+{
+    return m_iconKey.isEmpty() ? m_filePath : m_iconKey;
 }
 
 QString SoftwareItem::getDescription() const
@@ -127,6 +134,11 @@ void SoftwareItem::setIcon(const QIcon& icon)
     m_icon = icon;
 }
 
+void SoftwareItem::setIconKey(const QString& iconKey)
+{
+    m_iconKey = iconKey;
+}
+
 bool SoftwareItem::isValid() const
 {
     return !m_id.isEmpty() && !m_name.isEmpty() && !m_filePath.isEmpty() && QFile::exists(m_filePath);
@@ -146,18 +158,37 @@ void SoftwareItem::initializeFromFilePath(const QString& filePath)
     
     QFileInfo fileInfo(filePath);
     
-    // 提取名称
+    // .desktop文件使用其中声明的名称、说明、分类和图标
+    if (fileInfo.suffix().toLower() == "desktop") {
+        initializeFromDesktopEntry(filePath);
+        return;
+    }
+    
+    // 提取名称（图标由文件路径在显示时加载）
     m_name = extractNameFromPath(filePath);
     
-    // 提取图标
-    QFileIconProvider iconProvider;
-    m_icon = iconProvider.icon(fileInfo);
+    qCInfo(softwareManager) << "成功初始化软件项:" << m_name << "路径:" << filePath;
+}
+
+void SoftwareItem::initializeFromDesktopEntry(const QString& filePath)
+{
+    // 解析器只读，可在扫描线程间共享
+    static const DesktopEntryParser parser;
+    const DesktopEntry entry = parser.parseFile(filePath);
     
-    // 如果图标为空，使用默认图标
-    if (m_icon.isNull()) {
-        m_icon = QApplication::style()->standardIcon(QStyle::SP_FileIcon);
+    // 隐藏或非应用程序的条目不作为软件项（名称为空，isValid()返回false）
+    if (!entry.isDisplayable()) {
+        qCDebug(softwareManager) << "跳过不显示的桌面项:" << filePath;
+        return;
     }
     
+    m_name = entry.name;
+    m_description = entry.comment.isEmpty() ? entry.genericName : entry.comment;
+    m_category = DesktopEntryParser::categoryFor(entry.categories);
+    
+    // Icon可以是绝对路径或图标主题中的名称，显示时再加载
+    m_iconKey = entry.icon;
+    
     qCInfo(softwareManager) << "成功初始化软件项:" << m_name << "路径:" << filePath;
 }
 
@@ -188,6 +219,7 @@ QVariantMap SoftwareItem::toVariantMap() const
     map["category"] = m_category;
     map["description"] = m_description;
     map["version"] = m_version;
+    map["iconKey"] = m_iconKey;
     map["createdAt"] = m_createdAt;
     map["updatedAt"] = m_updatedAt;
     return map;
@@ -205,5 +237,6 @@ SoftwareItem SoftwareItem::fromVariantMap(const QVariantMap& map)
         map["createdAt"].toDateTime(),
         map["updatedAt"].toDateTime()
     );
+    item.setIconKey(map["iconKey"].toString());
     return item;
 }
\ No newline at end of file
@@ -24,7 +24,9 @@ public:
     QString getName() const;
     QString getFilePath() const;
     QString getCategory() const;
-    QIcon getIcon() const;
+    QIcon getIcon() const;       // 通过IconExtractor按需加载，只能在GUI线程调用
+    QIcon getLoadedIcon() const; // 不触发加载，图标尚未加载时返回空图标
+    QString getIconKey() const;
     QString getDescription() const;
     QString getVersion() const;
     QDateTime getCreatedAt() const;
@@ -36,6 +38,7 @@ public:
     void setDescription(const QString& description);
     void setVersion(const QString& version);
     void setIcon(const QIcon& icon);
+    void setIconKey(const QString& iconKey);
     
     // 功能方法
     bool isValid() const;
@@ -50,7 +53,8 @@ private:
     QString m_name;
     QString m_filePath;
     QString m_category;
-    QIcon m_icon;
+    QString m_iconKey;           // 图标来源：主题图标名或文件路径，为空时使用m_filePath
+    QIcon m_icon;                // 显式设置的图标，优先于m_iconKey
     QString m_description;
     QString m_version;
     QDateTime m_createdAt;
@@ -58,6 +62,7 @@ private:
     
     // 私有辅助方法
     void initializeFromFilePath(const QString& filePath);
+    void initializeFromDesktopEntry(const QString& filePath);
     QString extractNameFromPath(const QString& filePath) const;
 };
 
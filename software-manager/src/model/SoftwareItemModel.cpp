@@ -0,0 +1,273 @@
+#include "SoftwareItemModel.hpp"
+#include <QApplication>
+#include <QStyle>
+#include <QSet>
+#include "../utils/IconExtractor.hpp"
+
+SoftwareItemModel::SoftwareItemModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_placeholderIcon(QApplication::style()->standardIcon(QStyle::SP_FileIcon))
+    , m_iconSize(64, 64)
+{
+    // 异步加载的图标到达后只刷新使用该图标的行
+    connect(IconExtractor::instance(), &IconExtractor::iconReady,
+            this, &SoftwareItemModel::onIconReady);
+}
+
+int SoftwareItemModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_softwareItems.size();
+}
+
+int SoftwareItemModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant SoftwareItemModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_softwareItems.size()) {
+        return QVariant();
+    }
+    
+    const SoftwareItem& item = m_softwareItems.at(index.row());
+    
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        switch (index.column()) {
+        case NameColumn:
+            return item.getName();
+        case CategoryColumn:
+            return item.getCategory();
+        case PathColumn:
+            return item.getFilePath();
+        case VersionColumn:
+            return item.getVersion();
+        case DescriptionColumn:
+            return item.getDescription();
+        default:
+            return QVariant();
+        }
+    case Qt::DecorationRole: {
+        if (index.column() != NameColumn) {
+            return QVariant();
+        }
+        
+        // 只有视图实际绘制的行才会走到这里，图标按需加载
+        QIcon icon = item.getLoadedIcon();
+        if (icon.isNull()) {
+            icon = IconExtractor::instance()->requestIcon(item.getIconKey(), m_iconSize);
+        }
+        return icon.isNull() ? m_placeholderIcon : icon;
+    }
+    case SoftwareIdRole:
+        return item.getId();
+    case FilePathRole:
+        return item.getFilePath();
+    case CategoryRole:
+        return item.getCategory();
+    default:
+        return QVariant();
+    }
+}
+
+QVariant SoftwareItemModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    
+    switch (section) {
+    case NameColumn:
+        return "名称";
+    case CategoryColumn:
+        return "分类";
+    case PathColumn:
+        return "路径";
+    case VersionColumn:
+        return "版本";
+    case DescriptionColumn:
+        return "描述";
+    default:
+        return QVariant();
+    }
+}
+
+void SoftwareItemModel::addSoftwareItem(const SoftwareItem& item)
+{
+    const int row = m_softwareItems.size();
+    
+    beginInsertRows(QModelIndex(), row, row);
+    m_softwareItems.append(item);
+    m_rowById.insert(item.getId(), row);
+    m_rowsByIconKey.insert(item.getIconKey(), row);
+    endInsertRows();
+}
+
+void SoftwareItemModel::removeSoftwareItem(const QString& id)
+{
+    const int row = rowForId(id);
+    if (row < 0) {
+        return;
+    }
+    
+    removeRowRanges(QList<QPair<int, int>>() << qMakePair(row, row));
+}
+
+void SoftwareItemModel::removeSoftwareItemsByFilePaths(const QStringList& filePaths)
+{
+    if (filePaths.isEmpty()) {
+        return;
+    }
+    
+    // 从后向前收集要移除的行，相邻的行合并为一段
+    const QSet<QString> paths(filePaths.begin(), filePaths.end());
+    QList<QPair<int, int>> ranges;
+    for (int row = m_softwareItems.size() - 1; row >= 0; --row) {
+        if (!paths.contains(m_softwareItems.at(row).getFilePath())) {
+            continue;
+        }
+        if (!ranges.isEmpty() && ranges.last().first == row + 1) {
+            ranges.last().first = row;
+        } else {
+            ranges.append(qMakePair(row, row));
+        }
+    }
+    
+    removeRowRanges(ranges);
+}
+
+void SoftwareItemModel::updateSoftwareItem(const SoftwareItem& item)
+{
+    const int row = rowForId(item.getId());
+    if (row < 0) {
+        return;
+    }
+    
+    const QString oldIconKey = m_softwareItems.at(row).getIconKey();
+    m_softwareItems[row] = item;
+    if (oldIconKey != item.getIconKey()) {
+        m_rowsByIconKey.remove(oldIconKey, row);
+        m_rowsByIconKey.insert(item.getIconKey(), row);
+    }
+    
+    emitRowChanged(row);
+}
+
+void SoftwareItemModel::clearAllItems()
+{
+    setSoftwareItems(QList<SoftwareItem>());
+}
+
+void SoftwareItemModel::setSoftwareItems(const QList<SoftwareItem>& items)
+{
+    beginResetModel();
+    m_softwareItems = items;
+    rebuildIndex();
+    endResetModel();
+}
+
+void SoftwareItemModel::appendSoftwareItems(const QList<SoftwareItem>& items)
+{
+    if (items.isEmpty()) {
+        return;
+    }
+    
+    // 分页加载时追加一页，已显示的行不重置
+    const int first = m_softwareItems.size();
+    beginInsertRows(QModelIndex(), first, first + items.size() - 1);
+    m_softwareItems.append(items);
+    for (int row = first; row < m_softwareItems.size(); ++row) {
+        const SoftwareItem& item = m_softwareItems.at(row);
+        m_rowById.insert(item.getId(), row);
+        m_rowsByIconKey.insert(item.getIconKey(), row);
+    }
+    endInsertRows();
+}
+
+const QList<SoftwareItem>& SoftwareItemModel::softwareItems() const
+{
+    return m_softwareItems;
+}
+
+SoftwareItem SoftwareItemModel::softwareItemAt(int row) const
+{
+    if (row < 0 || row >= m_softwareItems.size()) {
+        return SoftwareItem();
+    }
+    return m_softwareItems.at(row);
+}
+
+int SoftwareItemModel::rowForId(const QString& id) const
+{
+    return m_rowById.value(id, -1);
+}
+
+void SoftwareItemModel::setIconSize(const QSize& size)
+{
+    m_iconSize = size;
+}
+
+QSize SoftwareItemModel::iconSize() const
+{
+    return m_iconSize;
+}
+
+void SoftwareItemModel::onIconReady(const QString& iconKey, const QIcon& icon)
+{
+    Q_UNUSED(icon);
+    
+    const QList<int> rows = m_rowsByIconKey.values(iconKey);
+    for (int row : rows) {
+        const QModelIndex changed = index(row, NameColumn);
+        emit dataChanged(changed, changed, QList<int>() << Qt::DecorationRole);
+    }
+}
+
+void SoftwareItemModel::removeRowRanges(const QList<QPair<int, int>>& ranges)
+{
+    if (ranges.isEmpty()) {
+        return;
+    }
+    
+    // 第一个被移除的行之前的索引不变；从它开始的索引项先撤下，移除后按新的行号登记一次
+    const int first = ranges.last().first;
+    for (int row = first; row < m_softwareItems.size(); ++row) {
+        const SoftwareItem& item = m_softwareItems.at(row);
+        m_rowById.remove(item.getId());
+        m_rowsByIconKey.remove(item.getIconKey(), row);
+    }
+    
+    // 从后向前移除，前面各段的行号不受影响；每段只发出一次信号
+    for (const QPair<int, int>& range : ranges) {
+        beginRemoveRows(QModelIndex(), range.first, range.second);
+        m_softwareItems.remove(range.first, range.second - range.first + 1);
+        endRemoveRows();
+    }
+    
+    for (int row = first; row < m_softwareItems.size(); ++row) {
+        const SoftwareItem& item = m_softwareItems.at(row);
+        m_rowById.insert(item.getId(), row);
+        m_rowsByIconKey.insert(item.getIconKey(), row);
+    }
+}
+
+void SoftwareItemModel::rebuildIndex()
+{
+    m_rowById.clear();
+    m_rowsByIconKey.clear();
+    m_rowById.reserve(m_softwareItems.size());
+    m_rowsByIconKey.reserve(m_softwareItems.size());
+    
+    for (int row = 0; row < m_softwareItems.size(); ++row) {
+        const SoftwareItem& item = m_softwareItems.at(row);
+        m_rowById.insert(item.getId(), row);
+        m_rowsByIconKey.insert(item.getIconKey(), row);
+    }
+}
+
+void SoftwareItemModel::emitRowChanged(int row)
+{
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
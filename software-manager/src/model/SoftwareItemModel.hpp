@@ -0,0 +1,75 @@
+#ifndef SOFTWAREITEMMODEL_H
+#define SOFTWAREITEMMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QHash>
+#include <QMultiHash>
+#include <QPair>
+#include <QIcon>
+#include <QSize>
+#include "SoftwareItem.hpp"
+
+// 软件项表格模型，由网格视图和列表视图共享；视图只为可见的行取数据和加载图标，
+// 增删改只发出受影响行的信号
+class SoftwareItemModel : public QAbstractTableModel {
+    Q_OBJECT
+    
+public:
+    enum Columns {
+        NameColumn = 0,
+        CategoryColumn,
+        PathColumn,
+        VersionColumn,
+        DescriptionColumn,
+        ColumnCount
+    };
+    
+    enum Roles {
+        SoftwareIdRole = Qt::UserRole + 1,
+        FilePathRole,
+        CategoryRole
+    };
+    
+    explicit SoftwareItemModel(QObject* parent = nullptr);
+    
+    // QAbstractTableModel接口
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    
+    // 软件项管理方法
+    void addSoftwareItem(const SoftwareItem& item);
+    void removeSoftwareItem(const QString& id);
+    void removeSoftwareItemsByFilePaths(const QStringList& filePaths);
+    void updateSoftwareItem(const SoftwareItem& item);
+    void clearAllItems();
+    void setSoftwareItems(const QList<SoftwareItem>& items);
+    void appendSoftwareItems(const QList<SoftwareItem>& items);
+    const QList<SoftwareItem>& softwareItems() const;
+    
+    // 查询方法
+    SoftwareItem softwareItemAt(int row) const;
+    int rowForId(const QString& id) const;
+    
+    // 请求加载的图标尺寸
+    void setIconSize(const QSize& size);
+    QSize iconSize() const;
+    
+private:
+    void onIconReady(const QString& iconKey, const QIcon& icon);
+    void rebuildIndex();
+    
+    // 移除按从后向前顺序排列的行区间[first, last]，只更新受影响的索引项
+    void removeRowRanges(const QList<QPair<int, int>>& ranges);
+    void emitRowChanged(int row);
+    
+    QList<SoftwareItem> m_softwareItems;
+    QHash<QString, int> m_rowById;
+    QMultiHash<QString, int> m_rowsByIconKey;
+    QIcon m_placeholderIcon;
+    QSize m_iconSize;
+};
+
+#endif // SOFTWAREITEMMODEL_H
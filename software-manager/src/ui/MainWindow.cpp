@@ -9,7 +9,12 @@
 #include "../core/SystemTrayManager.hpp"
 #include "../core/GlobalHotkeyManager.hpp"
 #include "../core/DatabaseManager.hpp"
+#include "../core/DatabaseExecutor.hpp"
+#include "../core/DatabaseReaderPool.hpp"
+#include "../core/SearchIndex.hpp"
+#include "../core/LaunchTracker.hpp"
 #include "../model/SoftwareItem.hpp"
+#include "../model/SoftwareItemModel.hpp"
 #include <QToolBar>
 #include <QStatusBar>
 #include <QStackedWidget>
@@ -23,8 +28,19 @@
 #include <QMessageBox>
 #include <QProcess>
 #include <QTimer>
+#include "../utils/DesktopEntryParser.hpp"
 #include "../utils/Logging.hpp"
 
+namespace {
+
+// 扫描结果在数据库线程中写入后的结果
+struct ScanWriteResult {
+    bool success = false;
+    DatabaseManager::IngestResult ingested;
+};
+
+}
+
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
     , m_sidebar(nullptr)
@@ -33,11 +49,16 @@ MainWindow::MainWindow(QWidget* parent)
     , m_listView(nullptr)
     , m_toolbar(nullptr)
     , m_statusbar(nullptr)
+    , m_softwareModel(nullptr)
+    , m_listGeneration(0)
     , m_scanner(nullptr)
     , m_categoryManager(nullptr)
     , m_trayManager(nullptr)
     , m_hotkeyManager(nullptr)
-    , m_databaseManager(nullptr)
+    , m_databaseExecutor(nullptr)
+    , m_databaseReaders(nullptr)
+    , m_searchIndex(nullptr)
+    , m_launchTracker(nullptr)
     , m_searchDialog(nullptr)
     , m_settingsDialog(nullptr)
 {
@@ -54,16 +75,53 @@ MainWindow::MainWindow(QWidget* parent)
     // 设置状态栏
     m_statusbar->showMessage("就绪");
     
-    // 初始化数据库管理器
-    m_databaseManager = new DatabaseManager(this);
-    m_databaseManager->initializeDatabase();
+    // 建表、迁移和软件项的读写都在数据库线程中进行，GUI线程不打开数据库连接；
+    // 建表和迁移是执行器的第一个请求，之后提交的读写都排在它后面
+    m_databaseExecutor = new DatabaseExecutor(QString(), DatabaseManager::ReadWrite, this);
+    
+    // 与写入顺序无关的查询交给只读连接池，不必等待扫描结果写入；
+    // 读连接在第一个查询时才打开，分类计数排在写执行器的分类导入之后，此时表已建好
+    m_databaseReaders = new DatabaseReaderPool(QString(), 0, this);
+    
+    // 分类和计数以数据库为准，写入和读取都不在GUI线程中进行，侧边栏随分类服务的变化通知更新
+    m_categoryManager = new CategoryManager(m_databaseExecutor, m_databaseReaders, this);
+    m_categoryManager->load();
+    connect(m_categoryManager, &CategoryManager::categoriesChanged, this, [this]() {
+        m_sidebar->setCategories(m_categoryManager->getCategories(), m_categoryManager->getCategoryCounts());
+    });
+    connect(m_categoryManager, &CategoryManager::categoryRenamed, 
+            this, [this](const QString& oldName, const QString& newName) {
+                if (m_currentCategory == oldName) {
+                    updateSoftwareList(newName);
+                }
+            });
+    connect(m_sidebar, &SidebarWidget::categoryAdded, m_categoryManager, &CategoryManager::addCategory);
+    connect(m_sidebar, &SidebarWidget::categoryRemoved, m_categoryManager, &CategoryManager::removeCategory);
+    connect(m_sidebar, &SidebarWidget::categoryRenamed, m_categoryManager, &CategoryManager::renameCategory);
+    m_sidebar->setCategories(m_categoryManager->getCategories(), m_categoryManager->getCategoryCounts());
+    
+    // 加载启动统计，常用的软件在视图和搜索结果中排在前面
+    m_launchTracker = new LaunchTracker(m_databaseExecutor, this);
+    m_launchTracker->load();
+    
+    // 建立搜索索引，之后随软件的增删增量更新
+    m_searchIndex = new SearchIndex(this);
+    m_searchIndex->setLaunchTracker(m_launchTracker);
+    m_databaseExecutor->getAllSoftwareItemsAsync().then(this, [this](const QList<SoftwareItem>& items) {
+        m_searchIndex->setSoftwareItems(items);
+    });
     
-    // 首次启动时自动扫描
     QSettings settings;
+    m_scanner->setWatchingEnabled(settings.value("Scan/WatchEnabled", true).toBool());
     bool autoScan = settings.value("Scan/AutoScan", true).toBool();
-    if (autoScan) {
-        QTimer::singleShot(1000, this, &MainWindow::scanSystemSoftware);
-    }
+    
+    // 加载上次扫描的目录快照，启动扫描只需检查变化的目录；快照就绪后才开始自动扫描
+    m_databaseExecutor->getDirectorySnapshotsAsync().then(this, [this, autoScan](const QList<DirectorySnapshot>& snapshots) {
+        m_scanner->setDirectorySnapshots(snapshots);
+        if (autoScan) {
+            QTimer::singleShot(1000, this, &MainWindow::scanSystemSoftware);
+        }
+    });
     
     qCInfo(softwareManager) << "主窗口初始化完成";
 }
@@ -71,6 +129,14 @@ MainWindow::MainWindow(QWidget* parent)
 MainWindow::~MainWindow()
 {
     saveSettings();
+    
+    // 子对象按创建顺序析构，执行器先于启动统计销毁；先销毁启动统计，
+    // 未保存的统计提交给数据库线程，执行器关闭连接前写入
+    if (m_searchIndex) {
+        m_searchIndex->setLaunchTracker(nullptr);
+    }
+    delete m_launchTracker;
+    m_launchTracker = nullptr;
 }
 
 void MainWindow::closeEvent(QCloseEvent* event)
@@ -102,6 +168,19 @@ void MainWindow::onSettingsButtonClicked()
 {
     if (!m_settingsDialog) {
         m_settingsDialog = new SettingsDialog(this);
+        connect(m_settingsDialog, &QDialog::accepted, this, [this]() {
+            QSettings settings;
+            m_scanner->setWatchingEnabled(settings.value("Scan/WatchEnabled", true).toBool());
+            
+            // 数据库性能设置立即应用到已打开的写连接和读连接，在各自的数据库线程中执行
+            const DatabaseManager::PerformanceProfile profile = DatabaseManager::PerformanceProfile::fromSettings();
+            m_databaseExecutor->run([profile](DatabaseManager& databaseManager) {
+                if (!databaseManager.setPerformanceProfile(profile)) {
+                    qCWarning(softwareManager) << "无法应用新的数据库性能设置";
+                }
+            });
+            m_databaseReaders->setPerformanceProfile(profile);
+        });
     }
     
     m_settingsDialog->show();
@@ -153,15 +232,69 @@ void MainWindow::onSearchHotkeyPressed()
 
 void MainWindow::onScanFinished(const QList<SoftwareItem>& items)
 {
-    m_statusbar->showMessage(QString("扫描完成，发现 %1 个软件").arg(items.size()));
+    // 更新软件列表显示
+    updateSoftwareList();
     
-    // 保存扫描到的软件项到数据库
-    if (m_databaseManager) {
-        m_databaseManager->batchInsertSoftwareItems(items);
+    m_statusbar->showMessage(QString("扫描完成，发现 %1 个新增或更新的软件").arg(items.size()));
+}
+
+void MainWindow::onScanDelta(const ScanDelta& delta)
+{
+    if (!m_databaseExecutor) {
+        return;
     }
     
-    // 更新软件列表显示
-    updateSoftwareList();
+    // 新增和更新的软件项按路径合并：已有记录保留id、启动统计和用户修改过的分类，
+    // 没有快照时所有文件都按新增上报，也只会写入真正变化的记录
+    const QStringList removedPaths = delta.removedFilePaths;
+    const QList<SoftwareItem> items = delta.addedItems + delta.modifiedItems;
+    const QList<DirectorySnapshot> snapshots = delta.changedSnapshots;
+    const QStringList removedDirectories = delta.removedDirectories;
+    
+    m_databaseExecutor->run([removedPaths, items, snapshots, removedDirectories](DatabaseManager& databaseManager) {
+        ScanWriteResult result;
+        result.success = databaseManager.removeSoftwareItemsByFilePaths(removedPaths) &&
+                         databaseManager.ingestSoftwareItems(items, &result.ingested);
+        if (result.success) {
+            databaseManager.saveDirectorySnapshots(snapshots, removedDirectories);
+        }
+        return result;
+    }).then(this, [this, removedPaths](const ScanWriteResult& result) {
+        if (result.success) {
+            // 搜索索引和视图只更新变化的软件项
+            m_searchIndex->removeSoftwareItemsByFilePaths(removedPaths);
+            m_softwareModel->removeSoftwareItemsByFilePaths(removedPaths);
+            for (const SoftwareItem& item : result.ingested.inserted) {
+                m_searchIndex->addSoftwareItem(item);
+            }
+            for (const SoftwareItem& item : result.ingested.updated) {
+                m_searchIndex->updateSoftwareItem(item);
+            }
+            
+            // 属于当前分类的行插入或更新，分类变化后不再属于当前分类的行移除
+            for (const SoftwareItem& item : result.ingested.inserted + result.ingested.updated) {
+                const bool shown = m_softwareModel->rowForId(item.getId()) >= 0;
+                if (!isInCurrentCategory(item)) {
+                    m_softwareModel->removeSoftwareItem(item.getId());
+                } else if (shown) {
+                    m_softwareModel->updateSoftwareItem(item);
+                } else {
+                    m_softwareModel->addSoftwareItem(item);
+                }
+            }
+            m_categoryManager->scheduleRefresh();
+        } else {
+            // 扫描结果未能保存，丢弃快照以便下次完整扫描
+            m_scanner->clearDirectorySnapshots();
+            qCWarning(softwareManager) << "保存扫描结果失败，下次将完整扫描";
+        }
+    });
+}
+
+bool MainWindow::isInCurrentCategory(const SoftwareItem& item) const
+{
+    return m_currentCategory.isEmpty() || m_currentCategory == "所有软件" ||
+           m_currentCategory == item.getCategory();
 }
 
 void MainWindow::onSoftwareItemLaunched(const QString& softwareId)
@@ -218,12 +351,15 @@ void MainWindow::setupUI()
     m_viewStack = new QStackedWidget(this);
     splitter->addWidget(m_viewStack);
     
+    // 创建两个视图共享的模型
+    m_softwareModel = new SoftwareItemModel(this);
+    
     // 创建网格视图
-    m_gridView = new SoftwareGridView(this);
+    m_gridView = new SoftwareGridView(m_softwareModel, this);
     m_viewStack->addWidget(m_gridView);
     
     // 创建列表视图
-    m_listView = new SoftwareListView(this);
+    m_listView = new SoftwareListView(m_softwareModel, this);
     m_viewStack->addWidget(m_listView);
     
     // 设置分割器比例
@@ -257,7 +393,6 @@ void MainWindow::setupUI()
     
     // 创建核心管理器
     m_scanner = new SoftwareScanner(this);
-    m_categoryManager = new CategoryManager(this);
     m_trayManager = new SystemTrayManager(this);
     m_hotkeyManager = new GlobalHotkeyManager(this);
 }
@@ -268,9 +403,16 @@ void MainWindow::setupConnections()
     connect(m_sidebar, &SidebarWidget::categorySelected, 
             this, &MainWindow::onCategorySelected);
     
-    // 连接扫描器信号
+    // 连接扫描器信号（先写入变化，再刷新显示）
+    connect(m_scanner, &SoftwareScanner::scanDelta, 
+            this, &MainWindow::onScanDelta);
     connect(m_scanner, &SoftwareScanner::scanFinished, 
             this, &MainWindow::onScanFinished);
+    connect(m_scanner, &SoftwareScanner::softwareChanged, 
+            this, [this](const QList<SoftwareItem>& items) {
+                // 视图在写入完成后由onScanDelta逐行更新，这里只提示
+                m_statusbar->showMessage(QString("检测到软件变化，新增或更新 %1 个软件").arg(items.size()));
+            });
     connect(m_scanner, &SoftwareScanner::scanProgress, 
             this, [this](int progress) {
                 m_statusbar->showMessage(QString("正在扫描... %1%").arg(progress));
@@ -351,26 +493,49 @@ void MainWindow::saveSettings()
 
 void MainWindow::updateSoftwareList(const QString& category)
 {
-    // 从数据库获取软件项
-    QList<SoftwareItem> items;
-    if (m_databaseManager) {
-        if (category.isEmpty() || category == "所有软件") {
-            items = m_databaseManager->getAllSoftwareItems();
-        } else {
-            items = m_databaseManager->getSoftwareItemsByCategory(category);
-        }
+    if (!m_databaseExecutor) {
+        return;
     }
     
-    // 更新视图
-    if (m_gridView) {
-        m_gridView->setSoftwareItems(items);
-    }
+    // 从数据库分页读取软件项，第一页读出后立即显示，其余的页依次追加；
+    // 连续切换分类时取消旧的读取，已经送出的页按序号丢弃
+    m_currentCategory = category;
+    const int generation = ++m_listGeneration;
+    m_listStream.cancel();
+    const QString filter = (category.isEmpty() || category == "所有软件") ? QString() : category;
     
-    if (m_listView) {
-        m_listView->setSoftwareItems(items);
-    }
+    auto onPage = [this, generation](QList<SoftwareItem> page, int offset) {
+        if (generation != m_listGeneration || !m_softwareModel) {
+            return;
+        }
+        
+        // 两个视图观察同一个模型，只需更新模型
+        if (offset == 0) {
+            m_softwareModel->setSoftwareItems(page);
+        } else {
+            m_softwareModel->appendSoftwareItems(page);
+        }
+        m_statusbar->showMessage(QString("正在加载软件项... %1").arg(offset + page.size()));
+    };
     
-    m_statusbar->showMessage(QString("显示 %1 个软件项").arg(items.size()));
+    // 常用的软件排在前面，排序在查询中完成，各页按最终顺序送达，只需依次追加；
+    // 尚未保存的启动统计先提交给同一个执行器，写入排在读取之前，排序才包含最近的启动
+    if (m_launchTracker) {
+        m_launchTracker->flush();
+    }
+    m_listStream = m_databaseExecutor->streamSoftwareItemsAsync(filter, SoftwareListPageSize, this, onPage,
+                                                                DatabaseManager::SortByFrecency);
+    m_listStream.then(this, [this, generation](int count) {
+        if (generation != m_listGeneration || !m_softwareModel) {
+            return;
+        }
+        
+        if (count == 0) {
+            m_softwareModel->setSoftwareItems(QList<SoftwareItem>());
+        }
+        
+        m_statusbar->showMessage(QString("显示 %1 个软件项").arg(count));
+    });
 }
 
 void MainWindow::addSoftwareManually()
@@ -385,19 +550,44 @@ void MainWindow::addSoftwareManually()
         SoftwareItem item(filePath);
         
         if (item.isValid()) {
-            // 设置默认分类
-            item.setCategory("未分类");
-            
-            // 保存到数据库
-            if (m_databaseManager && m_databaseManager->addSoftwareItem(item)) {
-                // 更新显示
-                updateSoftwareList();
-                m_statusbar->showMessage(QString("成功添加软件: %1").arg(item.getName()));
-                qCInfo(softwareManager) << "手动添加软件:" << item.getName() << "路径:" << filePath;
-            } else {
-                QMessageBox::warning(this, "错误", "保存软件信息失败");
-                qCWarning(softwareManager) << "保存软件信息失败:" << filePath;
+            // 设置默认分类（.desktop文件已从Categories得到分类）
+            if (item.getCategory().isEmpty()) {
+                item.setCategory("未分类");
             }
+            
+            // 保存到数据库，已存在的路径不会重复添加
+            m_databaseExecutor->run([item](DatabaseManager& databaseManager) {
+                ScanWriteResult result;
+                result.success = databaseManager.ingestSoftwareItems(QList<SoftwareItem>() << item, &result.ingested);
+                return result;
+            }).then(this, [this, item, filePath](const ScanWriteResult& result) {
+                if (!result.success) {
+                    QMessageBox::warning(this, "错误", "保存软件信息失败");
+                    qCWarning(softwareManager) << "保存软件信息失败:" << filePath;
+                    return;
+                }
+                
+                if (result.ingested.inserted.isEmpty()) {
+                    for (const SoftwareItem& updated : result.ingested.updated) {
+                        m_searchIndex->updateSoftwareItem(updated);
+                    }
+                    m_statusbar->showMessage(QString("软件已存在: %1").arg(item.getName()));
+                    return;
+                }
+                
+                const SoftwareItem& added = result.ingested.inserted.first();
+                m_searchIndex->addSoftwareItem(added);
+                m_categoryManager->scheduleRefresh();
+                
+                // 属于当前分类时只插入一行，否则切换到显示全部软件
+                if (isInCurrentCategory(added)) {
+                    m_softwareModel->addSoftwareItem(added);
+                } else {
+                    updateSoftwareList();
+                }
+                m_statusbar->showMessage(QString("成功添加软件: %1").arg(added.getName()));
+                qCInfo(softwareManager) << "手动添加软件:" << added.getName() << "路径:" << filePath;
+            });
         } else {
             QMessageBox::warning(this, "错误", "选择的文件无效");
             qCWarning(softwareManager) << "选择的文件无效:" << filePath;
@@ -407,18 +597,34 @@ void MainWindow::addSoftwareManually()
 
 void MainWindow::launchSoftware(const QString& softwareId)
 {
-    if (!m_databaseManager) {
+    if (!m_databaseReaders) {
         return;
     }
     
-    SoftwareItem item = m_databaseManager->getSoftwareItemById(softwareId);
-    if (item.isValid()) {
+    m_databaseReaders->getSoftwareItemByIdAsync(softwareId).then(this, [this, softwareId](const SoftwareItem& item) {
+        if (!item.isValid()) {
+            return;
+        }
+        
         QString filePath = item.getFilePath();
         
-        // 启动软件
-        bool success = QProcess::startDetached(filePath);
+        // 启动软件（.desktop文件按其中的Exec命令启动）
+        bool success = false;
+        if (filePath.endsWith(".desktop")) {
+            DesktopEntryParser parser;
+            DesktopEntry entry = parser.parseFile(filePath);
+            QStringList arguments = DesktopEntryParser::execArguments(entry.exec, entry, filePath);
+            if (!arguments.isEmpty()) {
+                QString program = arguments.takeFirst();
+                success = QProcess::startDetached(program, arguments);
+            }
+        } else {
+            success = QProcess::startDetached(filePath);
+        }
         
         if (success) {
+            // 只更新内存中的统计，数据库写入合并后延迟进行
+            m_launchTracker->recordLaunch(softwareId);
             m_statusbar->showMessage(QString("启动软件: %1").arg(item.getName()));
             qCInfo(softwareManager) << "成功启动软件:" << item.getName() << "路径:" << filePath;
         } else {
@@ -426,31 +632,36 @@ void MainWindow::launchSoftware(const QString& softwareId)
             QMessageBox::warning(this, "错误", QString("无法启动软件: %1").arg(item.getName()));
             qCWarning(softwareManager) << "启动软件失败:" << item.getName() << "路径:" << filePath;
         }
-    }
+    });
 }
 
 void MainWindow::removeSoftware(const QString& softwareId)
 {
-    if (!m_databaseManager) {
+    if (!m_databaseExecutor) {
         return;
     }
     
-    // 获取软件项信息用于日志
-    SoftwareItem item = m_databaseManager->getSoftwareItemById(softwareId);
-    
-    // 从数据库删除
-    if (m_databaseManager->removeSoftwareItem(softwareId)) {
-        // 更新显示
-        updateSoftwareList();
-        m_statusbar->showMessage("软件已删除");
-        qCInfo(softwareManager) << "删除软件项:" << (item.isValid() ? item.getName() : softwareId);
-    } else {
-        QMessageBox::warning(this, "错误", "删除软件失败");
-        qCWarning(softwareManager) << "删除软件项失败:" << softwareId;
-    }
+    // 查询名称（用于日志）和删除在同一个请求中完成
+    m_databaseExecutor->run([softwareId](DatabaseManager& databaseManager) {
+        SoftwareItem item = databaseManager.getSoftwareItemById(softwareId);
+        const QString name = item.isValid() ? item.getName() : softwareId;
+        return databaseManager.removeSoftwareItem(softwareId) ? name : QString();
+    }).then(this, [this, softwareId](const QString& removedName) {
+        if (!removedName.isEmpty()) {
+            // 只移除对应的一行
+            m_softwareModel->removeSoftwareItem(softwareId);
+            m_searchIndex->removeSoftwareItem(softwareId);
+            m_categoryManager->scheduleRefresh();
+            m_statusbar->showMessage("软件已删除");
+            qCInfo(softwareManager) << "删除软件项:" << removedName;
+        } else {
+            QMessageBox::warning(this, "错误", "删除软件失败");
+            qCWarning(softwareManager) << "删除软件项失败:" << softwareId;
+        }
+    });
 }
 
-DatabaseManager* MainWindow::databaseManager() const
+SearchIndex* MainWindow::searchIndex() const
 {
-    return m_databaseManager;
+    return m_searchIndex;
 }
@@ -6,18 +6,24 @@
 #include <QStackedWidget>
 #include <QToolBar>
 #include <QStatusBar>
+#include <QFuture>
 
 // 前置声明
 class SidebarWidget;
 class SoftwareGridView;
 class SoftwareListView;
+class SoftwareItemModel;
 class SoftwareScanner;
 class CategoryManager;
 class SystemTrayManager;
 class GlobalHotkeyManager;
 class SearchDialog;
 class SettingsDialog;
-class DatabaseManager;
+class DatabaseExecutor;
+class DatabaseReaderPool;
+class SearchIndex;
+class LaunchTracker;
+struct ScanDelta;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -30,8 +36,8 @@ public:
     void showSearchDialog();
     void scanSystemSoftware();
     
-    // 添加获取数据库管理器的方法
-    DatabaseManager* databaseManager() const;
+    // 搜索对话框使用的常驻搜索索引
+    SearchIndex* searchIndex() const;
     
 protected:
     void closeEvent(QCloseEvent* event) override;
@@ -68,12 +74,24 @@ private:
     QToolBar* m_toolbar;
     QStatusBar* m_statusbar;
     
+    // 两个视图共享的软件项模型，以及当前显示的分类
+    SoftwareItemModel* m_softwareModel;
+    QString m_currentCategory;
+    
+    // 软件列表分页加载，每次刷新递增序号并取消上一次的读取，过期的页被丢弃
+    static constexpr int SoftwareListPageSize = 200;
+    int m_listGeneration;
+    QFuture<int> m_listStream;
+    
     // 核心管理器
     SoftwareScanner* m_scanner;
     CategoryManager* m_categoryManager;
     SystemTrayManager* m_trayManager;
     GlobalHotkeyManager* m_hotkeyManager;
-    DatabaseManager* m_databaseManager;
+    DatabaseExecutor* m_databaseExecutor;
+    DatabaseReaderPool* m_databaseReaders;
+    SearchIndex* m_searchIndex;
+    LaunchTracker* m_launchTracker;
     
     // 对话框
     SearchDialog* m_searchDialog;
@@ -87,6 +105,8 @@ private:
     void loadSettings();
     void saveSettings();
     void updateSoftwareList(const QString& category = QString());
+    void onScanDelta(const ScanDelta& delta);
+    bool isInCurrentCategory(const SoftwareItem& item) const;
     
     // 软件管理方法
     void addSoftwareManually();
@@ -1,6 +1,6 @@
 #include "SearchDialog.hpp"
 #include "../model/SoftwareItem.hpp"
-#include "../core/DatabaseManager.hpp"
+#include "../core/SearchIndex.hpp"
 #include "MainWindow.hpp"
 #include <QLineEdit>
 #include <QListWidget>
@@ -10,6 +10,7 @@
 #include <QLabel>
 #include <QTimer>
 #include <QApplication>
+#include <QSet>
 #include "../utils/Logging.hpp"
 
 SearchDialog::SearchDialog(QWidget* parent)
@@ -19,9 +20,16 @@ SearchDialog::SearchDialog(QWidget* parent)
     , m_searchButton(nullptr)
     , m_launchButton(nullptr)
     , m_closeButton(nullptr)
+    , m_searchTimer(nullptr)
 {
     setupUI();
     
+    // 搜索在内存索引中完成，不需要长时间的防抖延迟
+    m_searchTimer = new QTimer(this);
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(0);
+    connect(m_searchTimer, &QTimer::timeout, this, &SearchDialog::performSearch);
+    
     // 设置窗口属性
     setWindowTitle("搜索软件");
     setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
@@ -71,15 +79,7 @@ QList<SoftwareItem> SearchDialog::searchResults() const
 
 void SearchDialog::onSearchTextChanged()
 {
-    // 延迟搜索以提高性能
-    static QTimer* searchTimer = nullptr;
-    if (!searchTimer) {
-        searchTimer = new QTimer(this);
-        searchTimer->setSingleShot(true);
-        connect(searchTimer, &QTimer::timeout, this, &SearchDialog::performSearch);
-    }
-    
-    searchTimer->start(300); // 300ms延迟
+    m_searchTimer->start();
 }
 
 void SearchDialog::onSearchButtonClicked()
@@ -187,16 +187,26 @@ void SearchDialog::performSearch()
         parentWidget = parentWidget->parentWidget();
     }
     
-    if (mainWindow && mainWindow->databaseManager()) {
-        // 从数据库中搜索匹配的软件项
-        QList<SoftwareItem> allItems = mainWindow->databaseManager()->getAllSoftwareItems();
+    if (mainWindow && mainWindow->searchIndex()) {
+        // 名称的模糊匹配按得分排在前面，再补上只在描述或文件名中包含关键字的结果；
+        // 结果列表只显示排名靠前的部分
+        const int maxResults = 200;
+        SearchIndex* searchIndex = mainWindow->searchIndex();
+        m_searchResults = searchIndex->fuzzySearch(keyword, maxResults);
         
-        // 筛选匹配的项目
-        m_searchResults.clear();
-        for (const SoftwareItem& item : allItems) {
-            if (item.getName().contains(keyword, Qt::CaseInsensitive) || 
-                item.getDescription().contains(keyword, Qt::CaseInsensitive)) {
-                m_searchResults.append(item);
+        if (m_searchResults.size() < maxResults) {
+            QSet<QString> matchedIds;
+            for (const SoftwareItem& item : std::as_const(m_searchResults)) {
+                matchedIds.insert(item.getId());
+            }
+            
+            for (const SoftwareItem& item : searchIndex->search(keyword, maxResults)) {
+                if (m_searchResults.size() >= maxResults) {
+                    break;
+                }
+                if (!matchedIds.contains(item.getId())) {
+                    m_searchResults.append(item);
+                }
             }
         }
     } else {
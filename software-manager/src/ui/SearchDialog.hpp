@@ -7,6 +7,7 @@
 class QLineEdit;
 class QListWidget;
 class QPushButton;
+class QTimer;
 class SoftwareItem;
 
 class SearchDialog : public QDialog {
@@ -43,6 +44,9 @@ private:
     QPushButton* m_launchButton;
     QPushButton* m_closeButton;
     
+    // 合并同一轮事件中的多次输入
+    QTimer* m_searchTimer;
+    
     QList<SoftwareItem> m_searchResults;
 };
 
@@ -72,10 +72,12 @@ void SettingsDialog::onRestoreDefaultsClicked()
     if (ret == QMessageBox::Yes) {
         // 恢复默认设置
         m_autoScanCheckBox->setChecked(true);
+        m_watchCheckBox->setChecked(true);
         m_viewModeComboBox->setCurrentIndex(0); // 网格视图
         m_iconSizeSpinBox->setValue(64);
         m_minimizeToTrayCheckBox->setChecked(true);
         m_closeToTrayCheckBox->setChecked(true);
+        showPerformanceProfile(DatabaseManager::PerformanceProfile::tuned());
         
         // 清空扫描路径列表
         m_scanPathsList->clear();
@@ -125,6 +127,9 @@ void SettingsDialog::setupUI()
     m_autoScanCheckBox = new QCheckBox("启动时自动扫描");
     scanLayout->addWidget(m_autoScanCheckBox, 3, 0, 1, 2);
     
+    m_watchCheckBox = new QCheckBox("实时监视扫描路径的变化");
+    scanLayout->addWidget(m_watchCheckBox, 4, 0, 1, 2);
+    
     // 视图设置组
     QGroupBox* viewGroup = new QGroupBox("视图设置");
     QGridLayout* viewLayout = new QGridLayout(viewGroup);
@@ -151,10 +156,45 @@ void SettingsDialog::setupUI()
     m_closeToTrayCheckBox = new QCheckBox("关闭时隐藏到系统托盘");
     trayLayout->addWidget(m_closeToTrayCheckBox);
     
+    // 数据库性能设置组
+    QGroupBox* databaseGroup = new QGroupBox("数据库性能（保存后立即应用）");
+    QGridLayout* databaseLayout = new QGridLayout(databaseGroup);
+    
+    m_walCheckBox = new QCheckBox("使用WAL日志（读写互不阻塞）");
+    databaseLayout->addWidget(m_walCheckBox, 0, 0, 1, 2);
+    
+    m_synchronousNormalCheckBox = new QCheckBox("减少磁盘同步（synchronous=NORMAL）");
+    databaseLayout->addWidget(m_synchronousNormalCheckBox, 1, 0, 1, 2);
+    
+    m_tempStoreMemoryCheckBox = new QCheckBox("临时数据保存在内存中");
+    databaseLayout->addWidget(m_tempStoreMemoryCheckBox, 2, 0, 1, 2);
+    
+    databaseLayout->addWidget(new QLabel("页缓存大小:"), 3, 0);
+    m_cacheSizeSpinBox = new QSpinBox();
+    m_cacheSizeSpinBox->setRange(1, 1024);
+    m_cacheSizeSpinBox->setSuffix(" MB");
+    databaseLayout->addWidget(m_cacheSizeSpinBox, 3, 1);
+    
+    databaseLayout->addWidget(new QLabel("内存映射大小:"), 4, 0);
+    m_mmapSizeSpinBox = new QSpinBox();
+    m_mmapSizeSpinBox->setRange(0, 4096);
+    m_mmapSizeSpinBox->setSingleStep(64);
+    m_mmapSizeSpinBox->setSuffix(" MB");
+    m_mmapSizeSpinBox->setSpecialValueText("不使用");
+    databaseLayout->addWidget(m_mmapSizeSpinBox, 4, 1);
+    
+    databaseLayout->addWidget(new QLabel("锁等待超时:"), 5, 0);
+    m_busyTimeoutSpinBox = new QSpinBox();
+    m_busyTimeoutSpinBox->setRange(0, 60000);
+    m_busyTimeoutSpinBox->setSingleStep(1000);
+    m_busyTimeoutSpinBox->setSuffix(" 毫秒");
+    databaseLayout->addWidget(m_busyTimeoutSpinBox, 5, 1);
+    
     // 添加到主布局
     mainLayout->addWidget(scanGroup);
     mainLayout->addWidget(viewGroup);
     mainLayout->addWidget(trayGroup);
+    mainLayout->addWidget(databaseGroup);
     
     // 按钮布局
     QHBoxLayout* buttonLayout = new QHBoxLayout();
@@ -188,6 +228,7 @@ void SettingsDialog::loadSettings()
     }
     
     m_autoScanCheckBox->setChecked(settings.value("Scan/AutoScan", true).toBool());
+    m_watchCheckBox->setChecked(settings.value("Scan/WatchEnabled", true).toBool());
     
     // 加载视图设置
     QString viewMode = settings.value("View/Mode", "grid").toString();
@@ -197,6 +238,9 @@ void SettingsDialog::loadSettings()
     // 加载系统托盘设置
     m_minimizeToTrayCheckBox->setChecked(settings.value("Tray/MinimizeToTray", true).toBool());
     m_closeToTrayCheckBox->setChecked(settings.value("Tray/CloseToTray", true).toBool());
+    
+    // 加载数据库性能设置
+    showPerformanceProfile(DatabaseManager::PerformanceProfile::fromSettings());
 }
 
 void SettingsDialog::saveSettings()
@@ -210,6 +254,7 @@ void SettingsDialog::saveSettings()
     }
     settings.setValue("Scan/Paths", paths);
     settings.setValue("Scan/AutoScan", m_autoScanCheckBox->isChecked());
+    settings.setValue("Scan/WatchEnabled", m_watchCheckBox->isChecked());
     
     // 保存视图设置
     settings.setValue("View/Mode", m_viewModeComboBox->currentData().toString());
@@ -219,5 +264,25 @@ void SettingsDialog::saveSettings()
     settings.setValue("Tray/MinimizeToTray", m_minimizeToTrayCheckBox->isChecked());
     settings.setValue("Tray/CloseToTray", m_closeToTrayCheckBox->isChecked());
     
+    // 保存数据库性能设置
+    DatabaseManager::PerformanceProfile profile;
+    profile.walEnabled = m_walCheckBox->isChecked();
+    profile.synchronousNormal = m_synchronousNormalCheckBox->isChecked();
+    profile.cacheSizeMb = m_cacheSizeSpinBox->value();
+    profile.mmapSizeMb = m_mmapSizeSpinBox->value();
+    profile.tempStoreMemory = m_tempStoreMemoryCheckBox->isChecked();
+    profile.busyTimeoutMs = m_busyTimeoutSpinBox->value();
+    profile.saveToSettings();
+    
     qCInfo(softwareManager) << "设置已保存";
+}
+
+void SettingsDialog::showPerformanceProfile(const DatabaseManager::PerformanceProfile& profile)
+{
+    m_walCheckBox->setChecked(profile.walEnabled);
+    m_synchronousNormalCheckBox->setChecked(profile.synchronousNormal);
+    m_cacheSizeSpinBox->setValue(profile.cacheSizeMb);
+    m_mmapSizeSpinBox->setValue(profile.mmapSizeMb);
+    m_tempStoreMemoryCheckBox->setChecked(profile.tempStoreMemory);
+    m_busyTimeoutSpinBox->setValue(profile.busyTimeoutMs);
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <QDialog>
 #include <QList>
+#include "../core/DatabaseManager.hpp"
 
 class QCheckBox;
 class QSpinBox;
@@ -28,12 +29,14 @@ private:
     void setupUI();
     void loadSettings();
     void saveSettings();
+    void showPerformanceProfile(const DatabaseManager::PerformanceProfile& profile);
     
     // 扫描设置
     QListWidget* m_scanPathsList;
     QPushButton* m_addPathButton;
     QPushButton* m_removePathButton;
     QCheckBox* m_autoScanCheckBox;
+    QCheckBox* m_watchCheckBox;
     
     // 视图设置
     QComboBox* m_viewModeComboBox;
@@ -43,6 +46,14 @@ private:
     QCheckBox* m_minimizeToTrayCheckBox;
     QCheckBox* m_closeToTrayCheckBox;
     
+    // 数据库性能设置（保存后由主窗口应用到已打开的连接）
+    QCheckBox* m_walCheckBox;
+    QCheckBox* m_synchronousNormalCheckBox;
+    QSpinBox* m_cacheSizeSpinBox;
+    QSpinBox* m_mmapSizeSpinBox;
+    QCheckBox* m_tempStoreMemoryCheckBox;
+    QSpinBox* m_busyTimeoutSpinBox;
+    
     // 按钮
     QPushButton* m_saveButton;
     QPushButton* m_cancelButton;
@@ -14,33 +14,38 @@ SidebarWidget::SidebarWidget(QWidget* parent)
     , m_removeButton(nullptr)
 {
     setupUI();
-    loadCategories();
 }
 
-void SidebarWidget::addCategory(const QString& name)
+void SidebarWidget::setCategories(const QStringList& categories, const QHash<QString, int>& counts)
 {
-    if (!name.isEmpty() && m_categoryList) {
-        m_categoryList->addItem(name);
-        emit categoryAdded(name);
-        qCInfo(softwareManager) << "添加分类到侧边栏:" << name;
+    if (!m_categoryList) {
+        return;
     }
-}
-
-void SidebarWidget::removeCategory(const QString& name)
-{
-    if (m_categoryList) {
-        QList<QListWidgetItem*> items = m_categoryList->findItems(name, Qt::MatchExactly);
-        for (QListWidgetItem* item : items) {
-            delete m_categoryList->takeItem(m_categoryList->row(item));
+    
+    // 重建列表时不发出选中信号，当前分类被删除时回到“所有软件”
+    const QString selected = currentCategory();
+    m_categoryList->blockSignals(true);
+    m_categoryList->clear();
+    
+    int selectedRow = 0;
+    for (const QString& category : categories) {
+        // 显示文本带计数，分类名称保存在UserRole中
+        QListWidgetItem* item = new QListWidgetItem(m_categoryList);
+        if (counts.contains(category)) {
+            item->setText(QString("%1 (%2)").arg(category).arg(counts.value(category)));
+        } else {
+            item->setText(category);
+        }
+        item->setData(Qt::UserRole, category);
+        if (category == selected) {
+            selectedRow = m_categoryList->row(item);
         }
-        emit categoryRemoved(name);
-        qCInfo(softwareManager) << "从侧边栏移除分类:" << name;
     }
-}
-
-void SidebarWidget::updateCategoryList()
-{
-    loadCategories();
+    
+    if (m_categoryList->count() > 0) {
+        m_categoryList->setCurrentRow(selectedRow);
+    }
+    m_categoryList->blockSignals(false);
 }
 
 QStringList SidebarWidget::getCategories() const
@@ -48,7 +53,7 @@ QStringList SidebarWidget::getCategories() const
     QStringList categories;
     if (m_categoryList) {
         for (int i = 0; i < m_categoryList->count(); ++i) {
-            categories.append(m_categoryList->item(i)->text());
+            categories.append(m_categoryList->item(i)->data(Qt::UserRole).toString());
         }
     }
     return categories;
@@ -59,7 +64,7 @@ void SidebarWidget::onCategoryItemClicked()
     if (m_categoryList) {
         QListWidgetItem* currentItem = m_categoryList->currentItem();
         if (currentItem) {
-            QString category = currentItem->text();
+            QString category = currentItem->data(Qt::UserRole).toString();
             emit categorySelected(category);
         }
     }
@@ -83,7 +88,8 @@ void SidebarWidget::onAddCategoryClicked()
             return;
         }
         
-        addCategory(name);
+        emit categoryAdded(name);
+        qCInfo(softwareManager) << "请求添加分类:" << name;
     }
 }
 
@@ -92,7 +98,7 @@ void SidebarWidget::onRemoveCategoryClicked()
     if (m_categoryList) {
         QListWidgetItem* currentItem = m_categoryList->currentItem();
         if (currentItem) {
-            QString category = currentItem->text();
+            QString category = currentItem->data(Qt::UserRole).toString();
             
             // 不允许删除内置分类
             if (category == "所有软件" || category == "未分类") {
@@ -103,7 +109,8 @@ void SidebarWidget::onRemoveCategoryClicked()
             int ret = QMessageBox::question(this, "确认", 
                                           QString("确定要删除分类 \"%1\" 吗？").arg(category));
             if (ret == QMessageBox::Yes) {
-                removeCategory(category);
+                emit categoryRemoved(category);
+                qCInfo(softwareManager) << "请求删除分类:" << category;
             }
         } else {
             QMessageBox::information(this, "提示", "请先选择要删除的分类");
@@ -117,7 +124,7 @@ void SidebarWidget::onCategoryItemDoubleClicked()
     if (m_categoryList) {
         QListWidgetItem* currentItem = m_categoryList->currentItem();
         if (currentItem) {
-            QString oldName = currentItem->text();
+            QString oldName = currentItem->data(Qt::UserRole).toString();
             
             // 不允许重命名内置分类
             if (oldName == "所有软件" || oldName == "未分类") {
@@ -142,10 +149,8 @@ void SidebarWidget::onCategoryItemDoubleClicked()
                     return;
                 }
                 
-                currentItem->setText(newName);
-                emit categoryRemoved(oldName);
-                emit categoryAdded(newName);
-                qCInfo(softwareManager) << "重命名分类:" << oldName << "->" << newName;
+                emit categoryRenamed(oldName, newName);
+                qCInfo(softwareManager) << "请求重命名分类:" << oldName << "->" << newName;
             }
         }
     }
@@ -183,26 +188,8 @@ void SidebarWidget::setupUI()
             this, &SidebarWidget::onRemoveCategoryClicked);
 }
 
-void SidebarWidget::loadCategories()
+QString SidebarWidget::currentCategory() const
 {
-    if (m_categoryList) {
-        // 清空现有项
-        m_categoryList->clear();
-        
-        // 添加默认分类
-        m_categoryList->addItem("所有软件");
-        m_categoryList->addItem("未分类");
-        
-        // 这里应该从CategoryManager加载用户自定义分类
-        // 暂时添加一些示例分类
-        m_categoryList->addItem("办公软件");
-        m_categoryList->addItem("开发工具");
-        m_categoryList->addItem("娱乐媒体");
-        m_categoryList->addItem("系统工具");
-        
-        // 默认选中"所有软件"
-        if (m_categoryList->count() > 0) {
-            m_categoryList->setCurrentRow(0);
-        }
-    }
+    QListWidgetItem* currentItem = m_categoryList ? m_categoryList->currentItem() : nullptr;
+    return currentItem ? currentItem->data(Qt::UserRole).toString() : QString();
 }
\ No newline at end of file
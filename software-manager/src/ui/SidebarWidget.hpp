@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include <QStringList>
+#include <QHash>
 
 class QListWidget;
 class QPushButton;
@@ -13,16 +14,17 @@ class SidebarWidget : public QWidget {
 public:
     explicit SidebarWidget(QWidget* parent = nullptr);
     
-    // 分类管理方法
-    void addCategory(const QString& name);
-    void removeCategory(const QString& name);
-    void updateCategoryList();
+    // 用分类服务的快照重建列表，名称后显示软件项数，保留当前选中的分类
+    void setCategories(const QStringList& categories, const QHash<QString, int>& counts);
     QStringList getCategories() const;
     
 signals:
     void categorySelected(const QString& category);
+    
+    // 用户在侧边栏中的修改，由分类服务执行后再通过setCategories更新列表
     void categoryAdded(const QString& name);
     void categoryRemoved(const QString& name);
+    void categoryRenamed(const QString& oldName, const QString& newName);
     
 private slots:
     void onCategoryItemClicked();
@@ -32,7 +34,7 @@ private slots:
     
 private:
     void setupUI();
-    void loadCategories();
+    QString currentCategory() const;
     
     QListWidget* m_categoryList;
     QPushButton* m_addButton;
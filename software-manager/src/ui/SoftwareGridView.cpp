@@ -1,146 +1,166 @@
 #include "SoftwareGridView.hpp"
-#include "SoftwareItemWidget.hpp"
-#include "../model/SoftwareItem.hpp"
-#include <QScrollArea>
-#include <QGridLayout>
-#include <QLayoutItem>
+#include "SoftwareItemDelegate.hpp"
+#include "../model/SoftwareItemModel.hpp"
+#include <QListView>
+#include <QStyleOptionViewItem>
+#include <QVBoxLayout>
+#include <QMenu>
+#include <QAction>
+#include <QProcess>
+#include <QFileInfo>
+#include <QDir>
+#include <QMessageBox>
 #include "../utils/Logging.hpp"
 
-SoftwareGridView::SoftwareGridView(QWidget* parent)
+SoftwareGridView::SoftwareGridView(SoftwareItemModel* model, QWidget* parent)
     : QWidget(parent)
-    , m_scrollArea(nullptr)
-    , m_contentWidget(nullptr)
-    , m_gridLayout(nullptr)
+    , m_listView(nullptr)
+    , m_model(model)
+    , m_delegate(nullptr)
     , m_iconSize(64)
-    , m_columns(10)
 {
     setupUI();
 }
 
-void SoftwareGridView::addSoftwareItem(const SoftwareItem& item)
+void SoftwareGridView::setIconSize(int size)
 {
-    m_softwareItems.append(item);
-    updateLayout();
-    qCInfo(softwareManager) << "添加软件项到网格视图:" << item.getName();
+    m_iconSize = size;
+    m_model->setIconSize(QSize(size, size));
+    m_delegate->setIconSize(QSize(size, size));
+    m_listView->setIconSize(QSize(size, size));
+    updateGridSize();
+    qCInfo(softwareManager) << "设置网格视图图标大小:" << size;
 }
 
-void SoftwareGridView::removeSoftwareItem(const QString& id)
+int SoftwareGridView::iconSize() const
 {
-    // 查找并移除指定ID的软件项
-    for (auto it = m_softwareItems.begin(); it != m_softwareItems.end(); ++it) {
-        if (it->getId() == id) {
-            m_softwareItems.erase(it);
-            break;
-        }
-    }
-    
-    updateLayout();
-    qCInfo(softwareManager) << "从网格视图移除软件项:" << id;
+    return m_iconSize;
 }
 
-void SoftwareGridView::updateSoftwareItem(const SoftwareItem& item)
+void SoftwareGridView::onItemActivated(const QModelIndex& index)
 {
-    // 查找并更新指定ID的软件项
-    for (auto& softwareItem : m_softwareItems) {
-        if (softwareItem.getId() == item.getId()) {
-            softwareItem = item;
-            break;
-        }
+    QString softwareId = index.data(SoftwareItemModel::SoftwareIdRole).toString();
+    if (!softwareId.isEmpty()) {
+        emit softwareItemLaunched(softwareId);
     }
-    
-    updateLayout();
-    qCInfo(softwareManager) << "更新网格视图中的软件项:" << item.getName();
-}
-
-void SoftwareGridView::clearAllItems()
-{
-    m_softwareItems.clear();
-    m_softwareWidgets.clear();
-    updateLayout();
-    qCInfo(softwareManager) << "清空网格视图中的所有软件项";
-}
-
-void SoftwareGridView::setSoftwareItems(const QList<SoftwareItem>& items)
-{
-    m_softwareItems = items;
-    m_softwareWidgets.clear();
-    updateLayout();
-    qCInfo(softwareManager) << "设置网格视图软件项，共" << items.size() << "个";
-}
-
-void SoftwareGridView::setIconSize(int size)
-{
-    m_iconSize = size;
-    updateLayout();
-    qCInfo(softwareManager) << "设置网格视图图标大小:" << size;
 }
 
-int SoftwareGridView::iconSize() const
+void SoftwareGridView::onItemRightClicked(const QPoint& pos)
 {
-    return m_iconSize;
+    QModelIndex index = m_listView->indexAt(pos);
+    if (!index.isValid()) {
+        return;
+    }
+    
+    QString softwareId = index.data(SoftwareItemModel::SoftwareIdRole).toString();
+    QString filePath = index.data(SoftwareItemModel::FilePathRole).toString();
+    QString name = index.data(Qt::DisplayRole).toString();
+    
+    // 右键菜单按需创建，不再为每个软件项常驻一个菜单
+    QMenu contextMenu(this);
+    
+    QAction* launchAction = contextMenu.addAction("启动");
+    QAction* openLocationAction = contextMenu.addAction("打开文件位置");
+    contextMenu.addSeparator();
+    QAction* removeAction = contextMenu.addAction("从管理器移除");
+    QAction* propertiesAction = contextMenu.addAction("属性");
+    
+    // 连接动作
+    connect(launchAction, &QAction::triggered, [this, softwareId]() {
+        emit softwareItemLaunched(softwareId);
+    });
+    
+    connect(openLocationAction, &QAction::triggered, [this, filePath]() {
+        openFileLocation(filePath);
+    });
+    
+    connect(removeAction, &QAction::triggered, [this, softwareId, name]() {
+        int ret = QMessageBox::question(this, "确认",
+                                      QString("确定要从管理器中移除 \"%1\" 吗？\n(注意：这不会删除实际的软件文件)").arg(name));
+        if (ret == QMessageBox::Yes) {
+            emit softwareItemRemoved(softwareId);
+        }
+    });
+    
+    connect(propertiesAction, &QAction::triggered, [this, softwareId]() {
+        emit softwareItemPropertiesRequested(softwareId);
+    });
+    
+    // 显示菜单
+    contextMenu.exec(m_listView->viewport()->mapToGlobal(pos));
 }
 
 void SoftwareGridView::setupUI()
 {
-    // 创建滚动区域
-    m_scrollArea = new QScrollArea(this);
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_delegate = new SoftwareItemDelegate(this);
     
-    // 创建内容部件
-    m_contentWidget = new QWidget(m_scrollArea);
-    m_scrollArea->setWidget(m_contentWidget);
+    // 图标模式的列表视图：统一的单元格尺寸使布局不需要逐项计算
+    m_listView = new QListView(this);
+    m_listView->setViewMode(QListView::IconMode);
+    m_listView->setUniformItemSizes(true);
+    m_listView->setResizeMode(QListView::Adjust);
+    m_listView->setMovement(QListView::Static);
+    m_listView->setWrapping(true);
+    m_listView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_listView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_listView->setMouseTracking(true);
+    m_listView->setCursor(Qt::PointingHandCursor);
+    m_listView->setIconSize(QSize(m_iconSize, m_iconSize));
+    m_listView->setItemDelegate(m_delegate);
+    m_listView->setModel(m_model);
+    updateGridSize();
     
-    // 创建网格布局
-    m_gridLayout = new QGridLayout(m_contentWidget);
-    m_gridLayout->setAlignment(Qt::AlignTop | Qt::AlignLeft);
-    m_gridLayout->setSpacing(10);
-    m_gridLayout->setContentsMargins(10, 10, 10, 10);
+    // 启用上下文菜单
+    m_listView->setContextMenuPolicy(Qt::CustomContextMenu);
     
     // 设置主布局
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
-    mainLayout->addWidget(m_scrollArea);
+    mainLayout->addWidget(m_listView);
+    
+    // 连接信号槽
+    connect(m_listView, &QListView::activated,
+            this, &SoftwareGridView::onItemActivated);
+    connect(m_listView, &QListView::customContextMenuRequested,
+            this, &SoftwareGridView::onItemRightClicked);
 }
 
-void SoftwareGridView::updateLayout()
+void SoftwareGridView::updateGridSize()
 {
-    // 清除现有布局项
-    QLayoutItem* item;
-    while ((item = m_gridLayout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
-    }
-    
-    m_softwareWidgets.clear();
-    
-    // 重新添加软件项
-    int row = 0;
-    int col = 0;
+    // 固定的网格尺寸由委托的单元格尺寸加上间距得到，尺寸变化时视图自动重新布局
+    QStyleOptionViewItem option;
+    option.initFrom(m_listView);
+    QSize cellSize = m_delegate->sizeHint(option, QModelIndex());
+    m_listView->setGridSize(cellSize + QSize(10, 10));
+}
+
+void SoftwareGridView::openFileLocation(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
     
-    for (const SoftwareItem& item : m_softwareItems) {
-        // 创建软件项控件
-        SoftwareItemWidget* widget = new SoftwareItemWidget(item, this);
-        widget->setIconSize(QSize(m_iconSize, m_iconSize));
-        
-        // 连接信号
-        connect(widget, &SoftwareItemWidget::launchRequested, 
-                this, &SoftwareGridView::softwareItemLaunched);
-        connect(widget, &SoftwareItemWidget::removeRequested, 
-                this, &SoftwareGridView::softwareItemRemoved);
-        connect(widget, &SoftwareItemWidget::propertiesRequested, 
-                this, &SoftwareGridView::softwareItemPropertiesRequested);
-        
-        // 存储控件引用
-        m_softwareWidgets[item.getId()] = widget;
-        
-        m_gridLayout->addWidget(widget, row, col);
-        
-        // 更新行列位置
-        col++;
-        if (col >= m_columns) {
-            col = 0;
-            row++;
-        }
+    // 打开文件所在目录
+    QString dirPath = fileInfo.absolutePath();
+    if (QDir(dirPath).exists()) {
+#ifdef Q_OS_WIN
+        // Windows: 使用explorer打开并选中文件
+        QStringList args;
+        args << "/select," << QDir::toNativeSeparators(filePath);
+        QProcess::startDetached("explorer", args);
+#elif defined(Q_OS_MAC)
+        // macOS: 使用Finder打开并选中文件
+        QStringList args;
+        args << "-e" << "tell application \"Finder\"";
+        args << "-e" << "activate";
+        args << "-e" << QString("select POSIX file \"%1\"").arg(filePath);
+        args << "-e" << "end tell";
+        QProcess::startDetached("osascript", args);
+#else
+        // Linux: 打开文件所在目录
+        QProcess::startDetached("xdg-open", QStringList() << dirPath);
+#endif
+    } else {
+        QMessageBox::warning(this, "错误", "文件路径不存在");
     }
 }
\ No newline at end of file
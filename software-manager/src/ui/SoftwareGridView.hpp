@@ -2,26 +2,18 @@
 #define SOFTWAREGRIDVIEW_H
 
 #include <QWidget>
-#include <QList>
-#include <QMap>
-#include "../model/SoftwareItem.hpp"
 
-class QGridLayout;
-class QScrollArea;
-class SoftwareItemWidget;
+class QListView;
+class QModelIndex;
+class SoftwareItemModel;
+class SoftwareItemDelegate;
 
 class SoftwareGridView : public QWidget {
     Q_OBJECT
-
-public:
-    explicit SoftwareGridView(QWidget* parent = nullptr);
     
-    // 软件项管理方法
-    void addSoftwareItem(const SoftwareItem& item);
-    void removeSoftwareItem(const QString& id);
-    void updateSoftwareItem(const SoftwareItem& item);
-    void clearAllItems();
-    void setSoftwareItems(const QList<SoftwareItem>& items);
+public:
+    // 软件项由共享的模型提供，视图只负责显示和交互
+    explicit SoftwareGridView(SoftwareItemModel* model, QWidget* parent = nullptr);
     
     // 视图控制方法
     void setIconSize(int size);
@@ -33,19 +25,21 @@ signals:
     void softwareItemRemoved(const QString& softwareId);
     void softwareItemPropertiesRequested(const QString& softwareId);
     
+private slots:
+    void onItemActivated(const QModelIndex& index);
+    void onItemRightClicked(const QPoint& pos);
+    
 private:
     void setupUI();
-    void updateLayout();
-    
-    QScrollArea* m_scrollArea;
-    QWidget* m_contentWidget;
-    QGridLayout* m_gridLayout;
+    void updateGridSize();
+    void openFileLocation(const QString& filePath);
     
-    QList<SoftwareItem> m_softwareItems;
-    QMap<QString, SoftwareItemWidget*> m_softwareWidgets;
+    // 只为可见的单元格绘制，控件数量与软件项数量无关
+    QListView* m_listView;
+    SoftwareItemModel* m_model;
+    SoftwareItemDelegate* m_delegate;
     
     int m_iconSize;
-    int m_columns;
 };
 
 #endif // SOFTWAREGRIDVIEW_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "SoftwareItemDelegate.hpp"
+#include <QPainter>
+#include <QApplication>
+#include <QStyle>
+#include <QIcon>
+
+SoftwareItemDelegate::SoftwareItemDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+    , m_iconSize(64, 64)
+    , m_margin(5)
+    , m_spacing(5)
+{
+}
+
+void SoftwareItemDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    
+    // 绘制选中和悬停背景，不绘制默认的图标和文字
+    QStyle* style = opt.widget ? opt.widget->style() : QApplication::style();
+    opt.text.clear();
+    opt.icon = QIcon();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, opt.widget);
+    
+    const QRect contentRect = option.rect.adjusted(m_margin, m_margin, -m_margin, -m_margin);
+    
+    // 图标在上方居中
+    const QIcon icon = qvariant_cast<QIcon>(index.data(Qt::DecorationRole));
+    const QRect iconRect(contentRect.left() + (contentRect.width() - m_iconSize.width()) / 2,
+                         contentRect.top(), m_iconSize.width(), m_iconSize.height());
+    icon.paint(painter, iconRect, Qt::AlignCenter,
+               (option.state & QStyle::State_Selected) ? QIcon::Selected : QIcon::Normal);
+    
+    // 名称在图标下方，最多两行，超出部分省略
+    const QRect textRect(contentRect.left(), iconRect.bottom() + 1 + m_spacing,
+                         contentRect.width(), contentRect.bottom() - iconRect.bottom() - m_spacing);
+    const QString name = index.data(Qt::DisplayRole).toString();
+    const QFontMetrics fontMetrics = option.fontMetrics;
+    const int lineHeight = fontMetrics.height();
+    
+    QString firstLine = name;
+    QString secondLine;
+    if (fontMetrics.horizontalAdvance(name) > textRect.width()) {
+        // 按宽度找到第一行能容纳的字符数，剩余部分放到第二行
+        int length = name.length();
+        while (length > 1 && fontMetrics.horizontalAdvance(name.left(length)) > textRect.width()) {
+            --length;
+        }
+        firstLine = name.left(length);
+        secondLine = fontMetrics.elidedText(name.mid(length), Qt::ElideRight, textRect.width());
+    }
+    
+    painter->save();
+    painter->setPen(opt.palette.color(QPalette::Normal,
+                                      (option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text));
+    painter->drawText(QRect(textRect.left(), textRect.top(), textRect.width(), lineHeight),
+                      Qt::AlignHCenter | Qt::AlignTop, firstLine);
+    if (!secondLine.isEmpty()) {
+        painter->drawText(QRect(textRect.left(), textRect.top() + lineHeight, textRect.width(), lineHeight),
+                          Qt::AlignHCenter | Qt::AlignTop, secondLine);
+    }
+    painter->restore();
+}
+
+QSize SoftwareItemDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    
+    // 宽度至少容纳约八个汉字，高度为图标加两行文字
+    const QFontMetrics& fontMetrics = option.fontMetrics;
+    const int width = qMax(m_iconSize.width(), fontMetrics.horizontalAdvance(QChar(0x8F6F)) * 8) + 2 * m_margin;
+    const int height = m_iconSize.height() + m_spacing + 2 * fontMetrics.height() + 2 * m_margin;
+    return QSize(width, height);
+}
+
+void SoftwareItemDelegate::setIconSize(const QSize& size)
+{
+    m_iconSize = size;
+}
+
+QSize SoftwareItemDelegate::iconSize() const
+{
+    return m_iconSize;
+}
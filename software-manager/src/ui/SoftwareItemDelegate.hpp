@@ -0,0 +1,27 @@
+#ifndef SOFTWAREITEMDELEGATE_H
+#define SOFTWAREITEMDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QSize>
+
+// 网格视图中软件项的绘制：上方图标，下方省略显示的名称
+class SoftwareItemDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+    
+public:
+    explicit SoftwareItemDelegate(QObject* parent = nullptr);
+    
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    
+    // 所有软件项使用相同的尺寸，视图可以按统一尺寸布局
+    void setIconSize(const QSize& size);
+    QSize iconSize() const;
+    
+private:
+    QSize m_iconSize;
+    int m_margin;
+    int m_spacing;
+};
+
+#endif // SOFTWAREITEMDELEGATE_H
@@ -1,6 +1,7 @@
 #include "SoftwareListView.hpp"
-#include "../model/SoftwareItem.hpp"
-#include <QTableWidget>
+#include "../model/SoftwareItemModel.hpp"
+#include <QTableView>
+#include <QSortFilterProxyModel>
 #include <QHeaderView>
 #include <QMenu>
 #include <QAction>
@@ -10,82 +11,33 @@
 #include <QMessageBox>
 #include "../utils/Logging.hpp"
 
-SoftwareListView::SoftwareListView(QWidget* parent)
+SoftwareListView::SoftwareListView(SoftwareItemModel* model, QWidget* parent)
     : QWidget(parent)
-    , m_tableWidget(nullptr)
+    , m_tableView(nullptr)
+    , m_model(model)
+    , m_proxyModel(nullptr)
 {
     setupUI();
 }
 
-void SoftwareListView::addSoftwareItem(const SoftwareItem& item)
-{
-    m_softwareItems.append(item);
-    updateTable();
-    qCInfo(softwareManager) << "添加软件项到列表视图:" << item.getName();
-}
-
-void SoftwareListView::removeSoftwareItem(const QString& id)
-{
-    // 查找并移除指定ID的软件项
-    for (auto it = m_softwareItems.begin(); it != m_softwareItems.end(); ++it) {
-        if (it->getId() == id) {
-            m_softwareItems.erase(it);
-            break;
-        }
-    }
-    
-    updateTable();
-    qCInfo(softwareManager) << "从列表视图移除软件项:" << id;
-}
-
-void SoftwareListView::updateSoftwareItem(const SoftwareItem& item)
-{
-    // 查找并更新指定ID的软件项
-    for (auto& softwareItem : m_softwareItems) {
-        if (softwareItem.getId() == item.getId()) {
-            softwareItem = item;
-            break;
-        }
-    }
-    
-    updateTable();
-    qCInfo(softwareManager) << "更新列表视图中的软件项:" << item.getName();
-}
-
-void SoftwareListView::clearAllItems()
-{
-    m_softwareItems.clear();
-    m_softwareRowMap.clear();
-    updateTable();
-    qCInfo(softwareManager) << "清空列表视图中的所有软件项";
-}
-
-void SoftwareListView::setSoftwareItems(const QList<SoftwareItem>& items)
-{
-    m_softwareItems = items;
-    m_softwareRowMap.clear();
-    updateTable();
-    qCInfo(softwareManager) << "设置列表视图软件项，共" << items.size() << "个";
-}
-
 void SoftwareListView::setColumnWidth(int column, int width)
 {
-    if (m_tableWidget) {
-        m_tableWidget->setColumnWidth(column, width);
+    if (m_tableView) {
+        m_tableView->setColumnWidth(column, width);
     }
 }
 
 void SoftwareListView::setSortColumn(int column, Qt::SortOrder order)
 {
-    if (m_tableWidget) {
-        m_tableWidget->sortByColumn(column, order);
+    if (m_tableView) {
+        m_tableView->sortByColumn(column, order);
     }
 }
 
-void SoftwareListView::onItemDoubleClicked(QTableWidgetItem* item)
+void SoftwareListView::onItemDoubleClicked(const QModelIndex& index)
 {
-    if (item) {
-        QString softwareId = item->data(Qt::UserRole).toString();
+    if (index.isValid()) {
+        QString softwareId = index.data(SoftwareItemModel::SoftwareIdRole).toString();
         if (!softwareId.isEmpty()) {
             emit softwareItemLaunched(softwareId);
         }
@@ -94,9 +46,10 @@ void SoftwareListView::onItemDoubleClicked(QTableWidgetItem* item)
 
 void SoftwareListView::onItemRightClicked(const QPoint& pos)
 {
-    QTableWidgetItem* item = m_tableWidget->itemAt(pos);
-    if (item) {
-        QString softwareId = item->data(Qt::UserRole).toString();
+    QModelIndex index = m_tableView->indexAt(pos);
+    if (index.isValid()) {
+        QString softwareId = index.data(SoftwareItemModel::SoftwareIdRole).toString();
+        QString filePath = index.data(SoftwareItemModel::FilePathRole).toString();
         if (!softwareId.isEmpty()) {
             // 创建右键菜单
             QMenu contextMenu(this);
@@ -112,35 +65,28 @@ void SoftwareListView::onItemRightClicked(const QPoint& pos)
                 emit softwareItemLaunched(softwareId);
             });
             
-            connect(openLocationAction, &QAction::triggered, [this, softwareId]() {
-                // 查找对应的软件项
-                for (const SoftwareItem& item : m_softwareItems) {
-                    if (item.getId() == softwareId) {
-                        QString filePath = item.getFilePath();
-                        QFileInfo fileInfo(filePath);
-                        
-                        // 打开文件所在目录
-                        QString dirPath = fileInfo.absolutePath();
-                        if (QDir(dirPath).exists()) {
+            connect(openLocationAction, &QAction::triggered, [this, filePath]() {
+                QFileInfo fileInfo(filePath);
+                
+                // 打开文件所在目录
+                QString dirPath = fileInfo.absolutePath();
+                if (QDir(dirPath).exists()) {
 #ifdef Q_OS_WIN
-                            QStringList args;
-                            args << "/select," << QDir::toNativeSeparators(filePath);
-                            QProcess::startDetached("explorer", args);
+                    QStringList args;
+                    args << "/select," << QDir::toNativeSeparators(filePath);
+                    QProcess::startDetached("explorer", args);
 #elif defined(Q_OS_MAC)
-                            QStringList args;
-                            args << "-e" << "tell application \"Finder\"";
-                            args << "-e" << "activate";
-                            args << "-e" << QString("select POSIX file \"%1\"").arg(filePath);
-                            args << "-e" << "end tell";
-                            QProcess::startDetached("osascript", args);
+                    QStringList args;
+                    args << "-e" << "tell application \"Finder\"";
+                    args << "-e" << "activate";
+                    args << "-e" << QString("select POSIX file \"%1\"").arg(filePath);
+                    args << "-e" << "end tell";
+                    QProcess::startDetached("osascript", args);
 #else
-                            QProcess::startDetached("xdg-open", QStringList() << dirPath);
+                    QProcess::startDetached("xdg-open", QStringList() << dirPath);
 #endif
-                        } else {
-                            QMessageBox::warning(this, "错误", "文件路径不存在");
-                        }
-                        break;
-                    }
+                } else {
+                    QMessageBox::warning(this, "错误", "文件路径不存在");
                 }
             });
             
@@ -156,86 +102,50 @@ void SoftwareListView::onItemRightClicked(const QPoint& pos)
             });
             
             // 显示菜单
-            contextMenu.exec(m_tableWidget->viewport()->mapToGlobal(pos));
+            contextMenu.exec(m_tableView->viewport()->mapToGlobal(pos));
         }
     }
 }
 
 void SoftwareListView::setupUI()
 {
-    // 创建表格控件
-    m_tableWidget = new QTableWidget(this);
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    // 排序通过代理模型完成，不改变共享模型中的行顺序
+    m_proxyModel = new QSortFilterProxyModel(this);
+    m_proxyModel->setSourceModel(m_model);
     
-    // 设置列数和表头
-    m_tableWidget->setColumnCount(5);
-    QStringList headers;
-    headers << "名称" << "分类" << "路径" << "版本" << "描述";
-    m_tableWidget->setHorizontalHeaderLabels(headers);
+    // 创建表格视图，只为可见的行取数据
+    m_tableView = new QTableView(this);
+    m_tableView->setModel(m_proxyModel);
+    m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableView->setIconSize(QSize(20, 20));
+    m_tableView->setWordWrap(false);
     
     // 设置列宽
-    m_tableWidget->setColumnWidth(0, 200);  // 名称
-    m_tableWidget->setColumnWidth(1, 100);  // 分类
-    m_tableWidget->setColumnWidth(2, 300);  // 路径
-    m_tableWidget->setColumnWidth(3, 80);   // 版本
-    m_tableWidget->setColumnWidth(4, 200);  // 描述
+    m_tableView->setColumnWidth(SoftwareItemModel::NameColumn, 200);
+    m_tableView->setColumnWidth(SoftwareItemModel::CategoryColumn, 100);
+    m_tableView->setColumnWidth(SoftwareItemModel::PathColumn, 300);
+    m_tableView->setColumnWidth(SoftwareItemModel::VersionColumn, 80);
+    m_tableView->setColumnWidth(SoftwareItemModel::DescriptionColumn, 200);
     
-    // 设置表头行为
-    m_tableWidget->horizontalHeader()->setStretchLastSection(true);
-    m_tableWidget->verticalHeader()->setVisible(false);
+    // 设置表头行为：固定行高避免逐行测量
+    m_tableView->horizontalHeader()->setStretchLastSection(true);
+    m_tableView->verticalHeader()->setVisible(false);
+    m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_tableView->verticalHeader()->setDefaultSectionSize(24);
     
     // 启用上下文菜单
-    m_tableWidget->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_tableView->setContextMenuPolicy(Qt::CustomContextMenu);
     
     // 设置主布局
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
-    mainLayout->addWidget(m_tableWidget);
+    mainLayout->addWidget(m_tableView);
     
     // 连接信号槽
-    connect(m_tableWidget, &QTableWidget::itemDoubleClicked, 
+    connect(m_tableView, &QTableView::doubleClicked, 
             this, &SoftwareListView::onItemDoubleClicked);
-    connect(m_tableWidget, &QTableWidget::customContextMenuRequested, 
+    connect(m_tableView, &QTableView::customContextMenuRequested, 
             this, &SoftwareListView::onItemRightClicked);
-}
-
-void SoftwareListView::updateTable()
-{
-    if (!m_tableWidget) {
-        return;
-    }
-    
-    // 清空表格
-    m_tableWidget->setRowCount(0);
-    m_softwareRowMap.clear();
-    
-    // 设置行数
-    m_tableWidget->setRowCount(m_softwareItems.size());
-    
-    // 填充数据
-    for (int i = 0; i < m_softwareItems.size(); ++i) {
-        const SoftwareItem& item = m_softwareItems[i];
-        
-        // 存储行映射
-        m_softwareRowMap[item.getId()] = i;
-        
-        // 名称
-        QTableWidgetItem* nameItem = new QTableWidgetItem(item.getName());
-        nameItem->setData(Qt::UserRole, item.getId());
-        m_tableWidget->setItem(i, 0, nameItem);
-        
-        // 分类
-        m_tableWidget->setItem(i, 1, new QTableWidgetItem(item.getCategory()));
-        
-        // 路径
-        m_tableWidget->setItem(i, 2, new QTableWidgetItem(item.getFilePath()));
-        
-        // 版本
-        m_tableWidget->setItem(i, 3, new QTableWidgetItem(item.getVersion()));
-        
-        // 描述
-        m_tableWidget->setItem(i, 4, new QTableWidgetItem(item.getDescription()));
-    }
 }
\ No newline at end of file
@@ -2,26 +2,19 @@
 #define SOFTWARELISTVIEW_H
 
 #include <QWidget>
-#include <QList>
-#include <QMap>
 #include <QVBoxLayout>
-#include "../model/SoftwareItem.hpp"
 
-class QTableWidget;
-class QTableWidgetItem;
+class QTableView;
+class QSortFilterProxyModel;
+class QModelIndex;
+class SoftwareItemModel;
 
 class SoftwareListView : public QWidget {
     Q_OBJECT
 
 public:
-    explicit SoftwareListView(QWidget* parent = nullptr);
-    
-    // 软件项管理方法
-    void addSoftwareItem(const SoftwareItem& item);
-    void removeSoftwareItem(const QString& id);
-    void updateSoftwareItem(const SoftwareItem& item);
-    void clearAllItems();
-    void setSoftwareItems(const QList<SoftwareItem>& items);
+    // 与网格视图共享同一个模型，增删改只更新受影响的行
+    explicit SoftwareListView(SoftwareItemModel* model, QWidget* parent = nullptr);
     
     // 视图控制方法
     void setColumnWidth(int column, int width);
@@ -34,16 +27,15 @@ signals:
     void softwareItemPropertiesRequested(const QString& softwareId);
     
 private slots:
-    void onItemDoubleClicked(QTableWidgetItem* item);
+    void onItemDoubleClicked(const QModelIndex& index);
     void onItemRightClicked(const QPoint& pos);
     
 private:
     void setupUI();
-    void updateTable();
     
-    QTableWidget* m_tableWidget;
-    QList<SoftwareItem> m_softwareItems;
-    QMap<QString, int> m_softwareRowMap;
+    QTableView* m_tableView;
+    SoftwareItemModel* m_model;
+    QSortFilterProxyModel* m_proxyModel;
 };
 
 #endif // SOFTWARELISTVIEW_H
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include "DesktopEntryParser.hpp"
+#include <QFile>
+#include <QLocale>
+#include <cstring>
+#include "Logging.hpp"
+
+namespace {
+// 本地化键的当前最佳取值，只记录在映射内存中的位置
+struct LocalizedValue {
+    std::string_view value;
+    int rank = -1;
+};
+
+std::string_view trimmed(std::string_view text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// 处理值中的转义序列（\s \n \t \r \\）并转换为QString
+QString decodeValue(std::string_view value)
+{
+    if (value.find('\\') == std::string_view::npos) {
+        return QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+    }
+    
+    QByteArray decoded;
+    decoded.reserve(static_cast<qsizetype>(value.size()));
+    for (size_t i = 0; i < value.size(); ++i) {
+        char c = value[i];
+        if (c == '\\' && i + 1 < value.size()) {
+            switch (value[++i]) {
+            case 's': c = ' '; break;
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case 'r': c = '\r'; break;
+            case '\\': c = '\\'; break;
+            default:
+                // 未知转义保持原样（例如Exec中的引号转义留给execArguments处理）
+                decoded.append('\\');
+                c = value[i];
+                break;
+            }
+        }
+        decoded.append(c);
+    }
+    return QString::fromUtf8(decoded);
+}
+
+bool decodeBool(std::string_view value)
+{
+    return value == "true" || value == "1";
+}
+
+QStringList decodeList(std::string_view value)
+{
+    QStringList items;
+    while (!value.empty()) {
+        const size_t separator = value.find(';');
+        const std::string_view item = value.substr(0, separator);
+        if (!item.empty()) {
+            items << decodeValue(item);
+        }
+        if (separator == std::string_view::npos) {
+            break;
+        }
+        value.remove_prefix(separator + 1);
+    }
+    return items;
+}
+}
+
+bool DesktopEntry::isDisplayable() const
+{
+    return valid && type == "Application" && !noDisplay && !hidden && !name.isEmpty();
+}
+
+DesktopEntryParser::DesktopEntryParser(const QString& localeName)
+{
+    // 按规范的匹配顺序：lang_COUNTRY@MODIFIER、lang_COUNTRY、lang@MODIFIER、lang
+    QByteArray locale = (localeName.isEmpty() ? QLocale::system().name() : localeName).toUtf8();
+    
+    QByteArray modifier;
+    const int at = locale.indexOf('@');
+    if (at >= 0) {
+        modifier = locale.mid(at);
+        locale.truncate(at);
+    }
+    const int dot = locale.indexOf('.');
+    if (dot >= 0) {
+        locale.truncate(dot);
+    }
+    const int underscore = locale.indexOf('_');
+    const QByteArray language = underscore >= 0 ? locale.left(underscore) : locale;
+    
+    if (underscore >= 0) {
+        if (!modifier.isEmpty()) {
+            m_localeCandidates << locale + modifier;
+        }
+        m_localeCandidates << locale;
+    }
+    if (!modifier.isEmpty()) {
+        m_localeCandidates << language + modifier;
+    }
+    if (!language.isEmpty() && language != "C") {
+        m_localeCandidates << language;
+    }
+}
+
+DesktopEntry DesktopEntryParser::parseFile(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(softwareManager) << "无法打开桌面文件:" << filePath;
+        return DesktopEntry();
+    }
+    
+    const qint64 size = file.size();
+    if (size <= 0) {
+        return DesktopEntry();
+    }
+    
+    // 优先内存映射，无法映射时（例如特殊文件系统）读入内存
+    if (uchar* data = file.map(0, size)) {
+        DesktopEntry entry = parse(std::string_view(reinterpret_cast<const char*>(data), static_cast<size_t>(size)));
+        file.unmap(data);
+        return entry;
+    }
+    
+    const QByteArray content = file.readAll();
+    return parse(std::string_view(content.constData(), static_cast<size_t>(content.size())));
+}
+
+DesktopEntry DesktopEntryParser::parse(std::string_view data) const
+{
+    DesktopEntry entry;
+    LocalizedValue name;
+    LocalizedValue genericName;
+    LocalizedValue comment;
+    std::string_view type;
+    std::string_view exec;
+    std::string_view icon;
+    std::string_view categories;
+    bool inMainGroup = false;
+    
+    while (!data.empty()) {
+        const size_t lineEnd = data.find('\n');
+        std::string_view line = trimmed(data.substr(0, lineEnd));
+        data.remove_prefix(lineEnd == std::string_view::npos ? data.size() : lineEnd + 1);
+    
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+    
+        if (line.front() == '[') {
+            // [Desktop Entry]之后的组（如Desktop Action）不再需要，直接结束
+            if (inMainGroup) {
+                break;
+            }
+            inMainGroup = line == "[Desktop Entry]";
+            entry.valid = entry.valid || inMainGroup;
+            continue;
+        }
+    
+        if (!inMainGroup) {
+            continue;
+        }
+    
+        const size_t equals = line.find('=');
+        if (equals == std::string_view::npos) {
+            continue;
+        }
+        std::string_view key = trimmed(line.substr(0, equals));
+        const std::string_view value = trimmed(line.substr(equals + 1));
+    
+        // 拆出本地化后缀，例如Name[zh_CN]
+        std::string_view locale;
+        if (!key.empty() && key.back() == ']') {
+            const size_t bracket = key.find('[');
+            if (bracket == std::string_view::npos) {
+                continue;
+            }
+            locale = key.substr(bracket + 1, key.size() - bracket - 2);
+            key = key.substr(0, bracket);
+        }
+    
+        LocalizedValue* localized = nullptr;
+        if (key == "Name") {
+            localized = &name;
+        } else if (key == "GenericName") {
+            localized = &genericName;
+        } else if (key == "Comment") {
+            localized = &comment;
+        } else if (!locale.empty()) {
+            continue;
+        } else if (key == "Type") {
+            type = value;
+        } else if (key == "Exec") {
+            exec = value;
+        } else if (key == "Icon") {
+            icon = value;
+        } else if (key == "Categories") {
+            categories = value;
+        } else if (key == "NoDisplay") {
+            entry.noDisplay = decodeBool(value);
+        } else if (key == "Hidden") {
+            entry.hidden = decodeBool(value);
+        }
+    
+        if (localized) {
+            const int rank = localeRank(locale);
+            if (rank >= 0 && (localized->rank < 0 || rank < localized->rank)) {
+                localized->value = value;
+                localized->rank = rank;
+            }
+        }
+    }
+    
+    if (!entry.valid) {
+        return entry;
+    }
+    
+    // 只为最终保留的值生成QString
+    entry.type = decodeValue(type);
+    entry.name = decodeValue(name.value);
+    entry.genericName = decodeValue(genericName.value);
+    entry.comment = decodeValue(comment.value);
+    entry.exec = decodeValue(exec);
+    entry.icon = decodeValue(icon);
+    entry.categories = decodeList(categories);
+    return entry;
+}
+
+int DesktopEntryParser::localeRank(std::string_view locale) const
+{
+    // 未本地化的值优先级最低，不匹配的语言返回-1
+    if (locale.empty()) {
+        return static_cast<int>(m_localeCandidates.size());
+    }
+    
+    for (int i = 0; i < m_localeCandidates.size(); ++i) {
+        const QByteArray& candidate = m_localeCandidates.at(i);
+        if (locale == std::string_view(candidate.constData(), static_cast<size_t>(candidate.size()))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QString DesktopEntryParser::categoryFor(const QStringList& categories)
+{
+    // 按文件中声明的顺序取第一个能识别的分类
+    for (const QString& category : categories) {
+        if (category == "Office") {
+            return "办公软件";
+        }
+        if (category == "Development" || category == "IDE") {
+            return "开发工具";
+        }
+        if (category == "AudioVideo" || category == "Audio" || category == "Video" ||
+            category == "Game" || category == "Player") {
+            return "娱乐媒体";
+        }
+        if (category == "System" || category == "Settings" || category == "Utility") {
+            return "系统工具";
+        }
+    }
+    return "未分类";
+}
+
+QStringList DesktopEntryParser::execArguments(const QString& exec, const DesktopEntry& entry,
+                                              const QString& filePath)
+{
+    // 按规范拆分参数：空白分隔，双引号内\"、\`、\$、\\为转义
+    QStringList tokens;
+    QList<bool> quoted;
+    QString current;
+    bool inQuotes = false;
+    bool hasToken = false;
+    bool tokenQuoted = false;
+    
+    for (int i = 0; i < exec.size(); ++i) {
+        const QChar c = exec.at(i);
+        if (inQuotes) {
+            if (c == '\\' && i + 1 < exec.size()) {
+                current.append(exec.at(++i));
+            } else if (c == '"') {
+                inQuotes = false;
+            } else {
+                current.append(c);
+            }
+        } else if (c == '"') {
+            inQuotes = true;
+            hasToken = true;
+            tokenQuoted = true;
+        } else if (c == ' ' || c == '\t') {
+            if (hasToken) {
+                tokens << current;
+                quoted << tokenQuoted;
+                current.clear();
+                hasToken = false;
+                tokenQuoted = false;
+            }
+        } else {
+            current.append(c);
+            hasToken = true;
+        }
+    }
+    if (hasToken) {
+        tokens << current;
+        quoted << tokenQuoted;
+    }
+    
+    // 展开字段代码：文件和URL参数在直接启动时为空，%i、%c、%k按规范替换
+    QStringList arguments;
+    for (int i = 0; i < tokens.size(); ++i) {
+        const QString& token = tokens.at(i);
+    
+        if (!quoted.at(i) && token.size() == 2 && token.at(0) == '%') {
+            const QChar code = token.at(1);
+            if (code == 'i') {
+                if (!entry.icon.isEmpty()) {
+                    arguments << "--icon" << entry.icon;
+                }
+                continue;
+            }
+            if (QString("fFuUdDnNvm").contains(code)) {
+                continue;
+            }
+        }
+    
+        QString argument;
+        for (int j = 0; j < token.size(); ++j) {
+            if (token.at(j) != '%' || j + 1 >= token.size()) {
+                argument.append(token.at(j));
+                continue;
+            }
+    
+            const QChar code = token.at(++j);
+            if (code == '%') {
+                argument.append('%');
+            } else if (code == 'c') {
+                argument.append(entry.name);
+            } else if (code == 'k') {
+                argument.append(filePath);
+            }
+        }
+        arguments << argument;
+    }
+    
+    return arguments;
+}
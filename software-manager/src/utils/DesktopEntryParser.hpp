@@ -0,0 +1,51 @@
+#ifndef DESKTOPENTRYPARSER_H
+#define DESKTOPENTRYPARSER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+#include <string_view>
+
+// .desktop文件中[Desktop Entry]组的内容
+struct DesktopEntry {
+    bool valid = false;          // 是否包含[Desktop Entry]组
+    QString type;
+    QString name;
+    QString genericName;
+    QString comment;
+    QString exec;
+    QString icon;
+    QStringList categories;
+    bool noDisplay = false;
+    bool hidden = false;
+    
+    // 是否应作为软件显示（Type=Application且未被隐藏）
+    bool isDisplayable() const;
+};
+
+// .desktop文件解析器（freedesktop.org Desktop Entry规范）
+// 直接在内存映射的文件内容上扫描，只为需要的键生成QString
+class DesktopEntryParser {
+public:
+    // localeName形如"zh_CN"，用于选择本地化的键（如Name[zh_CN]）
+    explicit DesktopEntryParser(const QString& localeName = QString());
+    
+    DesktopEntry parseFile(const QString& filePath) const;
+    DesktopEntry parse(std::string_view data) const;
+    
+    // 把freedesktop分类映射到程序内置分类
+    static QString categoryFor(const QStringList& categories);
+    
+    // 把Exec值拆分为程序和参数，去除%f、%u等字段代码
+    static QStringList execArguments(const QString& exec, const DesktopEntry& entry = DesktopEntry(),
+                                     const QString& filePath = QString());
+    
+private:
+    // 按匹配优先级排列的本地化后缀，如"zh_CN"、"zh"
+    QList<QByteArray> m_localeCandidates;
+    
+    int localeRank(std::string_view locale) const;
+};
+
+#endif // DESKTOPENTRYPARSER_H
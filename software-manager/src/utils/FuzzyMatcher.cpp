@@ -0,0 +1,253 @@
+#include "FuzzyMatcher.hpp"
+#include <algorithm>
+
+namespace {
+
+// 得分参数与fzf保持一致
+const int ScoreMatch = 16;
+const int ScoreGapStart = -3;
+const int ScoreGapExtension = -1;
+const int BonusBoundary = ScoreMatch / 2;
+const int BonusBoundaryWhite = BonusBoundary + 2;
+const int BonusBoundaryDelimiter = BonusBoundary + 1;
+const int BonusNonWord = ScoreMatch / 2;
+const int BonusCamel = BonusBoundary + ScoreGapExtension;
+const int BonusConsecutive = -(ScoreGapStart + ScoreGapExtension);
+const int BonusFirstCharMultiplier = 2;
+
+// 不可达状态，足够小且加上若干罚分也不会溢出
+const int NoMatch = -(1 << 28);
+
+enum CharClass {
+    WhiteClass,
+    DelimiterClass,
+    NonWordClass,
+    LowerClass,
+    UpperClass,
+    NumberClass
+};
+
+CharClass classOf(QChar ch)
+{
+    if (ch.isSpace()) {
+        return WhiteClass;
+    }
+    if (ch == '/' || ch == '\\' || ch == '-' || ch == '_' || ch == '.' || ch == ':' || ch == ',' || ch == ';' || ch == '|') {
+        return DelimiterClass;
+    }
+    if (ch.isUpper()) {
+        return UpperClass;
+    }
+    if (ch.isDigit()) {
+        return NumberClass;
+    }
+    // 中文等没有大小写的文字按小写字母处理
+    if (ch.isLetterOrNumber()) {
+        return LowerClass;
+    }
+    return NonWordClass;
+}
+
+inline QChar foldCase(QChar ch)
+{
+    // ASCII走快速路径，其余字符查Unicode表
+    const ushort code = ch.unicode();
+    if (code < 0x80) {
+        return (code >= 'A' && code <= 'Z') ? QChar(ushort(code + 32)) : ch;
+    }
+    return ch.toLower();
+}
+
+inline int maskBit(QChar ch)
+{
+    const ushort code = ch.unicode();
+    if (code >= 'a' && code <= 'z') {
+        return code - 'a';
+    }
+    if (code >= '0' && code <= '9') {
+        return 26 + code - '0';
+    }
+    return 36 + code % 28;
+}
+
+}
+
+FuzzyMatcher::FuzzyMatcher(const QString& pattern)
+    : m_patternMask(0)
+{
+    // 关键字中的空白不参与匹配
+    m_pattern.reserve(pattern.size());
+    for (const QChar& ch : pattern) {
+        if (!ch.isSpace()) {
+            m_pattern.append(foldCase(ch));
+        }
+    }
+    m_patternMask = characterMask(m_pattern);
+}
+
+bool FuzzyMatcher::isEmpty() const
+{
+    return m_pattern.isEmpty();
+}
+
+QString FuzzyMatcher::pattern() const
+{
+    return m_pattern;
+}
+
+quint64 FuzzyMatcher::patternMask() const
+{
+    return m_patternMask;
+}
+
+int FuzzyMatcher::score(const QString& text) const
+{
+    return score(text, characterMask(text));
+}
+
+int FuzzyMatcher::score(const QString& text, quint64 textMask) const
+{
+    if (m_pattern.isEmpty()) {
+        return 0;
+    }
+    
+    if (!mayMatch(m_patternMask, textMask)) {
+        return -1;
+    }
+    
+    const int patternLength = m_pattern.length();
+    const int textLength = text.length();
+    if (patternLength > textLength) {
+        return -1;
+    }
+    
+    // 确认关键字是文本的子序列，同时找到第一个字符最早出现的位置
+    int start = -1;
+    int matched = 0;
+    for (int i = 0; i < textLength && matched < patternLength; ++i) {
+        if (foldCase(text.at(i)) == m_pattern.at(matched)) {
+            if (matched == 0) {
+                start = i;
+            }
+            ++matched;
+        }
+    }
+    if (matched < patternLength) {
+        return -1;
+    }
+    
+    // 最后一个字符最晚出现的位置，之后的文本不可能参与匹配
+    int end = textLength - 1;
+    while (foldCase(text.at(end)) != m_pattern.at(patternLength - 1)) {
+        --end;
+    }
+    
+    const int width = end - start + 1;
+    m_bonus.resize(width);
+    for (int j = 0; j < width; ++j) {
+        m_bonus[j] = bonusAt(text, start + j);
+    }
+    m_scores.fill(NoMatch, patternLength * width);
+    m_chunkBonus.fill(0, patternLength * width);
+    
+    // scores[i][j]：关键字前i+1个字符匹配完且第i个字符落在窗口位置j时的最高得分
+    for (int i = 0; i < patternLength; ++i) {
+        const QChar patternChar = m_pattern.at(i);
+        const int row = i * width;
+        const int previousRow = row - width;
+        
+        // 与上一行隔开至少一个字符时的最佳得分（已计入间隔罚分）
+        int gapScore = NoMatch;
+        
+        for (int j = 0; j < width; ++j) {
+            if (i > 0 && j >= 2) {
+                gapScore = std::max(gapScore + ScoreGapExtension, m_scores[previousRow + j - 2] + ScoreGapStart);
+            }
+            
+            if (foldCase(text.at(start + j)) != patternChar) {
+                continue;
+            }
+            
+            const int bonus = m_bonus[j];
+            int best = NoMatch;
+            int chunkBonus = bonus;
+            
+            if (i == 0) {
+                best = ScoreMatch + bonus * BonusFirstCharMultiplier;
+            } else {
+                if (gapScore > NoMatch / 2) {
+                    best = gapScore + ScoreMatch + bonus;
+                }
+                
+                // 连续匹配沿用这一段开头的加分，单词边界处开始新的一段
+                if (j >= 1 && m_scores[previousRow + j - 1] > NoMatch / 2) {
+                    int consecutiveBonus = std::max(m_chunkBonus[previousRow + j - 1], BonusConsecutive);
+                    if (bonus >= BonusBoundary && bonus > consecutiveBonus) {
+                        consecutiveBonus = bonus;
+                    }
+                    const int consecutive = m_scores[previousRow + j - 1] + ScoreMatch + std::max(bonus, consecutiveBonus);
+                    if (consecutive > best) {
+                        best = consecutive;
+                        chunkBonus = consecutiveBonus;
+                    }
+                }
+            }
+            
+            m_scores[row + j] = best;
+            m_chunkBonus[row + j] = chunkBonus;
+        }
+    }
+    
+    const int lastRow = (patternLength - 1) * width;
+    int result = NoMatch;
+    for (int j = 0; j < width; ++j) {
+        result = std::max(result, m_scores[lastRow + j]);
+    }
+    
+    // 匹配成立时得分可能因间隔过长而为负数，统一截断为0以区分不匹配
+    return result > NoMatch / 2 ? std::max(result, 0) : -1;
+}
+
+quint64 FuzzyMatcher::characterMask(const QString& text)
+{
+    quint64 mask = 0;
+    for (const QChar& ch : text) {
+        mask |= quint64(1) << maskBit(foldCase(ch));
+    }
+    return mask;
+}
+
+bool FuzzyMatcher::mayMatch(quint64 patternMask, quint64 textMask)
+{
+    return (patternMask & ~textMask) == 0;
+}
+
+int FuzzyMatcher::bonusAt(const QString& text, int position)
+{
+    const CharClass current = classOf(text.at(position));
+    const CharClass previous = position > 0 ? classOf(text.at(position - 1)) : WhiteClass;
+    
+    if (current == WhiteClass) {
+        return BonusBoundaryWhite;
+    }
+    if (current == DelimiterClass || current == NonWordClass) {
+        return BonusNonWord;
+    }
+    
+    // 单词开头：文本开头、空白、分隔符或其他符号之后
+    if (previous == WhiteClass) {
+        return BonusBoundaryWhite;
+    }
+    if (previous == DelimiterClass) {
+        return BonusBoundaryDelimiter;
+    }
+    if (previous == NonWordClass) {
+        return BonusBoundary;
+    }
+    
+    // 驼峰和字母后的数字
+    if ((previous == LowerClass && current == UpperClass) || (previous != NumberClass && current == NumberClass)) {
+        return BonusCamel;
+    }
+    return 0;
+}
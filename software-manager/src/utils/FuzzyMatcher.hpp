@@ -0,0 +1,39 @@
+#ifndef FUZZYMATCHER_H
+#define FUZZYMATCHER_H
+
+#include <QString>
+#include <QVector>
+
+// fzf风格的模糊匹配器：关键字的字符按顺序出现在文本中即可匹配（不区分大小写），
+// 落在单词开头、驼峰位置或连续出现的字符得分更高
+class FuzzyMatcher {
+public:
+    explicit FuzzyMatcher(const QString& pattern);
+    
+    bool isEmpty() const;
+    QString pattern() const;
+    quint64 patternMask() const;
+    
+    // 不匹配时返回-1，空关键字返回0；
+    // 打分复用内部缓冲区，同一个匹配器不能在多个线程中同时使用
+    int score(const QString& text) const;
+    int score(const QString& text, quint64 textMask) const;
+    
+    // 字符位图：小写字母和数字各占一位，其余字符散列到剩余的位上；
+    // 文本缺少关键字中的任何字符时，一次按位与即可排除
+    static quint64 characterMask(const QString& text);
+    static bool mayMatch(quint64 patternMask, quint64 textMask);
+    
+private:
+    QString m_pattern;
+    quint64 m_patternMask;
+    
+    // 动态规划的缓冲区，按关键字长度 x 匹配窗口宽度分配
+    mutable QVector<int> m_bonus;
+    mutable QVector<int> m_scores;
+    mutable QVector<int> m_chunkBonus;
+    
+    static int bonusAt(const QString& text, int position);
+};
+
+#endif // FUZZYMATCHER_H
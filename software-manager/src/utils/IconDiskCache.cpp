@@ -0,0 +1,344 @@
+#include "IconDiskCache.hpp"
+#include <QSqlError>
+#include <QFileInfo>
+#include <QDir>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QIcon>
+#include "Logging.hpp"
+
+IconDiskCache::IconDiskCache(const QString& cachePath, QObject* parent)
+    : QObject(parent)
+    , m_cachePath(cachePath)
+    , m_connectionName(QString("icon_cache_%1").arg(reinterpret_cast<quintptr>(this)))
+    , m_maxBytes(32 * 1024 * 1024)
+    , m_totalBytes(0)
+{
+    // 合并短时间内的写入，避免每个图标一个事务
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(2000);
+    connect(&m_flushTimer, &QTimer::timeout, this, &IconDiskCache::flush);
+}
+
+IconDiskCache::~IconDiskCache()
+{
+    close();
+}
+
+bool IconDiskCache::open()
+{
+    close();
+    
+    QDir().mkpath(QFileInfo(m_cachePath).absolutePath());
+    
+    // 使用独立的命名连接，不影响软件数据库的默认连接
+    m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_database.setDatabaseName(m_cachePath);
+    
+    if (!m_database.open()) {
+        qCWarning(softwareManager) << "无法打开图标缓存:" << m_database.lastError().text();
+        close();
+        return false;
+    }
+    
+    if (!createTables()) {
+        qCWarning(softwareManager) << "无法创建图标缓存表";
+        close();
+        return false;
+    }
+    
+    QSqlQuery query(m_database);
+    if (query.exec("SELECT COALESCE(SUM(bytes), 0) FROM icon_cache") && query.next()) {
+        m_totalBytes = query.value(0).toLongLong();
+    }
+    
+    m_findQuery = QSqlQuery(m_database);
+    m_findQuery.prepare("SELECT mtime, file_size, image FROM icon_cache WHERE source = ? AND pixel_size = ?");
+    
+    // 主题图标随主题变化，主题名称作为来源的一部分
+    m_themeName = QIcon::themeName();
+    
+    qCInfo(softwareManager) << "图标缓存已打开:" << m_cachePath << "大小:" << m_totalBytes;
+    return true;
+}
+
+bool IconDiskCache::isOpen() const
+{
+    return m_database.isValid() && m_database.isOpen();
+}
+
+void IconDiskCache::close()
+{
+    if (isOpen()) {
+        flush();
+    }
+    
+    m_flushTimer.stop();
+    m_pendingIcons.clear();
+    m_touchedIcons.clear();
+    m_findQuery = QSqlQuery();
+    
+    if (m_database.isValid()) {
+        m_database.close();
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+}
+
+QImage IconDiskCache::find(const QString& key, int pixelSize, const IconStamp& stamp)
+{
+    if (!isOpen() || key.isEmpty()) {
+        return QImage();
+    }
+    
+    const QString source = sourceFor(key);
+    m_findQuery.bindValue(0, source);
+    m_findQuery.bindValue(1, pixelSize);
+    
+    if (!m_findQuery.exec() || !m_findQuery.next()) {
+        return QImage();
+    }
+    
+    // 来源文件被修改过，旧的缩略图作废，等待重新加载后覆盖
+    if (m_findQuery.value(0).toLongLong() != stamp.modified ||
+        m_findQuery.value(1).toLongLong() != stamp.size) {
+        m_findQuery.finish();
+        return QImage();
+    }
+    
+    QImage image = QImage::fromData(m_findQuery.value(2).toByteArray(), "PNG");
+    m_findQuery.finish();
+    
+    if (!image.isNull()) {
+        m_touchedIcons.insert(qMakePair(source, pixelSize), QDateTime::currentMSecsSinceEpoch());
+        scheduleFlush();
+    }
+    
+    return image;
+}
+
+void IconDiskCache::insert(const QString& key, int pixelSize, const IconStamp& stamp, const QByteArray& png)
+{
+    if (!isOpen() || key.isEmpty() || png.isEmpty()) {
+        return;
+    }
+    
+    PendingIcon pending;
+    pending.source = sourceFor(key);
+    pending.pixelSize = pixelSize;
+    pending.stamp = stamp;
+    pending.png = png;
+    m_pendingIcons.append(pending);
+    
+    scheduleFlush();
+}
+
+bool IconDiskCache::flush()
+{
+    m_flushTimer.stop();
+    
+    if (!isOpen()) {
+        return false;
+    }
+    
+    if (m_pendingIcons.isEmpty() && m_touchedIcons.isEmpty()) {
+        return true;
+    }
+    
+    if (!m_database.transaction()) {
+        qCWarning(softwareManager) << "图标缓存无法开始事务:" << m_database.lastError().text();
+        return false;
+    }
+    
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    bool success = true;
+    
+    QSqlQuery insertQuery(m_database);
+    insertQuery.prepare("INSERT OR REPLACE INTO icon_cache (source, pixel_size, mtime, file_size, image, bytes, last_used) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?)");
+    for (const PendingIcon& pending : m_pendingIcons) {
+        insertQuery.addBindValue(pending.source);
+        insertQuery.addBindValue(pending.pixelSize);
+        insertQuery.addBindValue(pending.stamp.modified);
+        insertQuery.addBindValue(pending.stamp.size);
+        insertQuery.addBindValue(pending.png);
+        insertQuery.addBindValue(pending.png.size());
+        insertQuery.addBindValue(now);
+    
+        if (!insertQuery.exec()) {
+            qCWarning(softwareManager) << "写入图标缓存失败:" << insertQuery.lastError().text();
+            success = false;
+            break;
+        }
+    }
+    
+    QSqlQuery touchQuery(m_database);
+    touchQuery.prepare("UPDATE icon_cache SET last_used = ? WHERE source = ? AND pixel_size = ?");
+    for (auto it = m_touchedIcons.constBegin(); success && it != m_touchedIcons.constEnd(); ++it) {
+        touchQuery.addBindValue(it.value());
+        touchQuery.addBindValue(it.key().first);
+        touchQuery.addBindValue(it.key().second);
+    
+        if (!touchQuery.exec()) {
+            qCWarning(softwareManager) << "更新图标缓存使用时间失败:" << touchQuery.lastError().text();
+            success = false;
+        }
+    }
+    
+    if (success) {
+        success = evictIfNeeded();
+    }
+    
+    if (success && m_database.commit()) {
+        m_pendingIcons.clear();
+        m_touchedIcons.clear();
+        return true;
+    }
+    
+    m_database.rollback();
+    
+    // 缓存写入失败不影响显示，丢弃本批数据即可
+    m_pendingIcons.clear();
+    m_touchedIcons.clear();
+    return false;
+}
+
+bool IconDiskCache::clear()
+{
+    m_pendingIcons.clear();
+    m_touchedIcons.clear();
+    
+    if (!isOpen()) {
+        return false;
+    }
+    
+    QSqlQuery query(m_database);
+    if (!query.exec("DELETE FROM icon_cache")) {
+        qCWarning(softwareManager) << "清空图标缓存失败:" << query.lastError().text();
+        return false;
+    }
+    
+    m_totalBytes = 0;
+    return true;
+}
+
+void IconDiskCache::setMaxBytes(qint64 maxBytes)
+{
+    m_maxBytes = maxBytes;
+}
+
+qint64 IconDiskCache::maxBytes() const
+{
+    return m_maxBytes;
+}
+
+qint64 IconDiskCache::totalBytes() const
+{
+    return m_totalBytes;
+}
+
+QString IconDiskCache::defaultCachePath()
+{
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return dataPath + "/icon_cache.db";
+}
+
+IconStamp IconDiskCache::stampFor(const QString& key)
+{
+    IconStamp stamp;
+    QFileInfo fileInfo(key);
+    
+    if (fileInfo.isAbsolute() && fileInfo.exists()) {
+        stamp.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+        stamp.size = fileInfo.size();
+    }
+    
+    return stamp;
+}
+
+QString IconDiskCache::sourceFor(const QString& key) const
+{
+    if (QFileInfo(key).isAbsolute()) {
+        return key;
+    }
+    return QString("theme:%1/%2").arg(m_themeName, key);
+}
+
+bool IconDiskCache::createTables()
+{
+    QSqlQuery query(m_database);
+    
+    // 缓存数据可以重建，不需要完整的持久性保证
+    query.exec("PRAGMA journal_mode = WAL");
+    query.exec("PRAGMA synchronous = NORMAL");
+    
+    if (!query.exec("CREATE TABLE IF NOT EXISTS icon_cache ("
+                    "source TEXT NOT NULL, "
+                    "pixel_size INTEGER NOT NULL, "
+                    "mtime INTEGER NOT NULL, "
+                    "file_size INTEGER NOT NULL, "
+                    "image BLOB NOT NULL, "
+                    "bytes INTEGER NOT NULL, "
+                    "last_used INTEGER NOT NULL, "
+                    "PRIMARY KEY (source, pixel_size))")) {
+        qCWarning(softwareManager) << "创建图标缓存表失败:" << query.lastError().text();
+        return false;
+    }
+    
+    if (!query.exec("CREATE INDEX IF NOT EXISTS idx_icon_cache_last_used ON icon_cache(last_used)")) {
+        qCWarning(softwareManager) << "创建图标缓存索引失败:" << query.lastError().text();
+        return false;
+    }
+    
+    return true;
+}
+
+bool IconDiskCache::evictIfNeeded()
+{
+    QSqlQuery query(m_database);
+    if (!query.exec("SELECT COALESCE(SUM(bytes), 0) FROM icon_cache") || !query.next()) {
+        qCWarning(softwareManager) << "统计图标缓存大小失败:" << query.lastError().text();
+        return false;
+    }
+    m_totalBytes = query.value(0).toLongLong();
+    
+    if (m_totalBytes <= m_maxBytes) {
+        return true;
+    }
+    
+    // 淘汰到上限的90%，避免之后每次写入都触发淘汰。同一次flush写入的条目last_used相同，
+    // 按主键逐条删除并以rowid区分先后（INSERT OR REPLACE会分配新的rowid），不会整批删掉刚写入的图标
+    const qint64 target = m_maxBytes / 10 * 9;
+    qint64 remaining = m_totalBytes;
+    QVariantList rowIds;
+    
+    if (!query.exec("SELECT rowid, bytes FROM icon_cache ORDER BY last_used, rowid")) {
+        qCWarning(softwareManager) << "查询图标缓存失败:" << query.lastError().text();
+        return false;
+    }
+    while (remaining > target && query.next()) {
+        rowIds.append(query.value(0));
+        remaining -= query.value(1).toLongLong();
+    }
+    query.finish();
+    
+    QSqlQuery deleteQuery(m_database);
+    deleteQuery.prepare("DELETE FROM icon_cache WHERE rowid = ?");
+    deleteQuery.addBindValue(rowIds);
+    if (!deleteQuery.execBatch()) {
+        qCWarning(softwareManager) << "淘汰图标缓存失败:" << deleteQuery.lastError().text();
+        return false;
+    }
+    
+    qCInfo(softwareManager) << "图标缓存淘汰条目:" << rowIds.size();
+    
+    m_totalBytes = remaining;
+    return true;
+}
+
+void IconDiskCache::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef ICONDISKCACHE_H
+#define ICONDISKCACHE_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QImage>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QTimer>
+
+// 图标来源文件的修改时间和大小，主题图标没有来源文件，两项均为0
+struct IconStamp {
+    qint64 modified = 0;
+    qint64 size = 0;
+};
+
+// 持久化的图标缩略图缓存：按来源、修改时间和像素尺寸保存栅格化后的PNG，
+// 启动时无需重新解析图标即可显示。只能在创建它的线程中使用。
+class IconDiskCache : public QObject {
+    Q_OBJECT
+    
+public:
+    explicit IconDiskCache(const QString& cachePath, QObject* parent = nullptr);
+    ~IconDiskCache();
+    
+    bool open();
+    bool isOpen() const;
+    void close();
+    
+    // 查找缓存的图标，来源文件已变化时视为未命中
+    QImage find(const QString& key, int pixelSize, const IconStamp& stamp);
+    
+    // 写入先放在内存中，由定时器合并到一个事务里提交
+    void insert(const QString& key, int pixelSize, const IconStamp& stamp, const QByteArray& png);
+    bool flush();
+    bool clear();
+    
+    // 缓存总大小上限，超出后按最近使用时间淘汰
+    void setMaxBytes(qint64 maxBytes);
+    qint64 maxBytes() const;
+    qint64 totalBytes() const;
+    
+    // 与software.db放在同一目录
+    static QString defaultCachePath();
+    
+    // 读取来源文件的时间戳（只访问文件系统，可在工作线程调用）
+    static IconStamp stampFor(const QString& key);
+    
+private:
+    struct PendingIcon {
+        QString source;
+        int pixelSize;
+        IconStamp stamp;
+        QByteArray png;
+    };
+    
+    QString m_cachePath;
+    QString m_connectionName;
+    QString m_themeName;
+    QSqlDatabase m_database;
+    QSqlQuery m_findQuery;
+    QTimer m_flushTimer;
+    qint64 m_maxBytes;
+    qint64 m_totalBytes;
+    
+    QList<PendingIcon> m_pendingIcons;
+    QHash<QPair<QString, int>, qint64> m_touchedIcons;
+    
+    QString sourceFor(const QString& key) const;
+    bool createTables();
+    bool evictIfNeeded();
+    void scheduleFlush();
+};
+
+#endif // ICONDISKCACHE_H
@@ -3,14 +3,303 @@
 #include <QFileInfo>
 #include <QApplication>
 #include <QStyle>
+#include <QImageReader>
+#include <QPixmap>
+#include <QBuffer>
+#include <QRunnable>
+#include <QThread>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <limits>
 #include "Logging.hpp"
 
+#ifdef Q_OS_WIN
+#include <qt_windows.h>
+#include <shellapi.h>
+#include <objbase.h>
+#endif
+
+namespace {
+// 可以直接解码的图片文件
+bool isImageFile(const QFileInfo& fileInfo)
+{
+    return fileInfo.isAbsolute() &&
+           QImageReader::supportedImageFormats().contains(fileInfo.suffix().toLower().toUtf8());
+}
+
+// 按目标尺寸等比例解码，只用到QImageReader和QImage，可以在任何线程中执行
+QImage decodeImage(const QString& filePath, const QSize& size)
+{
+    QImageReader reader(filePath);
+    QSize imageSize = reader.size();
+    if (imageSize.isValid()) {
+        imageSize.scale(size, Qt::KeepAspectRatio);
+        reader.setScaledSize(imageSize);
+    }
+    return reader.read();
+}
+
+// index.theme中的一个图标目录
+struct ThemeDirectory {
+    enum Type { Fixed, Scalable, Threshold };
+    
+    QString path;
+    Type type = Threshold;
+    int size = 0;
+    int minSize = 0;
+    int maxSize = 0;
+    int threshold = 2;
+    
+    bool matchesSize(int iconSize) const
+    {
+        switch (type) {
+        case Fixed:
+            return iconSize == size;
+        case Scalable:
+            return iconSize >= minSize && iconSize <= maxSize;
+        case Threshold:
+            return iconSize >= size - threshold && iconSize <= size + threshold;
+        }
+        return false;
+    }
+    
+    int sizeDistance(int iconSize) const
+    {
+        int low = size;
+        int high = size;
+        if (type == Scalable) {
+            low = minSize;
+            high = maxSize;
+        } else if (type == Threshold) {
+            low = size - threshold;
+            high = size + threshold;
+        }
+        if (iconSize < low) {
+            return low - iconSize;
+        }
+        return iconSize > high ? iconSize - high : 0;
+    }
+};
+
+// 一个图标主题：各搜索路径下的主题目录、继承的主题和图标目录
+struct ThemeIndex {
+    QStringList baseDirs;
+    QStringList inherits;
+    QList<ThemeDirectory> directories;
+};
+
+ThemeIndex readThemeIndex(const QString& themeName, const QStringList& searchPaths)
+{
+    ThemeIndex index;
+    QString indexPath;
+    for (const QString& searchPath : searchPaths) {
+        const QString baseDir = searchPath + "/" + themeName;
+        if (!QFileInfo(baseDir).isDir()) {
+            continue;
+        }
+        index.baseDirs.append(baseDir);
+        if (indexPath.isEmpty() && QFile::exists(baseDir + "/index.theme")) {
+            indexPath = baseDir + "/index.theme";
+        }
+    }
+    
+    QFile file(indexPath);
+    if (indexPath.isEmpty() || !file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return index;
+    }
+    
+    QHash<QString, QHash<QString, QString>> groups;
+    QString group;
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        if (line.startsWith('[') && line.endsWith(']')) {
+            group = line.mid(1, line.size() - 2);
+            continue;
+        }
+        const int equals = line.indexOf('=');
+        if (equals > 0) {
+            groups[group].insert(line.left(equals).trimmed(), line.mid(equals + 1).trimmed());
+        }
+    }
+    
+    const QHash<QString, QString> theme = groups.value("Icon Theme");
+    index.inherits = theme.value("Inherits").split(',', Qt::SkipEmptyParts);
+    for (const QString& path : theme.value("Directories").split(',', Qt::SkipEmptyParts)) {
+        const QHash<QString, QString> entry = groups.value(path);
+        ThemeDirectory directory;
+        directory.path = path;
+        directory.size = entry.value("Size").toInt();
+        directory.minSize = entry.value("MinSize", entry.value("Size")).toInt();
+        directory.maxSize = entry.value("MaxSize", entry.value("Size")).toInt();
+        directory.threshold = entry.value("Threshold", "2").toInt();
+        const QString type = entry.value("Type", "Threshold");
+        if (type == "Fixed") {
+            directory.type = ThemeDirectory::Fixed;
+        } else if (type == "Scalable") {
+            directory.type = ThemeDirectory::Scalable;
+        }
+        if (directory.size > 0) {
+            index.directories.append(directory);
+        }
+    }
+    return index;
+}
+
+// 解析过的index.theme，多个工作线程共享
+ThemeIndex cachedThemeIndex(const QString& themeName, const QStringList& searchPaths)
+{
+    static QMutex mutex;
+    static QHash<QString, ThemeIndex> cache;
+    
+    const QString key = searchPaths.join('\n') + '\n' + themeName;
+    QMutexLocker locker(&mutex);
+    auto it = cache.constFind(key);
+    if (it == cache.constEnd()) {
+        it = cache.insert(key, readThemeIndex(themeName, searchPaths));
+    }
+    return *it;
+}
+
+// 主题目录中可以由QImageReader解码的图标格式
+const QStringList& themeIconSuffixes()
+{
+    static const QStringList suffixes = []() {
+        QStringList result;
+        const QList<QByteArray> formats = QImageReader::supportedImageFormats();
+        for (const char* suffix : {"png", "svg", "xpm"}) {
+            if (formats.contains(suffix)) {
+                result.append(QString::fromLatin1(suffix));
+            }
+        }
+        return result;
+    }();
+    return suffixes;
+}
+
+QString findInDirectory(const QString& directory, const QString& iconName)
+{
+    for (const QString& suffix : themeIconSuffixes()) {
+        const QString filePath = directory + "/" + iconName + "." + suffix;
+        if (QFile::exists(filePath)) {
+            return filePath;
+        }
+    }
+    return QString();
+}
+
+// 先找尺寸匹配的目录，再找尺寸最接近的目录
+QString lookupThemeIcon(const QString& iconName, int size, const ThemeIndex& index)
+{
+    for (const ThemeDirectory& directory : index.directories) {
+        if (!directory.matchesSize(size)) {
+            continue;
+        }
+        for (const QString& baseDir : index.baseDirs) {
+            const QString filePath = findInDirectory(baseDir + "/" + directory.path, iconName);
+            if (!filePath.isEmpty()) {
+                return filePath;
+            }
+        }
+    }
+    
+    QString closest;
+    int closestDistance = std::numeric_limits<int>::max();
+    for (const ThemeDirectory& directory : index.directories) {
+        const int distance = directory.sizeDistance(size);
+        if (distance >= closestDistance) {
+            continue;
+        }
+        for (const QString& baseDir : index.baseDirs) {
+            const QString filePath = findInDirectory(baseDir + "/" + directory.path, iconName);
+            if (!filePath.isEmpty()) {
+                closest = filePath;
+                closestDistance = distance;
+                break;
+            }
+        }
+    }
+    return closest;
+}
+}
+
+// 在线程池中加载单个图标，结果以排队调用交回GUI线程
+class IconLoadTask : public QRunnable {
+public:
+    IconLoadTask(IconExtractor* extractor, const QString& filePath, const QSize& size, bool encodePng,
+                 const IconExtractor::ThemeSearch& themeSearch)
+        : m_extractor(extractor)
+        , m_filePath(filePath)
+        , m_size(size)
+        , m_encodePng(encodePng)
+        , m_themeSearch(themeSearch)
+    {
+    }
+    
+    void run() override
+    {
+        // 先记录时间戳再加载，加载期间文件被修改时缓存会在下次启动时失效
+        const IconStamp stamp = m_encodePng ? IconDiskCache::stampFor(m_filePath) : IconStamp();
+        const QImage image = isImageFile(QFileInfo(m_filePath))
+                                 ? IconExtractor::renderIcon(m_filePath, m_size)
+                                 : IconExtractor::renderSystemIcon(m_filePath, m_size, m_themeSearch);
+        
+        // 磁盘缓存的PNG编码也在工作线程完成
+        QByteArray png;
+        if (m_encodePng && !image.isNull()) {
+            QBuffer buffer(&png);
+            buffer.open(QIODevice::WriteOnly);
+            image.save(&buffer, "PNG");
+        }
+        
+        // IconExtractor析构时会等待线程池结束，此时指针仍然有效
+        IconExtractor* extractor = m_extractor;
+        const QString filePath = m_filePath;
+        const int pixelSize = qMax(m_size.width(), m_size.height());
+        QMetaObject::invokeMethod(extractor, [extractor, filePath, image, pixelSize, stamp, png]() {
+            extractor->onIconLoaded(filePath, image, pixelSize, stamp, png);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    IconExtractor* m_extractor;
+    QString m_filePath;
+    QSize m_size;
+    bool m_encodePng;
+    IconExtractor::ThemeSearch m_themeSearch;
+};
+
 IconExtractor::IconExtractor(QObject* parent)
     : QObject(parent)
-    , m_threadPool(QThreadPool::globalInstance())
-    , m_maxCacheSize(100)
+    , m_threadPool(new QThreadPool(this))
+    , m_diskCache(nullptr)
+    , m_maxCacheSize(1000)
 {
     m_iconCache.setMaxCost(m_maxCacheSize);
+    
+    // 图标解码以磁盘IO为主，少量线程即可，避免占满全局线程池
+    m_threadPool->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+}
+
+IconExtractor::~IconExtractor()
+{
+    m_threadPool->clear();
+    m_threadPool->waitForDone();
+    
+    // 提交尚未写入的缩略图
+    if (m_diskCache) {
+        m_diskCache->flush();
+    }
+}
+
+IconExtractor* IconExtractor::instance()
+{
+    // 随应用程序对象一起销毁
+    static IconExtractor* extractor = new IconExtractor(QCoreApplication::instance());
+    return extractor;
 }
 
 QIcon IconExtractor::extractIcon(const QString& filePath)
@@ -23,22 +312,96 @@ QIcon IconExtractor::extractIcon(const QString& filePath)
     // 加载图标
     QIcon icon = loadIconFromFile(filePath);
     
-    // 添加到缓存
-    if (!icon.isNull()) {
-        m_iconCache.insert(filePath, new QIcon(icon));
-    }
+    // 添加到缓存（包括默认图标，避免对缺失的文件反复查找）
+    m_iconCache.insert(filePath, new QIcon(icon));
     
     return icon;
 }
 
 void IconExtractor::extractIconAsync(const QString& filePath, QObject* receiver, const char* member)
 {
-    Q_UNUSED(filePath)
-    Q_UNUSED(receiver)
-    Q_UNUSED(member)
+    if (!receiver || !member) {
+        return;
+    }
+    
+    // 接受SLOT()宏或方法名，调用时只需要方法名
+    QByteArray method(member);
+    if (!method.isEmpty() && method.at(0) >= '0' && method.at(0) <= '9') {
+        method.remove(0, 1);
+    }
+    const int parenthesis = method.indexOf('(');
+    if (parenthesis >= 0) {
+        method.truncate(parenthesis);
+    }
+    
+    if (m_iconCache.contains(filePath)) {
+        notifyReceiver(receiver, method, filePath, *m_iconCache.object(filePath));
+        return;
+    }
+    
+    // 磁盘缓存命中时同样立即可用
+    const QIcon icon = requestIcon(filePath, QSize(64, 64));
+    if (!icon.isNull()) {
+        notifyReceiver(receiver, method, filePath, icon);
+        return;
+    }
+    
+    m_waitingReceivers[filePath].append(qMakePair(QPointer<QObject>(receiver), method));
+}
+
+QIcon IconExtractor::cachedIcon(const QString& filePath) const
+{
+    QIcon* icon = m_iconCache.object(filePath);
+    return icon ? *icon : QIcon();
+}
+
+QIcon IconExtractor::requestIcon(const QString& filePath, const QSize& size)
+{
+    // 已缓存或正在加载的图标不重复提交
+    if (QIcon* icon = m_iconCache.object(filePath)) {
+        return *icon;
+    }
+    if (m_pendingIcons.contains(filePath)) {
+        return QIcon();
+    }
+    
+    // 磁盘缓存命中时同步返回，冷启动的第一帧即可显示完整图标
+    if (m_diskCache) {
+        const QImage image = m_diskCache->find(filePath, qMax(size.width(), size.height()),
+                                               IconDiskCache::stampFor(filePath));
+        if (!image.isNull()) {
+            QIcon icon(QPixmap::fromImage(image));
+            m_iconCache.insert(filePath, new QIcon(icon));
+            return icon;
+        }
+    }
+    
+    // 图片文件、主题图标和Windows上的文件图标在线程池中解析；
+    // 其余来源（其他平台的系统文件图标）依赖平台图标引擎，仍在GUI线程中解析
+    if (!canRenderOffThread(filePath)) {
+        return resolveSystemIcon(filePath, size);
+    }
     
-    // 异步图标加载实现
-    // 需要创建IconLoadTask类来处理异步加载
+    const ThemeSearch themeSearch = isImageFile(QFileInfo(filePath)) ? ThemeSearch() : currentThemeSearch();
+    m_pendingIcons.insert(filePath);
+    m_threadPool->start(new IconLoadTask(this, filePath, size, m_diskCache != nullptr, themeSearch));
+    return QIcon();
+}
+
+bool IconExtractor::canRenderOffThread(const QString& filePath) const
+{
+    const QFileInfo fileInfo(filePath);
+    if (filePath.isEmpty()) {
+        return false;
+    }
+    if (isImageFile(fileInfo) || !fileInfo.isAbsolute()) {
+        return true;
+    }
+#ifdef Q_OS_WIN
+    return fileInfo.exists();
+#else
+    return false;
+#endif
 }
 
 void IconExtractor::setCacheSize(int size)
@@ -52,15 +415,140 @@ void IconExtractor::clearCache()
     m_iconCache.clear();
 }
 
-QIcon IconExtractor::loadIconFromFile(const QString& filePath)
+bool IconExtractor::enableDiskCache(const QString& cachePath)
 {
-    if (filePath.isEmpty() || !QFile::exists(filePath)) {
-        return QIcon();
+    delete m_diskCache;
+    m_diskCache = new IconDiskCache(cachePath, this);
+    
+    if (!m_diskCache->open()) {
+        // 没有磁盘缓存时仍可正常加载图标
+        qCWarning(softwareManager) << "图标磁盘缓存不可用:" << cachePath;
+        delete m_diskCache;
+        m_diskCache = nullptr;
+        return false;
+    }
+    
+    return true;
+}
+
+IconDiskCache* IconExtractor::diskCache() const
+{
+    return m_diskCache;
+}
+
+QImage IconExtractor::renderIcon(const QString& filePath, const QSize& size)
+{
+    QFileInfo fileInfo(filePath);
+    
+    if (filePath.isEmpty() || !isImageFile(fileInfo) || !fileInfo.exists()) {
+        return QImage();
+    }
+    
+    return decodeImage(filePath, size);
+}
+
+IconExtractor::ThemeSearch IconExtractor::currentThemeSearch()
+{
+    // QIcon的主题设置只能在GUI线程中读取
+    ThemeSearch search;
+    search.themeName = QIcon::themeName().isEmpty() ? QString("hicolor") : QIcon::themeName();
+    search.searchPaths = QIcon::themeSearchPaths();
+    search.fallbackPaths = QIcon::fallbackSearchPaths();
+    return search;
+}
+
+QString IconExtractor::findThemeIconFile(const QString& iconName, int size, const ThemeSearch& search)
+{
+    if (iconName.isEmpty()) {
+        return QString();
+    }
+    
+    // 依次查找当前主题和它继承的主题，最后是hicolor
+    QStringList pending;
+    pending << search.themeName << "hicolor";
+    QSet<QString> visited;
+    while (!pending.isEmpty()) {
+        const QString themeName = pending.takeFirst();
+        if (themeName.isEmpty() || visited.contains(themeName)) {
+            continue;
+        }
+        visited.insert(themeName);
+        
+        const ThemeIndex index = cachedThemeIndex(themeName, search.searchPaths);
+        const QString filePath = lookupThemeIcon(iconName, size, index);
+        if (!filePath.isEmpty()) {
+            return filePath;
+        }
+        
+        // 继承的主题排在hicolor之前
+        for (int i = index.inherits.size() - 1; i >= 0; --i) {
+            pending.prepend(index.inherits.at(i).trimmed());
+        }
+    }
+    
+    // 不属于任何主题的图标（如/usr/share/pixmaps）
+    for (const QString& fallbackPath : search.fallbackPaths) {
+        const QString filePath = findInDirectory(fallbackPath, iconName);
+        if (!filePath.isEmpty()) {
+            return filePath;
+        }
+    }
+    
+    return QString();
+}
+
+QImage IconExtractor::renderSystemIcon(const QString& filePath, const QSize& size, const ThemeSearch& search)
+{
+    QFileInfo fileInfo(filePath);
+    if (filePath.isEmpty()) {
+        return QImage();
+    }
+    
+    // 主题图标名称先解析为文件，再像图片文件一样解码
+    if (!fileInfo.isAbsolute()) {
+        const QString iconFile = findThemeIconFile(filePath, qMax(size.width(), size.height()), search);
+        return iconFile.isEmpty() ? QImage() : decodeImage(iconFile, size);
     }
+
+#ifdef Q_OS_WIN
+    // SHGetFileInfo要求调用线程已初始化COM，HICON转换为QImage后即可释放
+    if (fileInfo.exists()) {
+        const HRESULT initialized = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+        const UINT flags = SHGFI_ICON | (qMax(size.width(), size.height()) > 16 ? SHGFI_LARGEICON : SHGFI_SMALLICON);
+        const QString nativePath = QDir::toNativeSeparators(fileInfo.absoluteFilePath());
+        SHFILEINFOW info = {};
+        QImage image;
+        if (SHGetFileInfoW(reinterpret_cast<const wchar_t*>(nativePath.utf16()), 0, &info, sizeof(info), flags) &&
+            info.hIcon) {
+            image = QImage::fromHICON(info.hIcon);
+            DestroyIcon(info.hIcon);
+        }
+        if (SUCCEEDED(initialized)) {
+            CoUninitialize();
+        }
+        if (!image.isNull() && (image.width() > size.width() || image.height() > size.height())) {
+            image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        return image;
+    }
+#endif
     
+    return QImage();
+}
+
+QIcon IconExtractor::loadIconFromFile(const QString& filePath)
+{
+    QIcon icon;
     QFileInfo fileInfo(filePath);
-    QFileIconProvider iconProvider;
-    QIcon icon = iconProvider.icon(fileInfo);
+    
+    // 图片文件直接作为图标，其他来源使用主题图标或系统提供的文件图标
+    if (isImageFile(fileInfo)) {
+        if (fileInfo.exists()) {
+            icon = QIcon(filePath);
+        }
+    } else {
+        icon = loadSystemIcon(filePath);
+    }
     
     // 如果图标为空，使用默认图标
     if (icon.isNull()) {
@@ -68,4 +556,99 @@ QIcon IconExtractor::loadIconFromFile(const QString& filePath)
     }
     
     return icon;
-}
\ No newline at end of file
+}
+
+QIcon IconExtractor::loadSystemIcon(const QString& filePath) const
+{
+    // 只在GUI线程中调用：QFileIconProvider和主题图标都依赖平台图标引擎
+    QFileInfo fileInfo(filePath);
+    
+    if (!filePath.isEmpty() && !fileInfo.isAbsolute()) {
+        // .desktop文件中的图标主题名称
+        return QIcon::fromTheme(filePath);
+    }
+    
+    if (fileInfo.exists()) {
+        QFileIconProvider iconProvider;
+        return iconProvider.icon(fileInfo);
+    }
+    
+    return QIcon();
+}
+
+QIcon IconExtractor::resolveSystemIcon(const QString& filePath, const QSize& size)
+{
+    const QIcon resolved = loadSystemIcon(filePath);
+    if (resolved.isNull()) {
+        // 默认图标不写入磁盘缓存，来源出现后可以重新加载
+        const QIcon icon = QApplication::style()->standardIcon(QStyle::SP_FileIcon);
+        m_iconCache.insert(filePath, new QIcon(icon));
+        return icon;
+    }
+    m_iconCache.insert(filePath, new QIcon(resolved));
+    
+    // 栅格化必须在GUI线程中完成，PNG编码仍交给线程池，写入磁盘缓存回到GUI线程
+    if (m_diskCache) {
+        const IconStamp stamp = IconDiskCache::stampFor(filePath);
+        const QImage image = resolved.pixmap(size).toImage();
+        const int pixelSize = qMax(size.width(), size.height());
+        if (!image.isNull()) {
+            m_threadPool->start([this, filePath, image, pixelSize, stamp]() {
+                QByteArray png;
+                QBuffer buffer(&png);
+                buffer.open(QIODevice::WriteOnly);
+                image.save(&buffer, "PNG");
+                
+                QMetaObject::invokeMethod(this, [this, filePath, pixelSize, stamp, png]() {
+                    if (m_diskCache) {
+                        m_diskCache->insert(filePath, pixelSize, stamp, png);
+                    }
+                }, Qt::QueuedConnection);
+            });
+        }
+    }
+    
+    return resolved;
+}
+
+void IconExtractor::onIconLoaded(const QString& filePath, const QImage& image, int pixelSize,
+                                 const IconStamp& stamp, const QByteArray& png)
+{
+    m_pendingIcons.remove(filePath);
+    
+    QIcon icon;
+    if (!image.isNull()) {
+        icon = QIcon(QPixmap::fromImage(image));
+        
+        // 默认图标不写入磁盘缓存，来源出现后可以重新加载
+        if (m_diskCache) {
+            m_diskCache->insert(filePath, pixelSize, stamp, png);
+        }
+        m_iconCache.insert(filePath, new QIcon(icon));
+    } else if (!isImageFile(QFileInfo(filePath))) {
+        // 工作线程没有找到的主题图标或系统文件图标，回到GUI线程交给平台图标引擎
+        icon = resolveSystemIcon(filePath, QSize(pixelSize, pixelSize));
+    } else {
+        icon = QApplication::style()->standardIcon(QStyle::SP_FileIcon);
+        m_iconCache.insert(filePath, new QIcon(icon));
+    }
+    
+    emit iconReady(filePath, icon);
+    
+    const auto receivers = m_waitingReceivers.take(filePath);
+    for (const auto& receiver : receivers) {
+        if (receiver.first) {
+            notifyReceiver(receiver.first, receiver.second, filePath, icon);
+        }
+    }
+}
+
+void IconExtractor::notifyReceiver(QObject* receiver, const QByteArray& member, const QString& filePath, const QIcon& icon)
+{
+    // 与信号一样排队调用，接收者总是在请求返回后才收到图标
+    bool invoked = QMetaObject::invokeMethod(receiver, member.constData(), Qt::QueuedConnection,
+                                             Q_ARG(QString, filePath), Q_ARG(QIcon, icon));
+    if (!invoked) {
+        qCWarning(softwareManager) << "无法调用图标接收方法:" << member;
+    }
+}
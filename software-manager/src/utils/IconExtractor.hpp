@@ -3,8 +3,16 @@
 
 #include <QObject>
 #include <QIcon>
+#include <QImage>
 #include <QCache>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
 #include <QThreadPool>
+#include "IconDiskCache.hpp"
 
 class IconLoadTask;
 
@@ -13,21 +21,68 @@ class IconExtractor : public QObject {
 
 public:
     explicit IconExtractor(QObject* parent = nullptr);
+    ~IconExtractor();
     
-    // 图标提取方法
+    // 程序共享的图标服务（GUI线程使用）
+    static IconExtractor* instance();
+    
+    // 图标提取方法，filePath也可以是图标主题中的名称
     QIcon extractIcon(const QString& filePath);
     void extractIconAsync(const QString& filePath, QObject* receiver, const char* member);
     
+    // 异步加载：内存或磁盘缓存中的图标直接返回，否则返回空图标，加载完成后发出iconReady
+    QIcon cachedIcon(const QString& filePath) const;
+    QIcon requestIcon(const QString& filePath, const QSize& size);
+    
     // 缓存管理
     void setCacheSize(int size);
     void clearCache();
     
+    // 持久化的缩略图缓存，启动时可以直接显示上次加载过的图标
+    bool enableDiskCache(const QString& cachePath);
+    IconDiskCache* diskCache() const;
+    
+    // 在工作线程中把图片文件解码为QImage，其他来源返回空图像
+    static QImage renderIcon(const QString& filePath, const QSize& size);
+    
+    // 图标主题的查找位置，在GUI线程中取得后交给工作线程使用
+    struct ThemeSearch {
+        QString themeName;
+        QStringList searchPaths;
+        QStringList fallbackPaths;
+    };
+    static ThemeSearch currentThemeSearch();
+    
+    // 按freedesktop图标主题规范把主题图标名称解析为文件（包括继承的主题和hicolor），
+    // 只读取index.theme和检查文件是否存在，可以在任何线程中执行；找不到时返回空字符串
+    static QString findThemeIconFile(const QString& iconName, int size, const ThemeSearch& search);
+    
+    // 在工作线程中解析主题图标和系统文件图标：主题名称查找到文件后解码，
+    // Windows上通过Shell取得文件图标；无法离线程解析的来源返回空图像，由GUI线程回退处理
+    static QImage renderSystemIcon(const QString& filePath, const QSize& size, const ThemeSearch& search);
+    
+signals:
+    void iconReady(const QString& filePath, const QIcon& icon);
+    
 private:
+    friend class IconLoadTask;
+    
     QCache<QString, QIcon> m_iconCache;
     QThreadPool* m_threadPool;
+    IconDiskCache* m_diskCache;
     int m_maxCacheSize;
     
+    // 正在加载的图标，以及等待extractIconAsync结果的接收者
+    QSet<QString> m_pendingIcons;
+    QHash<QString, QList<QPair<QPointer<QObject>, QByteArray>>> m_waitingReceivers;
+    
     QIcon loadIconFromFile(const QString& filePath);
+    QIcon loadSystemIcon(const QString& filePath) const;
+    QIcon resolveSystemIcon(const QString& filePath, const QSize& size);
+    bool canRenderOffThread(const QString& filePath) const;
+    void onIconLoaded(const QString& filePath, const QImage& image, int pixelSize,
+                      const IconStamp& stamp, const QByteArray& png);
+    void notifyReceiver(QObject* receiver, const QByteArray& member, const QString& filePath, const QIcon& icon);
 };
 
-#endif // ICONEXTRACTOR_H
\ No newline at end of file
+#endif // ICONEXTRACTOR_H
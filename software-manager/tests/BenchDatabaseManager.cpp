@@ -0,0 +1,137 @@
+#include <QtTest/QtTest>
+#include "../src/core/DatabaseManager.hpp"
+#include "../src/model/SoftwareItem.hpp"
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+
+// 对比SQLite默认连接参数和推荐配置在10万条软件项上的读写吞吐量；
+// 耗时较长，默认的ctest不运行，需要时用ctest -C Benchmark运行
+class BenchDatabaseManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchWrite_data();
+    void benchWrite();
+    void benchRead_data();
+    void benchRead();
+
+private:
+    static const int RowCount = 100000;
+    static const int RowsPerTransaction = 1000;
+    static const int PointLookups = 20000;
+    
+    QTemporaryDir m_tempDir;
+    QList<SoftwareItem> m_items;
+    
+    void addProfileRows();
+    static DatabaseManager::PerformanceProfile profileFor(const QString& name);
+    static bool populate(DatabaseManager& databaseManager, const QList<SoftwareItem>& items);
+};
+
+void BenchDatabaseManager::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    
+    QDateTime now = QDateTime::currentDateTime();
+    m_items.reserve(RowCount);
+    for (int i = 0; i < RowCount; ++i) {
+        const QString id = QString("bench-%1").arg(i);
+        m_items.append(SoftwareItem(id, QString("Bench Application %1").arg(i),
+                                    QString("/opt/bench/%1/app.exe").arg(i), QString("分类%1").arg(i % 20),
+                                    QString("Benchmark item %1").arg(i), "1.0", now, now));
+    }
+}
+
+void BenchDatabaseManager::addProfileRows()
+{
+    QTest::addColumn<QString>("profile");
+    QTest::newRow("sqlite-defaults") << "sqlite-defaults";
+    QTest::newRow("tuned") << "tuned";
+}
+
+DatabaseManager::PerformanceProfile BenchDatabaseManager::profileFor(const QString& name)
+{
+    return name == "tuned" ? DatabaseManager::PerformanceProfile::tuned()
+                           : DatabaseManager::PerformanceProfile::sqliteDefaults();
+}
+
+bool BenchDatabaseManager::populate(DatabaseManager& databaseManager, const QList<SoftwareItem>& items)
+{
+    // 按扫描时的批量大小分多个事务提交，每次提交都要同步磁盘
+    for (int offset = 0; offset < items.size(); offset += RowsPerTransaction) {
+        if (!databaseManager.batchInsertSoftwareItems(items.mid(offset, RowsPerTransaction))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BenchDatabaseManager::benchWrite_data()
+{
+    addProfileRows();
+}
+
+void BenchDatabaseManager::benchWrite()
+{
+    QFETCH(QString, profile);
+    const QString dbPath = m_tempDir.filePath("write-" + profile + ".db");
+    
+    DatabaseManager databaseManager(dbPath);
+    QVERIFY(databaseManager.setPerformanceProfile(profileFor(profile)));
+    QVERIFY(databaseManager.initializeDatabase());
+    
+    QElapsedTimer timer;
+    bool success = false;
+    QBENCHMARK_ONCE {
+        timer.start();
+        success = populate(databaseManager, m_items);
+    }
+    QVERIFY(success);
+    
+    const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+    qInfo() << profile << "写入" << RowCount << "条:" << elapsed << "ms,"
+            << RowCount * 1000 / elapsed << "条/秒";
+}
+
+void BenchDatabaseManager::benchRead_data()
+{
+    addProfileRows();
+}
+
+void BenchDatabaseManager::benchRead()
+{
+    QFETCH(QString, profile);
+    const QString dbPath = m_tempDir.filePath("read-" + profile + ".db");
+    
+    DatabaseManager databaseManager(dbPath);
+    QVERIFY(databaseManager.setPerformanceProfile(profileFor(profile)));
+    QVERIFY(databaseManager.initializeDatabase());
+    QVERIFY(populate(databaseManager, m_items));
+    
+    // 全表读取、按分类读取和按id的随机查找
+    QElapsedTimer timer;
+    int rows = 0;
+    QBENCHMARK_ONCE {
+        timer.start();
+        rows += databaseManager.getAllSoftwareItems().size();
+        for (int i = 0; i < 20; ++i) {
+            rows += databaseManager.getSoftwareItemsByCategory(QString("分类%1").arg(i)).size();
+        }
+        for (int i = 0; i < PointLookups; ++i) {
+            const int index = int((quint64(i) * 7919) % RowCount);
+            if (databaseManager.softwareItemExists(m_items.at(index).getId())) {
+                ++rows;
+            }
+        }
+    }
+    QCOMPARE(rows, RowCount * 2 + PointLookups);
+    
+    const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+    qInfo() << profile << "读取" << rows << "条:" << elapsed << "ms,"
+            << qint64(rows) * 1000 / elapsed << "条/秒";
+}
+
+QTEST_MAIN(BenchDatabaseManager)
+#include "BenchDatabaseManager.moc"
@@ -1,5 +1,11 @@
 #include <QtTest/QtTest>
 #include "../src/core/CategoryManager.hpp"
+#include "../src/core/DatabaseReaderPool.hpp"
+#include "TestHelpers.hpp"
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThread>
+#include <atomic>
 
 class TestCategoryManager : public QObject
 {
@@ -17,15 +23,33 @@ private slots:
     void testGetCategoryCount();
     void testGetDefaultCategory();
     void testIsBuiltInCategory();
+    void testCountsFollowDatabase();
+    void testBatchedNotifications();
+    void testConcurrentReads();
     void cleanupTestCase();
 
 private:
+    QTemporaryDir m_tempDir;
+    DatabaseManager* m_databaseManager;
+    DatabaseExecutor* m_databaseExecutor;
+    DatabaseReaderPool* m_databaseReaders;
     CategoryManager* m_categoryManager;
 };
 
 void TestCategoryManager::initTestCase()
 {
-    m_categoryManager = new CategoryManager();
+    QVERIFY(m_tempDir.isValid());
+    const QString dbPath = m_tempDir.filePath("categories.db");
+    m_databaseManager = new DatabaseManager(dbPath);
+    QVERIFY(m_databaseManager->initializeDatabase());
+    m_databaseExecutor = new DatabaseExecutor(dbPath);
+    m_databaseReaders = new DatabaseReaderPool(dbPath, 2);
+    
+    // 加载在数据库线程和读连接上完成，完成后通知一次
+    m_categoryManager = new CategoryManager(m_databaseExecutor, m_databaseReaders);
+    QSignalSpy spy(m_categoryManager, &CategoryManager::categoriesChanged);
+    m_categoryManager->load();
+    QVERIFY(spy.wait());
 }
 
 void TestCategoryManager::testDefaultCategories()
@@ -48,9 +72,9 @@ void TestCategoryManager::testAddCategory()
     bool result = m_categoryManager->addCategory(categoryName);
     QVERIFY(result);
     
-    // 检查分类是否添加成功
-    QStringList categories = m_categoryManager->getCategories();
-    QVERIFY(categories.contains(categoryName));
+    // 写入在数据库线程中完成，读取计数后快照才更新
+    QTRY_VERIFY(m_categoryManager->getCategories().contains(categoryName));
+    QVERIFY(m_databaseManager->categoryExists(categoryName));
     
     // 尝试添加重复分类应该返回true（已存在视为成功）
     result = m_categoryManager->addCategory(categoryName);
@@ -68,15 +92,17 @@ void TestCategoryManager::testRenameCategory()
     
     // 先添加分类
     QVERIFY(m_categoryManager->addCategory(oldName));
+    QTRY_VERIFY(m_categoryManager->categoryExists(oldName));
     
     // 重命名分类
+    QSignalSpy renamedSpy(m_categoryManager, &CategoryManager::categoryRenamed);
     bool result = m_categoryManager->renameCategory(oldName, newName);
     QVERIFY(result);
     
-    // 检查重命名是否成功
-    QStringList categories = m_categoryManager->getCategories();
-    QVERIFY(!categories.contains(oldName));
-    QVERIFY(categories.contains(newName));
+    // 检查重命名是否成功，新旧名称在同一个快照中替换
+    QTRY_VERIFY(m_categoryManager->categoryExists(newName));
+    QVERIFY(!m_categoryManager->categoryExists(oldName));
+    QCOMPARE(renamedSpy.count(), 1);
     
     // 尝试重命名不存在的分类
     result = m_categoryManager->renameCategory("不存在的分类", "另一个分类");
@@ -93,14 +119,15 @@ void TestCategoryManager::testRemoveCategory()
     
     // 先添加分类
     QVERIFY(m_categoryManager->addCategory(categoryName));
+    QTRY_VERIFY(m_categoryManager->categoryExists(categoryName));
     
     // 删除分类
     bool result = m_categoryManager->removeCategory(categoryName);
     QVERIFY(result);
     
     // 检查分类是否删除成功
-    QStringList categories = m_categoryManager->getCategories();
-    QVERIFY(!categories.contains(categoryName));
+    QTRY_VERIFY(!m_categoryManager->categoryExists(categoryName));
+    QVERIFY(!m_databaseManager->categoryExists(categoryName));
     
     // 尝试删除不存在的分类
     result = m_categoryManager->removeCategory("不存在的分类");
@@ -119,7 +146,7 @@ void TestCategoryManager::testCategoryExists()
     QVERIFY(m_categoryManager->addCategory(categoryName));
     
     // 检查分类存在性
-    QVERIFY(m_categoryManager->categoryExists(categoryName));
+    QTRY_VERIFY(m_categoryManager->categoryExists(categoryName));
     QVERIFY(!m_categoryManager->categoryExists("不存在的分类"));
 }
 
@@ -150,10 +177,13 @@ void TestCategoryManager::testMoveSoftwareToCategory()
     
     // 先添加分类
     QVERIFY(m_categoryManager->addCategory(categoryName));
+    QTRY_VERIFY(m_categoryManager->categoryExists(categoryName));
     
-    // 移动软件到分类
+    // 移动软件到分类，写入完成后发出信号
+    QSignalSpy spy(m_categoryManager, &CategoryManager::softwareCategoryChanged);
     bool result = m_categoryManager->moveSoftwareToCategory(softwareId, categoryName);
     QVERIFY(result);
+    QVERIFY(spy.wait());
     
     // 尝试移动到不存在的分类
     result = m_categoryManager->moveSoftwareToCategory(softwareId, "不存在的分类");
@@ -166,6 +196,7 @@ void TestCategoryManager::testGetCategoryCount()
     
     // 先添加分类
     QVERIFY(m_categoryManager->addCategory(categoryName));
+    QTRY_VERIFY(m_categoryManager->categoryExists(categoryName));
     
     // 检查初始计数
     int count = m_categoryManager->getCategoryCount(categoryName);
@@ -187,12 +218,121 @@ void TestCategoryManager::testIsBuiltInCategory()
     // 测试非内置分类
     QString userCategory = "用户分类";
     QVERIFY(m_categoryManager->addCategory(userCategory));
-    QVERIFY(m_categoryManager->categoryExists(userCategory));
+    QTRY_VERIFY(m_categoryManager->categoryExists(userCategory));
+}
+
+void TestCategoryManager::testCountsFollowDatabase()
+{
+    // 分类和计数以数据库为准，其他连接写入的分类在刷新后出现
+    QList<SoftwareItem> items;
+    items << testSoftwareItem("count-1", "Count 1", "计数分类") << testSoftwareItem("count-2", "Count 2", "计数分类")
+          << testSoftwareItem("count-3", "Count 3", "另一计数分类");
+    QVERIFY(m_databaseManager->ingestSoftwareItems(items));
+    QVERIFY(!m_categoryManager->categoryExists("计数分类"));
+    
+    QSignalSpy spy(m_categoryManager, &CategoryManager::categoriesChanged);
+    m_categoryManager->scheduleRefresh();
+    QVERIFY(spy.wait());
+    QVERIFY(m_categoryManager->categoryExists("计数分类"));
+    QCOMPARE(m_categoryManager->getCategoryCount("计数分类"), 2);
+    QCOMPARE(m_categoryManager->getCategoryCounts().value("另一计数分类"), 1);
+    
+    // 移动软件时原分类和新分类的计数同时更新
+    QVERIFY(m_categoryManager->moveSoftwareToCategory("count-1", "另一计数分类"));
+    QTRY_COMPARE(m_categoryManager->getCategoryCount("计数分类"), 1);
+    QCOMPARE(m_categoryManager->getCategoryCount("另一计数分类"), 2);
+    
+    // 重命名保留计数，并写入数据库
+    QVERIFY(m_categoryManager->renameCategory("计数分类", "改名计数分类"));
+    QTRY_COMPARE(m_categoryManager->getCategoryCount("改名计数分类"), 1);
+    QVERIFY(m_databaseManager->categoryExists("改名计数分类"));
+    QVERIFY(!m_databaseManager->categoryExists("计数分类"));
+    
+    // 另一个分类服务从同一个数据库读到相同的结果
+    CategoryManager reloaded(m_databaseExecutor, m_databaseReaders);
+    QSignalSpy reloadedSpy(&reloaded, &CategoryManager::categoriesChanged);
+    reloaded.load();
+    QVERIFY(reloadedSpy.wait());
+    QCOMPARE(reloaded.getCategories(), m_categoryManager->getCategories());
+    QCOMPARE(reloaded.getCategoryCounts(), m_categoryManager->getCategoryCounts());
+}
+
+void TestCategoryManager::testBatchedNotifications()
+{
+    QSignalSpy spy(m_categoryManager, &CategoryManager::categoriesChanged);
+    
+    // 连续的修改只通知一次，通知时快照已包含全部修改
+    QVERIFY(m_categoryManager->addCategory("批量分类1"));
+    QVERIFY(m_categoryManager->addCategory("批量分类2"));
+    m_categoryManager->scheduleRefresh();
+    m_categoryManager->scheduleRefresh();
+    
+    QVERIFY(spy.wait());
+    QVERIFY(m_categoryManager->categoryExists("批量分类1"));
+    QVERIFY(m_categoryManager->categoryExists("批量分类2"));
+    QTest::qWait(300);
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestCategoryManager::testConcurrentReads()
+{
+    // 其他线程读取时不加锁，同时所属线程不断替换快照；读到的分类列表总包含内置分类
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::atomic<int> reads(0);
+    QList<QThread*> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers << QThread::create([this, &stop, &failures, &reads]() {
+            while (!stop.load()) {
+                const QStringList categories = m_categoryManager->getCategories();
+                if (categories.value(0) != "所有软件" || categories.value(1) != "未分类" ||
+                    !m_categoryManager->categoryExists("未分类") ||
+                    !m_categoryManager->validateCategoryName("并发分类") ||
+                    m_categoryManager->getCategoryCount("并发分类") < 0) {
+                    ++failures;
+                }
+                ++reads;
+            }
+        });
+        readers.last()->start();
+    }
+    
+    // 写入失败时只记录，读线程停止并回收后再检查，提前返回会留下仍在运行的线程
+    int writeFailures = 0;
+    for (int i = 0; i < 20 && writeFailures == 0; ++i) {
+        if (!m_categoryManager->addCategory("并发分类")
+            || !QTest::qWaitFor([this]() { return m_categoryManager->categoryExists("并发分类"); })
+            || !m_categoryManager->renameCategory("并发分类", "并发分类改名")
+            || !QTest::qWaitFor([this]() { return m_categoryManager->categoryExists("并发分类改名"); })
+            || !m_categoryManager->removeCategory("并发分类改名")
+            || !QTest::qWaitFor([this]() { return !m_categoryManager->categoryExists("并发分类改名"); })) {
+            ++writeFailures;
+        }
+    }
+    
+    stop = true;
+    int unfinishedReaders = 0;
+    for (QThread* reader : readers) {
+        // 未结束的线程不能销毁
+        if (reader->wait(5000)) {
+            delete reader;
+        } else {
+            ++unfinishedReaders;
+        }
+    }
+    QCOMPARE(unfinishedReaders, 0);
+    QCOMPARE(writeFailures, 0);
+    QVERIFY(reads.load() > 0);
+    QCOMPARE(failures.load(), 0);
+    QVERIFY(!m_categoryManager->categoryExists("并发分类"));
 }
 
 void TestCategoryManager::cleanupTestCase()
 {
     delete m_categoryManager;
+    delete m_databaseReaders;
+    delete m_databaseExecutor;
+    delete m_databaseManager;
 }
 
 QTEST_MAIN(TestCategoryManager)
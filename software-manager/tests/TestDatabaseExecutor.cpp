@@ -0,0 +1,196 @@
+#include <QtTest/QtTest>
+#include "../src/core/DatabaseExecutor.hpp"
+#include "TestHelpers.hpp"
+#include <QTemporaryDir>
+#include <QSemaphore>
+
+class TestDatabaseExecutor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testRunsOnDatabaseThread();
+    void testRequestsAreSerialized();
+    void testAsyncQueries();
+    void testContinuationOnCallerThread();
+    void testStreamSoftwareItems();
+    void testStreamCancellation();
+
+private:
+    QTemporaryDir m_tempDir;
+};
+
+void TestDatabaseExecutor::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+}
+
+void TestDatabaseExecutor::testRunsOnDatabaseThread()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("thread.db"));
+    
+    QThread* databaseThread = executor.run([](DatabaseManager& databaseManager) {
+        Q_UNUSED(databaseManager)
+        return QThread::currentThread();
+    }).result();
+    
+    QVERIFY(databaseThread != nullptr);
+    QVERIFY(databaseThread != QThread::currentThread());
+    
+    // 线程中的连接在第一个请求之前已经打开
+    QVERIFY(executor.run([](DatabaseManager& databaseManager) {
+        return databaseManager.isDatabaseValid();
+    }).result());
+}
+
+void TestDatabaseExecutor::testRequestsAreSerialized()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("order.db"));
+    
+    // 列表只在数据库线程中修改，请求按提交顺序逐个执行
+    QList<int> order;
+    for (int i = 0; i < 100; ++i) {
+        executor.run([&order, i](DatabaseManager& databaseManager) {
+            Q_UNUSED(databaseManager)
+            order.append(i);
+        });
+    }
+    executor.waitForIdle();
+    
+    QCOMPARE(order.size(), 100);
+    for (int i = 0; i < order.size(); ++i) {
+        QCOMPARE(order.at(i), i);
+    }
+}
+
+void TestDatabaseExecutor::testAsyncQueries()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("queries.db"));
+    
+    // 写入和随后的读取按顺序执行，读取一定能看到写入的结果
+    QList<SoftwareItem> items;
+    items << testSoftwareItem("exec-1", "Alpha", "工具") << testSoftwareItem("exec-2", "Beta", "工具") << testSoftwareItem("exec-3", "Gamma", "游戏");
+    QFuture<bool> inserted = executor.run([items](DatabaseManager& databaseManager) {
+        return databaseManager.ingestSoftwareItems(items);
+    });
+    QFuture<QList<SoftwareItem>> all = executor.getAllSoftwareItemsAsync();
+    QFuture<QList<SoftwareItem>> tools = executor.getSoftwareItemsByCategoryAsync("工具");
+    
+    QVERIFY(inserted.result());
+    QCOMPARE(all.result().size(), 3);
+    QCOMPARE(tools.result().size(), 2);
+    QCOMPARE(executor.getSoftwareItemByIdAsync("exec-3").result().getName(), QString("Gamma"));
+    
+    QVERIFY(executor.removeSoftwareItemAsync("exec-3").result());
+    QVERIFY(executor.getSoftwareItemByIdAsync("exec-3").result().getId().isEmpty());
+    QCOMPARE(executor.getAllSoftwareItemsAsync().result().size(), 2);
+}
+
+void TestDatabaseExecutor::testContinuationOnCallerThread()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("continuation.db"));
+    
+    // 带上下文对象的回调以排队方式回到上下文所在的线程
+    QObject context;
+    QThread* callbackThread = nullptr;
+    int resultSize = -1;
+    executor.getAllSoftwareItemsAsync().then(&context, [&](const QList<SoftwareItem>& items) {
+        callbackThread = QThread::currentThread();
+        resultSize = items.size();
+    });
+    
+    QTRY_VERIFY(callbackThread != nullptr);
+    QCOMPARE(callbackThread, QThread::currentThread());
+    QCOMPARE(resultSize, 0);
+}
+
+void TestDatabaseExecutor::testStreamSoftwareItems()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("stream.db"));
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 25; ++i) {
+        items << testSoftwareItem(QString("stream-%1").arg(i, 2, 10, QChar('0')), QString("App %1").arg(i, 2, 10, QChar('0')), "工具");
+    }
+    QVERIFY(executor.run([items](DatabaseManager& databaseManager) {
+        return databaseManager.ingestSoftwareItems(items);
+    }).result());
+    
+    // 每页在调用者线程中按顺序送达，全部的页先于结果的回调
+    QObject context;
+    QList<int> offsets;
+    QStringList ids;
+    int total = -1;
+    int pagesBeforeTotal = -1;
+    executor.streamSoftwareItemsAsync(QString(), 10, &context, [&](const QList<SoftwareItem>& page, int offset) {
+        QCOMPARE(QThread::currentThread(), QCoreApplication::instance()->thread());
+        offsets << offset;
+        for (const SoftwareItem& item : page) {
+            ids << item.getId();
+        }
+    }).then(&context, [&](int count) {
+        pagesBeforeTotal = offsets.size();
+        total = count;
+    });
+    
+    QTRY_COMPARE(total, 25);
+    QCOMPARE(pagesBeforeTotal, 3);
+    QCOMPARE(offsets, QList<int>() << 0 << 10 << 20);
+    QCOMPARE(ids.size(), 25);
+    QCOMPARE(ids.first(), QString("stream-00"));
+    QCOMPARE(ids.last(), QString("stream-24"));
+    
+    // 没有结果时不送出页
+    offsets.clear();
+    QCOMPARE(executor.streamSoftwareItemsAsync("不存在的分类", 10, &context, [&](const QList<SoftwareItem>&, int offset) {
+        offsets << offset;
+    }).result(), 0);
+    QCoreApplication::processEvents();
+    QVERIFY(offsets.isEmpty());
+}
+
+void TestDatabaseExecutor::testStreamCancellation()
+{
+    DatabaseExecutor executor(m_tempDir.filePath("cancel.db"));
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 25; ++i) {
+        items << testSoftwareItem(QString("cancel-%1").arg(i), QString("App %1").arg(i), "工具");
+    }
+    QVERIFY(executor.run([items](DatabaseManager& databaseManager) {
+        return databaseManager.ingestSoftwareItems(items);
+    }).result());
+    
+    // 读取排在一个阻塞的请求后面，开始之前就已取消，不读取也不送页
+    QSemaphore blocked;
+    executor.run([&blocked](DatabaseManager&) {
+        blocked.acquire();
+    });
+    QObject context;
+    int pages = 0;
+    QFuture<int> cancelled = executor.streamSoftwareItemsAsync(QString(), 10, &context, [&](const QList<SoftwareItem>&, int) {
+        ++pages;
+    });
+    cancelled.cancel();
+    blocked.release();
+    executor.waitForIdle();
+    QCoreApplication::processEvents();
+    QVERIFY(cancelled.isCanceled());
+    QCOMPARE(pages, 0);
+    
+    // context销毁后同样停止读取
+    QObject* shortLived = new QObject();
+    executor.run([&blocked](DatabaseManager&) {
+        blocked.acquire();
+    });
+    QFuture<int> orphaned = executor.streamSoftwareItemsAsync(QString(), 10, shortLived, [&](const QList<SoftwareItem>&, int) {
+        ++pages;
+    });
+    delete shortLived;
+    blocked.release();
+    QCOMPARE(orphaned.result(), 0);
+    QCoreApplication::processEvents();
+    QCOMPARE(pages, 0);
+}
+
+QTEST_MAIN(TestDatabaseExecutor)
+#include "TestDatabaseExecutor.moc"
@@ -4,6 +4,9 @@
 #include <QTemporaryDir>
 #include <QFile>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
 
 class TestDatabaseManager : public QObject
 {
@@ -15,13 +18,22 @@ private slots:
     void testSoftwareItemCRUD();
     void testCategoryCRUD();
     void testBatchOperations();
+    void testBulkInsert();
+    void testIngestSoftwareItems();
+    void testStreamingQueries();
+    void testFrecencyOrder();
     void testMoveSoftwareToCategory();
     void testGetCategoryCount();
+    void testCategoryCounts();
     void testSoftwareItemExists();
     void testGetSoftwareItemById();
     void testGetSoftwareItemsByCategory();
     void testBackupAndRestore();
     void testGetDatabaseSize();
+    void testDirectorySnapshots();
+    void testFullTextSearch();
+    void testPerformanceProfile();
+    void testSchemaMigration();
     void cleanupTestCase();
 
 private:
@@ -79,6 +91,7 @@ void TestDatabaseManager::testSoftwareItemCRUD()
     QCOMPARE(retrievedItem.getCategory(), QString("测试分类"));
     QCOMPARE(retrievedItem.getDescription(), QString("这是一个测试软件"));
     QCOMPARE(retrievedItem.getVersion(), QString("1.0.0"));
+    QCOMPARE(retrievedItem.getIconKey(), tempFile);
     
     // 获取所有软件项
     QList<SoftwareItem> allItems = m_databaseManager->getAllSoftwareItems();
@@ -93,12 +106,14 @@ void TestDatabaseManager::testSoftwareItemCRUD()
     // 更新软件项
     item.setName("更新后的测试软件");
     item.setVersion("2.0.0");
+    item.setIconKey("accessories-text-editor");
     QVERIFY(m_databaseManager->updateSoftwareItem(item));
     
     // 验证更新
     SoftwareItem updatedItem = m_databaseManager->getSoftwareItemById(item.getId());
     QCOMPARE(updatedItem.getName(), QString("更新后的测试软件"));
     QCOMPARE(updatedItem.getVersion(), QString("2.0.0"));
+    QCOMPARE(updatedItem.getIconKey(), QString("accessories-text-editor"));
     
     // 删除软件项
     QVERIFY(m_databaseManager->removeSoftwareItem(item.getId()));
@@ -166,6 +181,203 @@ void TestDatabaseManager::testBatchOperations()
     }
 }
 
+void TestDatabaseManager::testBulkInsert()
+{
+    const QString category = "大批量测试分类";
+    const QDateTime now = QDateTime::currentDateTime();
+    
+    QList<SoftwareItem> items;
+    QStringList filePaths;
+    for (int i = 0; i < 50000; ++i) {
+        QString filePath = m_tempDir->path() + QString("/bulk/app_%1.exe").arg(i);
+        items.append(SoftwareItem(QString("bulk-%1").arg(i), QString("Bulk App %1").arg(i), filePath,
+                                  category, QString(), QString(), now, now));
+        filePaths.append(filePath);
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(m_databaseManager->batchInsertSoftwareItems(items));
+    qint64 elapsed = timer.elapsed();
+    qInfo() << "批量插入50000个软件项耗时(毫秒):" << elapsed;
+    
+    QCOMPARE(m_databaseManager->getCategoryCount(category), 50000);
+    QCOMPARE(m_databaseManager->getSoftwareItemById("bulk-42").getFilePath(), filePaths.at(42));
+    
+    // 批中任意一行失败时整批回滚
+    QList<SoftwareItem> conflicting;
+    conflicting << SoftwareItem("bulk-new", "Bulk New", m_tempDir->path() + "/bulk/new.exe", category,
+                                QString(), QString(), now, now)
+                << items.first();
+    QVERIFY(!m_databaseManager->batchInsertSoftwareItems(conflicting));
+    QVERIFY(!m_databaseManager->softwareItemExists("bulk-new"));
+    
+    QVERIFY(m_databaseManager->removeSoftwareItemsByFilePaths(filePaths));
+    QCOMPARE(m_databaseManager->getCategoryCount(category), 0);
+}
+
+void TestDatabaseManager::testIngestSoftwareItems()
+{
+    QDateTime now = QDateTime::currentDateTime();
+    const QString directory = m_tempDir->path() + "/ingest";
+    QList<SoftwareItem> scanned;
+    scanned << SoftwareItem("ingest-a", "Ingest A", directory + "/a.exe", "未分类", "扫描到的描述", "1.0", now, now)
+            << SoftwareItem("ingest-b", "Ingest B", directory + "/b.exe", "未分类", QString(), "1.0", now, now)
+            << SoftwareItem("ingest-c", "Ingest C", directory + "/c.exe", "未分类", QString(), "1.0", now, now);
+    
+    DatabaseManager::IngestResult result;
+    QVERIFY(m_databaseManager->ingestSoftwareItems(scanned, &result));
+    QCOMPARE(result.inserted.size(), 3);
+    QCOMPARE(result.updated.size(), 0);
+    QCOMPARE(result.unchanged, 0);
+    
+    // 用户修改分类和描述
+    SoftwareItem edited = m_databaseManager->getSoftwareItemById("ingest-a");
+    edited.setCategory("用户分类");
+    edited.setDescription("用户的描述");
+    QVERIFY(m_databaseManager->updateSoftwareItem(edited));
+    
+    // 重新扫描：每个软件项都有新的id，路径写法不同但指向同一文件，只有c的版本变化
+    QList<SoftwareItem> rescanned;
+    rescanned << SoftwareItem("rescan-a", "Ingest A", directory + "/a.exe", "未分类", "扫描到的描述", "1.0", now, now)
+              << SoftwareItem("rescan-b", "Ingest B", directory + "/sub/../b.exe", "未分类", QString(), "1.0", now, now)
+              << SoftwareItem("rescan-c", "Ingest C", directory + "//c.exe", "未分类", QString(), "2.0", now, now);
+    
+    QVERIFY(m_databaseManager->ingestSoftwareItems(rescanned, &result));
+    QCOMPARE(result.inserted.size(), 0);
+    QCOMPARE(result.updated.size(), 1);
+    QCOMPARE(result.unchanged, 2);
+    
+    // 更新沿用原有的id
+    QCOMPARE(result.updated.first().getId(), QString("ingest-c"));
+    QCOMPARE(result.updated.first().getVersion(), QString("2.0"));
+    QVERIFY(!m_databaseManager->softwareItemExists("rescan-a"));
+    QVERIFY(!m_databaseManager->softwareItemExists("rescan-b"));
+    
+    // 用户的修改不会被扫描结果覆盖
+    SoftwareItem stored = m_databaseManager->getSoftwareItemById("ingest-a");
+    QCOMPARE(stored.getCategory(), QString("用户分类"));
+    QCOMPARE(stored.getDescription(), QString("用户的描述"));
+    
+    // 空描述由扫描结果补上
+    rescanned.clear();
+    rescanned << SoftwareItem("rescan-b", "Ingest B", directory + "/b.exe", "未分类", "新的描述", "1.0", now, now);
+    QVERIFY(m_databaseManager->ingestSoftwareItems(rescanned, &result));
+    QCOMPARE(result.updated.size(), 1);
+    QCOMPARE(m_databaseManager->getSoftwareItemById("ingest-b").getDescription(), QString("新的描述"));
+    
+    // 按路径删除同样使用规范化的路径
+    QVERIFY(m_databaseManager->removeSoftwareItemsByFilePaths(
+        QStringList() << directory + "/a.exe" << directory + "/./b.exe" << directory + "/c.exe"));
+    QVERIFY(!m_databaseManager->softwareItemExists("ingest-a"));
+    QVERIFY(!m_databaseManager->softwareItemExists("ingest-b"));
+    QVERIFY(!m_databaseManager->softwareItemExists("ingest-c"));
+}
+
+void TestDatabaseManager::testStreamingQueries()
+{
+    DatabaseManager databaseManager(m_tempDir->filePath("streaming.db"));
+    QVERIFY(databaseManager.initializeDatabase());
+    
+    // 名称有重复，分页边界按rowid确定
+    QDateTime now = QDateTime::currentDateTime();
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 250; ++i) {
+        items << SoftwareItem(QString("stream-%1").arg(i), QString("Stream %1").arg(i / 2, 3, 10, QChar('0')),
+                              QString("/opt/stream/%1").arg(i), i % 5 == 0 ? "游戏" : "工具", QString(), QString(), now, now);
+    }
+    QVERIFY(databaseManager.ingestSoftwareItems(items));
+    
+    // 逐行遍历的顺序与完整列表相同
+    const QList<SoftwareItem> all = databaseManager.getAllSoftwareItems();
+    QStringList visited;
+    QVERIFY(databaseManager.forEachSoftwareItem(QString(), [&visited](const SoftwareItem& item) {
+        visited << item.getId();
+        return true;
+    }));
+    QCOMPARE(visited.size(), 250);
+    for (int i = 0; i < all.size(); ++i) {
+        QCOMPARE(visited.at(i), all.at(i).getId());
+    }
+    
+    // visitor返回false时停止
+    int count = 0;
+    QVERIFY(databaseManager.forEachSoftwareItem("游戏", [&count](const SoftwareItem& item) {
+        Q_UNUSED(item)
+        return ++count < 10;
+    }));
+    QCOMPARE(count, 10);
+    
+    // 提前停止后语句已结束，可以立即再次查询
+    QCOMPARE(databaseManager.getSoftwareItemsByCategory("游戏").size(), 50);
+    
+    // 分页读取拼接后与完整列表相同，不重复也不遗漏
+    QStringList paged;
+    for (int offset = 0; ; offset += 64) {
+        const QList<SoftwareItem> page = databaseManager.fetchSoftwareItems(QString(), offset, 64);
+        for (const SoftwareItem& item : page) {
+            paged << item.getId();
+        }
+        if (page.size() < 64) {
+            break;
+        }
+    }
+    QCOMPARE(paged, visited);
+    
+    QCOMPARE(databaseManager.fetchSoftwareItems("工具", 190, 64).size(), 10);
+    QCOMPARE(databaseManager.fetchSoftwareItems("工具", 0, -1).size(), 200);
+    QVERIFY(databaseManager.fetchSoftwareItems("工具", 500, 64).isEmpty());
+}
+
+void TestDatabaseManager::testFrecencyOrder()
+{
+    DatabaseManager databaseManager(m_tempDir->filePath("frecency.db"));
+    QVERIFY(databaseManager.initializeDatabase());
+    
+    QDateTime now = QDateTime::currentDateTime();
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 10; ++i) {
+        items << SoftwareItem(QString("frecency-%1").arg(i), QString("Frecency %1").arg(i),
+                              QString("/opt/frecency/%1").arg(i), i % 2 == 0 ? "游戏" : "工具",
+                              QString(), QString(), now, now);
+    }
+    QVERIFY(databaseManager.ingestSoftwareItems(items));
+    
+    LaunchStats often;
+    often.softwareId = "frecency-7";
+    often.launchCount = 5;
+    often.frecency = 20.0;
+    LaunchStats rarely;
+    rarely.softwareId = "frecency-4";
+    rarely.launchCount = 1;
+    rarely.frecency = 10.0;
+    QVERIFY(databaseManager.saveLaunchStats(QList<LaunchStats>() << rarely << often));
+    
+    // 启动过的按frecency从高到低排在前面，其余按名称排列
+    QStringList ids;
+    QVERIFY(databaseManager.forEachSoftwareItem(QString(), [&ids](const SoftwareItem& item) {
+        ids << item.getId();
+        return true;
+    }, DatabaseManager::SortByFrecency));
+    QCOMPARE(ids, QStringList() << "frecency-7" << "frecency-4" << "frecency-0" << "frecency-1" << "frecency-2"
+                                << "frecency-3" << "frecency-5" << "frecency-6" << "frecency-8" << "frecency-9");
+    
+    // 分页读取与分类过滤使用同一顺序
+    QStringList paged;
+    for (int offset = 0; offset < 10; offset += 3) {
+        for (const SoftwareItem& item : databaseManager.fetchSoftwareItems(QString(), offset, 3, DatabaseManager::SortByFrecency)) {
+            paged << item.getId();
+        }
+    }
+    QCOMPARE(paged, ids);
+    
+    QStringList games;
+    for (const SoftwareItem& item : databaseManager.fetchSoftwareItems("游戏", 0, -1, DatabaseManager::SortByFrecency)) {
+        games << item.getId();
+    }
+    QCOMPARE(games, QStringList() << "frecency-4" << "frecency-0" << "frecency-2" << "frecency-6" << "frecency-8");
+}
+
 void TestDatabaseManager::testMoveSoftwareToCategory()
 {
     // 创建临时文件
@@ -226,6 +438,70 @@ void TestDatabaseManager::testGetCategoryCount()
     QVERIFY(count >= 1);
 }
 
+void TestDatabaseManager::testCategoryCounts()
+{
+    DatabaseManager databaseManager(m_tempDir->filePath("category_counts.db"));
+    QVERIFY(databaseManager.initializeDatabase());
+    
+    // 写入软件项时自动建立分类，计数随之增加
+    QDateTime now = QDateTime::currentDateTime();
+    QList<SoftwareItem> items;
+    items << SoftwareItem("count-1", "Count One", "/opt/count/1", "工具", QString(), QString(), now, now)
+          << SoftwareItem("count-2", "Count Two", "/opt/count/2", "工具", QString(), QString(), now, now)
+          << SoftwareItem("count-3", "Count Three", "/opt/count/3", "游戏", QString(), QString(), now, now)
+          << SoftwareItem("count-4", "Count Four", "/opt/count/4", QString(), QString(), QString(), now, now);
+    QVERIFY(databaseManager.batchInsertSoftwareItems(items));
+    QVERIFY(databaseManager.addCategory("空分类"));
+    
+    QHash<QString, int> counts = databaseManager.getCategoryCounts();
+    QCOMPARE(counts.size(), 3);
+    QCOMPARE(counts.value("工具"), 2);
+    QCOMPARE(counts.value("游戏"), 1);
+    QCOMPARE(counts.value("空分类"), 0);
+    
+    // 移动、合并、删除都由触发器更新计数
+    QVERIFY(databaseManager.moveSoftwareToCategory("count-1", "游戏"));
+    QList<SoftwareItem> scanned;
+    scanned << SoftwareItem("count-5", "Count Five", "/opt/count/5", "影音", QString(), QString(), now, now)
+            << SoftwareItem("rescan-4", "Count Four", "/opt/count/4", "影音", QString(), QString(), now, now);
+    QVERIFY(databaseManager.ingestSoftwareItems(scanned));
+    QVERIFY(databaseManager.removeSoftwareItem("count-2"));
+    
+    counts = databaseManager.getCategoryCounts();
+    QCOMPARE(counts.value("工具"), 0);
+    QCOMPARE(counts.value("游戏"), 2);
+    QCOMPARE(counts.value("影音"), 2);
+    QCOMPARE(databaseManager.getCategoryCount("影音"), 2);
+    
+    // 重命名只改分类行，计数不变，读出的分类名称和全文索引随之更新
+    QVERIFY(databaseManager.renameCategory("游戏", "Arcade"));
+    QVERIFY(!databaseManager.renameCategory("Arcade", "影音"));
+    QVERIFY(!databaseManager.categoryExists("游戏"));
+    QCOMPARE(databaseManager.getCategoryCount("Arcade"), 2);
+    QCOMPARE(databaseManager.getSoftwareItemById("count-3").getCategory(), QString("Arcade"));
+    QCOMPARE(databaseManager.getSoftwareItemsByCategory("Arcade").size(), 2);
+    QCOMPARE(databaseManager.searchSoftwareItems("arcade").size(), 2);
+    QVERIFY(databaseManager.searchSoftwareItems("游戏").isEmpty());
+    
+    // 删除分类后软件项不再属于任何分类，计数和列表一致
+    QVERIFY(databaseManager.removeCategory("影音"));
+    QVERIFY(!databaseManager.getCategoryCounts().contains("影音"));
+    QVERIFY(databaseManager.getSoftwareItemById("count-5").getCategory().isEmpty());
+    QVERIFY(databaseManager.getSoftwareItemsByCategory("影音").isEmpty());
+    QVERIFY(databaseManager.searchSoftwareItems("影音").isEmpty());
+    
+    // 再次扫描到时重新关联到扫描到的分类
+    QList<SoftwareItem> rescanned;
+    rescanned << SoftwareItem("rescan-5", "Count Five", "/opt/count/5", "影音", QString(), QString(), now, now);
+    DatabaseManager::IngestResult result;
+    QVERIFY(databaseManager.ingestSoftwareItems(rescanned, &result));
+    QCOMPARE(result.updated.size(), 1);
+    QCOMPARE(result.updated.first().getCategory(), QString("影音"));
+    QCOMPARE(databaseManager.getCategoryCount("影音"), 1);
+    QCOMPARE(databaseManager.getSoftwareItemsByCategory("影音").size(), 1);
+    QCOMPARE(databaseManager.searchSoftwareItems("影音").size(), 1);
+}
+
 void TestDatabaseManager::testSoftwareItemExists()
 {
     // 测试不存在的软件项
@@ -382,6 +658,215 @@ void TestDatabaseManager::testGetDatabaseSize()
     QVERIFY(newSize >= initialSize);
 }
 
+void TestDatabaseManager::testDirectorySnapshots()
+{
+    DirectorySnapshot snapshot;
+    snapshot.path = m_tempDir->path() + "/snapshot_dir";
+    snapshot.modifiedTime = 1700000000000;
+    snapshot.inode = 42;
+    snapshot.entryCount = 3;
+    snapshot.scannedAt = 1700000005000;
+    snapshot.subDirectories << snapshot.path + "/sub";
+    snapshot.files << snapshot.path + "/a.exe" << snapshot.path + "/b.exe";
+    
+    // 保存并读回快照
+    QVERIFY(m_databaseManager->saveDirectorySnapshots(QList<DirectorySnapshot>() << snapshot, QStringList()));
+    
+    bool found = false;
+    for (const DirectorySnapshot& loaded : m_databaseManager->getDirectorySnapshots()) {
+        if (loaded.path == snapshot.path) {
+            found = true;
+            QCOMPARE(loaded.modifiedTime, snapshot.modifiedTime);
+            QCOMPARE(loaded.inode, snapshot.inode);
+            QCOMPARE(loaded.entryCount, snapshot.entryCount);
+            QCOMPARE(loaded.scannedAt, snapshot.scannedAt);
+            QCOMPARE(loaded.subDirectories, snapshot.subDirectories);
+            QCOMPARE(loaded.files, snapshot.files);
+        }
+    }
+    QVERIFY(found);
+    
+    // 删除快照
+    QVERIFY(m_databaseManager->saveDirectorySnapshots(QList<DirectorySnapshot>(), QStringList() << snapshot.path));
+    for (const DirectorySnapshot& loaded : m_databaseManager->getDirectorySnapshots()) {
+        QVERIFY(loaded.path != snapshot.path);
+    }
+}
+
+void TestDatabaseManager::testFullTextSearch()
+{
+    QDateTime now = QDateTime::currentDateTime();
+    SoftwareItem editor("fts-1", "Quillwright Editor", m_tempDir->path() + "/fts_editor.exe", "全文测试分类",
+                        "Plain text editing", QString(), now, now);
+    SoftwareItem viewer("fts-2", "Marblefoot Viewer", m_tempDir->path() + "/fts_viewer.exe", "全文测试分类",
+                        "Preview files written with Quillwright", QString(), now, now);
+    QVERIFY(m_databaseManager->batchInsertSoftwareItems(QList<SoftwareItem>() << editor << viewer));
+    
+    // 前缀匹配，名称命中的结果排在描述命中之前
+    QList<SoftwareItem> results = m_databaseManager->searchSoftwareItems("quillw");
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results.at(0).getId(), QString("fts-1"));
+    QCOMPARE(results.at(1).getId(), QString("fts-2"));
+    QCOMPARE(m_databaseManager->searchSoftwareItems("quillw", 1).size(), 1);
+    
+    // 多个关键字同时满足
+    results = m_databaseManager->searchSoftwareItems("marble prev");
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().getName(), QString("Marblefoot Viewer"));
+    
+    // FTS5语法字符按普通文本处理
+    results = m_databaseManager->searchSoftwareItems("\"quillw\" marble- -");
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().getId(), QString("fts-2"));
+    QVERIFY(m_databaseManager->searchSoftwareItems("- *").isEmpty());
+    QVERIFY(m_databaseManager->searchSoftwareItems("   ").isEmpty());
+    
+    // 触发器同步更新和删除
+    editor.setName("Inkwell Editor");
+    QVERIFY(m_databaseManager->updateSoftwareItem(editor));
+    QCOMPARE(m_databaseManager->searchSoftwareItems("inkwell").size(), 1);
+    results = m_databaseManager->searchSoftwareItems("quillw");
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().getId(), QString("fts-2"));
+    
+    QVERIFY(m_databaseManager->removeSoftwareItem("fts-1"));
+    QVERIFY(m_databaseManager->removeSoftwareItem("fts-2"));
+    QVERIFY(m_databaseManager->searchSoftwareItems("inkwell").isEmpty());
+    QVERIFY(m_databaseManager->searchSoftwareItems("marblefoot").isEmpty());
+}
+
+void TestDatabaseManager::testPerformanceProfile()
+{
+    // 推荐配置在打开时应用到连接上
+    QVERIFY(m_databaseManager->setPerformanceProfile(DatabaseManager::PerformanceProfile::tuned()));
+    QCOMPARE(m_databaseManager->pragmaValue("journal_mode").toString().toLower(), QString("wal"));
+    QCOMPARE(m_databaseManager->pragmaValue("synchronous").toInt(), 1);
+    QCOMPARE(m_databaseManager->pragmaValue("cache_size").toInt(), -16 * 1024);
+    QCOMPARE(m_databaseManager->pragmaValue("temp_store").toInt(), 2);
+    QCOMPARE(m_databaseManager->pragmaValue("busy_timeout").toInt(), 5000);
+    
+    // 重新打开后沿用当前配置
+    QVERIFY(m_databaseManager->initializeDatabase());
+    QCOMPARE(m_databaseManager->pragmaValue("synchronous").toInt(), 1);
+    
+    // 切换回SQLite默认行为
+    QVERIFY(m_databaseManager->setPerformanceProfile(DatabaseManager::PerformanceProfile::sqliteDefaults()));
+    QCOMPARE(m_databaseManager->pragmaValue("journal_mode").toString().toLower(), QString("delete"));
+    QCOMPARE(m_databaseManager->pragmaValue("synchronous").toInt(), 2);
+    QCOMPARE(m_databaseManager->pragmaValue("mmap_size").toLongLong(), 0LL);
+    
+    // 切换日志模式后语句缓存仍然可用
+    QVERIFY(m_databaseManager->getAllSoftwareItems().size() >= 0);
+    QVERIFY(m_databaseManager->setPerformanceProfile(DatabaseManager::PerformanceProfile::tuned()));
+    QVERIFY(!m_databaseManager->softwareItemExists("no-such-item"));
+}
+
+void TestDatabaseManager::testSchemaMigration()
+{
+    // 用旧版本的表结构创建数据库：没有icon_key列和任何索引，同一路径有两条记录
+    const QString legacyPath = m_tempDir->path() + "/legacy.db";
+    {
+        QSqlDatabase legacy = QSqlDatabase::addDatabase("QSQLITE", "legacy_schema");
+        legacy.setDatabaseName(legacyPath);
+        QVERIFY(legacy.open());
+        
+        QSqlQuery query(legacy);
+        QVERIFY(query.exec("CREATE TABLE software_items (id TEXT PRIMARY KEY, name TEXT NOT NULL, file_path TEXT NOT NULL, "
+                           "category TEXT, description TEXT, version TEXT, "
+                           "created_at DATETIME NOT NULL, updated_at DATETIME NOT NULL)"));
+        QVERIFY(query.exec("INSERT INTO software_items VALUES "
+                           "('old', 'Editor', '/opt/legacy/editor', '开发工具', '', '', '2024-01-01T00:00:00', '2024-01-01T00:00:00'), "
+                           "('new', 'Editor', '/opt/legacy/editor', '开发工具', '', '', '2024-01-01T00:00:00', '2024-06-01T00:00:00'), "
+                           "('viewer', 'Viewer', '/opt/legacy/viewer', '图像', '', '', '2024-01-01T00:00:00', '2024-01-01T00:00:00')"));
+        legacy.close();
+    }
+    QSqlDatabase::removeDatabase("legacy_schema");
+    
+    {
+        DatabaseManager databaseManager(legacyPath);
+        QVERIFY(databaseManager.initializeDatabase());
+        QCOMPARE(databaseManager.schemaVersion(), DatabaseManager::SchemaVersion);
+        
+        // 重复的路径只保留最近更新的记录，其余数据原样保留
+        QList<SoftwareItem> items = databaseManager.getAllSoftwareItems();
+        QCOMPARE(items.size(), 2);
+        QVERIFY(databaseManager.softwareItemExists("new"));
+        QVERIFY(!databaseManager.softwareItemExists("old"));
+        QCOMPARE(databaseManager.getSoftwareItemById("viewer").getCategory(), QString("图像"));
+        QCOMPARE(databaseManager.searchSoftwareItems("editor").size(), 1);
+        
+        // 已有的分类名称建立了分类行和计数
+        QCOMPARE(databaseManager.getCategoryCounts().value("开发工具"), 1);
+        QCOMPARE(databaseManager.getCategoryCounts().value("图像"), 1);
+        
+        // ISO字符串的时间转换为时间戳，读出的时间不变
+        QCOMPARE(databaseManager.getSoftwareItemById("viewer").getCreatedAt(), QDateTime(QDate(2024, 1, 1), QTime(0, 0)));
+        QCOMPARE(databaseManager.getSoftwareItemById("new").getUpdatedAt(), QDateTime(QDate(2024, 6, 1), QTime(0, 0)));
+        
+        // 路径唯一索引生效
+        QDateTime now = QDateTime::currentDateTime();
+        QVERIFY(!databaseManager.addSoftwareItem(SoftwareItem("copy", "Viewer", "/opt/legacy/viewer", "图像",
+                                                              QString(), QString(), now, now)));
+        
+        // 按添加时间查询
+        QVERIFY(databaseManager.getSoftwareItemsAddedSince(QDateTime(QDate(2024, 3, 1), QTime(0, 0))).isEmpty());
+        QVERIFY(databaseManager.addSoftwareItem(SoftwareItem("recent", "Recent", "/opt/legacy/recent", "图像",
+                                                             QString(), QString(), now, now)));
+        QList<SoftwareItem> recent = databaseManager.getSoftwareItemsAddedSince(now.addSecs(-60));
+        QCOMPARE(recent.size(), 1);
+        QCOMPARE(recent.first().getCreatedAt(), now);
+        QCOMPARE(databaseManager.getSoftwareItemsAddedSince(QDateTime(QDate(2023, 1, 1), QTime(0, 0)), 2).first().getId(),
+                 QString("recent"));
+        
+        // 再次打开时不会重复迁移
+        QVERIFY(databaseManager.initializeDatabase());
+        QCOMPARE(databaseManager.schemaVersion(), DatabaseManager::SchemaVersion);
+        QCOMPARE(databaseManager.getAllSoftwareItems().size(), 3);
+    }
+    
+    // 按分类查询使用(category_id, name)索引，不再全表扫描和排序
+    {
+        QSqlDatabase check = QSqlDatabase::addDatabase("QSQLITE", "legacy_check");
+        check.setDatabaseName(legacyPath);
+        QVERIFY(check.open());
+        
+        QSqlQuery query(check);
+        QVERIFY(query.exec("EXPLAIN QUERY PLAN SELECT s.id, c.name FROM software_items s "
+                           "LEFT JOIN categories c ON c.id = s.category_id "
+                           "WHERE s.category_id = (SELECT id FROM categories WHERE name = '图像') ORDER BY s.name, s.rowid"));
+        QString plan;
+        while (query.next()) {
+            plan += query.value(3).toString() + "\n";
+        }
+        QVERIFY2(plan.contains("idx_software_items_category_id_name"), qPrintable(plan));
+        QVERIFY2(!plan.contains("TEMP B-TREE"), qPrintable(plan));
+        
+        // icon_key列由版本1的迁移补上
+        QVERIFY(query.exec("SELECT icon_key FROM software_items LIMIT 1"));
+        
+        // 分类名称只保存在分类表中
+        QVERIFY(query.exec("SELECT COUNT(*) FROM software_items WHERE category IS NOT NULL"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+        
+        // 按分类名称的旧索引已删除，只留下(category_id, name)索引
+        QVERIFY(query.exec("SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = 'software_items' "
+                           "AND name LIKE 'idx_software_items_category%'"));
+        QStringList categoryIndexes;
+        while (query.next()) {
+            categoryIndexes << query.value(0).toString();
+        }
+        QCOMPARE(categoryIndexes, QStringList() << "idx_software_items_category_id_name");
+        
+        // 时间以整数保存
+        QVERIFY(query.exec("SELECT COUNT(*) FROM software_items WHERE typeof(created_at) != 'integer' OR typeof(updated_at) != 'integer'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+        check.close();
+    }
+    QSqlDatabase::removeDatabase("legacy_check");
+}
+
 void TestDatabaseManager::cleanupTestCase()
 {
     delete m_databaseManager;
@@ -0,0 +1,213 @@
+#include <QtTest/QtTest>
+#include "../src/core/DatabaseReaderPool.hpp"
+#include "TestHelpers.hpp"
+#include <QTemporaryDir>
+#include <QSemaphore>
+
+class TestDatabaseReaderPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testReadersRunInParallel();
+    void testReadersAreReadOnly();
+    void testReadersOpenOnFirstQuery();
+    void testSetPerformanceProfile();
+    void testReadsDuringWrite();
+    void testAsyncQueries();
+    void testOnlineBackupAndRestore();
+
+private:
+    QTemporaryDir m_tempDir;
+    QString m_dbPath;
+};
+
+void TestDatabaseReaderPool::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+    m_dbPath = m_tempDir.filePath("readers.db");
+    
+    // 读连接只能打开写连接已经建好的数据库
+    DatabaseManager databaseManager(m_dbPath);
+    QVERIFY(databaseManager.initializeDatabase());
+    QList<SoftwareItem> items;
+    items << testSoftwareItem("reader-1", "Alpha Editor", "工具") << testSoftwareItem("reader-2", "Beta Player", "影音")
+          << testSoftwareItem("reader-3", "Gamma Editor", "工具");
+    QVERIFY(databaseManager.ingestSoftwareItems(items));
+}
+
+void TestDatabaseReaderPool::testReadersRunInParallel()
+{
+    DatabaseReaderPool pool(m_dbPath, 4);
+    QCOMPARE(pool.readerCount(), 4);
+    
+    // 每个查询都等待所有查询开始后才结束，只有各自在不同的连接上同时执行才能全部完成
+    QSemaphore started;
+    QSemaphore go;
+    QList<QFuture<bool>> futures;
+    for (int i = 0; i < 4; ++i) {
+        futures << pool.run([&started, &go](DatabaseManager& databaseManager) {
+            started.release();
+            bool allStarted = go.tryAcquire(1, 5000);
+            return allStarted && databaseManager.getCategoryCount("工具") == 2;
+        });
+    }
+    
+    QVERIFY(started.tryAcquire(4, 5000));
+    go.release(4);
+    for (QFuture<bool>& future : futures) {
+        QVERIFY(future.result());
+    }
+}
+
+void TestDatabaseReaderPool::testReadersAreReadOnly()
+{
+    DatabaseReaderPool pool(m_dbPath, 1);
+    QVERIFY(pool.run([](DatabaseManager& databaseManager) {
+        return databaseManager.isReadOnly();
+    }).result());
+    
+    // 写入通过只读连接会失败
+    QVERIFY(!pool.run([](DatabaseManager& databaseManager) {
+        return databaseManager.addSoftwareItem(testSoftwareItem("reader-write", "Write", "工具"));
+    }).result());
+    QVERIFY(pool.getSoftwareItemByIdAsync("reader-write").result().getId().isEmpty());
+}
+
+void TestDatabaseReaderPool::testReadersOpenOnFirstQuery()
+{
+    // 连接池先于数据库文件创建，写连接建表之后的第一个查询才打开读连接
+    const QString dbPath = m_tempDir.filePath("lazy-readers.db");
+    DatabaseReaderPool pool(dbPath, 1);
+    QVERIFY(!QFile::exists(dbPath));
+    
+    DatabaseExecutor writer(dbPath);
+    QVERIFY(writer.run([](DatabaseManager& databaseManager) {
+        return databaseManager.addSoftwareItem(testSoftwareItem("lazy-1", "Lazy App", "工具"));
+    }).result());
+    QCOMPARE(pool.getCategoryCountAsync("工具").result(), 1);
+}
+
+void TestDatabaseReaderPool::testSetPerformanceProfile()
+{
+    // 新的配置应用到每个已打开的读连接上
+    DatabaseReaderPool pool(m_dbPath, 2);
+    DatabaseManager::PerformanceProfile profile = DatabaseManager::PerformanceProfile::tuned();
+    profile.cacheSizeMb = 4;
+    pool.setPerformanceProfile(profile);
+    pool.waitForIdle();
+    
+    // 两个查询同时执行才会分到不同的读连接上
+    QSemaphore started;
+    QSemaphore go;
+    QList<QFuture<int>> futures;
+    for (int i = 0; i < pool.readerCount(); ++i) {
+        futures << pool.run([&started, &go](DatabaseManager& databaseManager) {
+            started.release();
+            go.tryAcquire(1, 5000);
+            return databaseManager.pragmaValue("cache_size").toInt();
+        });
+    }
+    QVERIFY(started.tryAcquire(pool.readerCount(), 5000));
+    go.release(pool.readerCount());
+    for (QFuture<int>& future : futures) {
+        QCOMPARE(future.result(), -4 * 1024);
+    }
+}
+
+void TestDatabaseReaderPool::testReadsDuringWrite()
+{
+    DatabaseExecutor writer(m_dbPath);
+    DatabaseReaderPool pool(m_dbPath, 2);
+    
+    // 写线程忙于扫描写入时，读连接上的查询不必排在它后面
+    QSemaphore writing;
+    QSemaphore finish;
+    QFuture<bool> write = writer.run([&writing, &finish](DatabaseManager& databaseManager) {
+        writing.release();
+        finish.tryAcquire(1, 5000);
+        QList<SoftwareItem> items;
+        items << testSoftwareItem("reader-pending", "Pending Editor", "工具");
+        return databaseManager.ingestSoftwareItems(items);
+    });
+    
+    QVERIFY(writing.tryAcquire(1, 5000));
+    QCOMPARE(pool.getCategoryCountAsync("工具").result(), 2);
+    QVERIFY(!write.isFinished());
+    
+    // 写入提交后，读连接上新的查询能看到结果
+    finish.release();
+    QVERIFY(write.result());
+    QCOMPARE(pool.getCategoryCountAsync("工具").result(), 3);
+    
+    QVERIFY(writer.removeSoftwareItemAsync("reader-pending").result());
+}
+
+void TestDatabaseReaderPool::testAsyncQueries()
+{
+    DatabaseReaderPool pool(m_dbPath, 2);
+    
+    QList<SoftwareItem> results = pool.searchSoftwareItemsAsync("editor").result();
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(pool.getSoftwareItemByIdAsync("reader-2").result().getName(), QString("Beta Player"));
+    QCOMPARE(pool.getCategoryCountAsync("影音").result(), 1);
+    
+    // 带上下文对象的回调在调用者线程中执行
+    QObject context;
+    QThread* callbackThread = nullptr;
+    pool.getCategoryCountAsync("工具").then(&context, [&](int) {
+        callbackThread = QThread::currentThread();
+    });
+    QTRY_VERIFY(callbackThread != nullptr);
+    QCOMPARE(callbackThread, QThread::currentThread());
+    
+    pool.waitForIdle();
+}
+
+void TestDatabaseReaderPool::testOnlineBackupAndRestore()
+{
+    DatabaseExecutor writer(m_dbPath);
+    DatabaseReaderPool pool(m_dbPath, 2);
+    const QString backupPath = m_tempDir.filePath("online-backup.db");
+    
+    // 写线程被占用时备份照常在读连接上完成
+    QSemaphore writing;
+    QSemaphore finish;
+    QFuture<bool> write = writer.run([&writing, &finish](DatabaseManager& databaseManager) {
+        writing.release();
+        finish.tryAcquire(1, 5000);
+        QList<SoftwareItem> items;
+        items << testSoftwareItem("reader-after-backup", "After Backup", "工具");
+        return databaseManager.ingestSoftwareItems(items);
+    });
+    QVERIFY(writing.tryAcquire(1, 5000));
+    QVERIFY(pool.backupDatabaseAsync(backupPath).result());
+    QVERIFY(!write.isFinished());
+    finish.release();
+    QVERIFY(write.result());
+    QVERIFY(QFile::exists(backupPath));
+    QVERIFY(!QFile::exists(backupPath + ".tmp"));
+    
+    // 备份是写入前的快照
+    {
+        DatabaseManager backup(backupPath, DatabaseManager::ReadOnly);
+        QVERIFY(backup.initializeDatabase());
+        QCOMPARE(backup.getCategoryCount("工具"), 2);
+        QVERIFY(backup.getSoftwareItemById("reader-after-backup").getId().isEmpty());
+    }
+    
+    // 恢复时读连接保持打开，提交后直接读到恢复的数据
+    QCOMPARE(pool.getCategoryCountAsync("工具").result(), 3);
+    QVERIFY(writer.restoreDatabaseAsync(backupPath).result());
+    QCOMPARE(pool.getCategoryCountAsync("工具").result(), 2);
+    QCOMPARE(pool.searchSoftwareItemsAsync("editor").result().size(), 2);
+    QVERIFY(pool.getSoftwareItemByIdAsync("reader-after-backup").result().getId().isEmpty());
+    
+    // 已存在的备份被替换
+    QVERIFY(pool.backupDatabaseAsync(backupPath).result());
+    QVERIFY(!writer.restoreDatabaseAsync(m_tempDir.filePath("missing.db")).result());
+}
+
+QTEST_MAIN(TestDatabaseReaderPool)
+#include "TestDatabaseReaderPool.moc"
@@ -0,0 +1,179 @@
+#include <QtTest/QtTest>
+#include "../src/utils/DesktopEntryParser.hpp"
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestDesktopEntryParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testParseBasicEntry();
+    void testLocalizedKeys();
+    void testHiddenEntries();
+    void testIgnoresOtherGroups();
+    void testEscapedValues();
+    void testParseFile();
+    void testCategoryMapping();
+    void testExecArguments();
+};
+
+void TestDesktopEntryParser::testParseBasicEntry()
+{
+    DesktopEntryParser parser("en_US");
+    DesktopEntry entry = parser.parse(
+        "# 注释行\n"
+        "[Desktop Entry]\n"
+        "Type=Application\n"
+        "Name=Text Editor\n"
+        "GenericName=Editor\n"
+        "Comment=Edit text files\n"
+        "Exec=gedit %U\n"
+        "Icon=accessories-text-editor\n"
+        "Categories=GNOME;GTK;Utility;TextEditor;\n");
+
+    QVERIFY(entry.valid);
+    QVERIFY(entry.isDisplayable());
+    QCOMPARE(entry.type, QString("Application"));
+    QCOMPARE(entry.name, QString("Text Editor"));
+    QCOMPARE(entry.genericName, QString("Editor"));
+    QCOMPARE(entry.comment, QString("Edit text files"));
+    QCOMPARE(entry.exec, QString("gedit %U"));
+    QCOMPARE(entry.icon, QString("accessories-text-editor"));
+    QCOMPARE(entry.categories, QStringList() << "GNOME" << "GTK" << "Utility" << "TextEditor");
+}
+
+void TestDesktopEntryParser::testLocalizedKeys()
+{
+    const char* content =
+        "[Desktop Entry]\r\n"
+        "Type=Application\r\n"
+        "Name[zh]=编辑器\r\n"
+        "Name=Editor\r\n"
+        "Name[zh_CN]=文本编辑器\r\n"
+        "Name[de]=Texteditor\r\n"
+        "Comment[zh]=编辑文本\r\n"
+        "Comment=Edit text\r\n";
+
+    // 优先完全匹配，其次只匹配语言，最后是未本地化的值
+    DesktopEntry chinese = DesktopEntryParser("zh_CN.UTF-8").parse(content);
+    QCOMPARE(chinese.name, QString("文本编辑器"));
+    QCOMPARE(chinese.comment, QString("编辑文本"));
+
+    DesktopEntry taiwan = DesktopEntryParser("zh_TW").parse(content);
+    QCOMPARE(taiwan.name, QString("编辑器"));
+
+    DesktopEntry english = DesktopEntryParser("en_US").parse(content);
+    QCOMPARE(english.name, QString("Editor"));
+    QCOMPARE(english.comment, QString("Edit text"));
+}
+
+void TestDesktopEntryParser::testHiddenEntries()
+{
+    DesktopEntryParser parser("en_US");
+
+    DesktopEntry noDisplay = parser.parse("[Desktop Entry]\nType=Application\nName=Helper\nNoDisplay=true\n");
+    QVERIFY(noDisplay.valid);
+    QVERIFY(noDisplay.noDisplay);
+    QVERIFY(!noDisplay.isDisplayable());
+
+    DesktopEntry hidden = parser.parse("[Desktop Entry]\nType=Application\nName=Removed\nHidden=true\n");
+    QVERIFY(hidden.hidden);
+    QVERIFY(!hidden.isDisplayable());
+
+    DesktopEntry link = parser.parse("[Desktop Entry]\nType=Link\nName=Website\nURL=https://example.com\n");
+    QVERIFY(!link.isDisplayable());
+
+    DesktopEntry invalid = parser.parse("Name=No group\n");
+    QVERIFY(!invalid.valid);
+    QVERIFY(!invalid.isDisplayable());
+}
+
+void TestDesktopEntryParser::testIgnoresOtherGroups()
+{
+    // 动作组中的同名键不能覆盖主组的值
+    DesktopEntry entry = DesktopEntryParser("en_US").parse(
+        "[Desktop Entry]\n"
+        "Type=Application\n"
+        "Name=Browser\n"
+        "Exec=browser %u\n"
+        "Actions=new-window;\n"
+        "\n"
+        "[Desktop Action new-window]\n"
+        "Name=New Window\n"
+        "Exec=browser --new-window\n");
+
+    QCOMPARE(entry.name, QString("Browser"));
+    QCOMPARE(entry.exec, QString("browser %u"));
+}
+
+void TestDesktopEntryParser::testEscapedValues()
+{
+    DesktopEntry entry = DesktopEntryParser("en_US").parse(
+        "[Desktop Entry]\n"
+        "Type=Application\n"
+        "Name=  Spaced\\sName  \n"
+        "Comment=Line one\\nLine two\n"
+        "Exec=\"/opt/My App/run\" --flag\n");
+
+    QCOMPARE(entry.name, QString("Spaced Name"));
+    QCOMPARE(entry.comment, QString("Line one\nLine two"));
+    QCOMPARE(entry.exec, QString("\"/opt/My App/run\" --flag"));
+}
+
+void TestDesktopEntryParser::testParseFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QString filePath = tempDir.path() + "/app.desktop";
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("[Desktop Entry]\nType=Application\nName=Mapped\nCategories=Development;IDE;\n");
+    file.close();
+
+    DesktopEntryParser parser("en_US");
+    DesktopEntry entry = parser.parseFile(filePath);
+    QVERIFY(entry.isDisplayable());
+    QCOMPARE(entry.name, QString("Mapped"));
+    QCOMPARE(DesktopEntryParser::categoryFor(entry.categories), QString("开发工具"));
+
+    // 空文件和不存在的文件都得到无效条目
+    QFile emptyFile(tempDir.path() + "/empty.desktop");
+    QVERIFY(emptyFile.open(QIODevice::WriteOnly));
+    emptyFile.close();
+    QVERIFY(!parser.parseFile(emptyFile.fileName()).valid);
+    QVERIFY(!parser.parseFile(tempDir.path() + "/missing.desktop").valid);
+}
+
+void TestDesktopEntryParser::testCategoryMapping()
+{
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "Office" << "WordProcessor"), QString("办公软件"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "Development"), QString("开发工具"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "AudioVideo" << "Player"), QString("娱乐媒体"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "Game"), QString("娱乐媒体"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "GTK" << "System"), QString("系统工具"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList() << "GTK"), QString("未分类"));
+    QCOMPARE(DesktopEntryParser::categoryFor(QStringList()), QString("未分类"));
+}
+
+void TestDesktopEntryParser::testExecArguments()
+{
+    QCOMPARE(DesktopEntryParser::execArguments("gedit %U"), QStringList() << "gedit");
+    QCOMPARE(DesktopEntryParser::execArguments("\"/opt/My App/run\" --flag %f"),
+             QStringList() << "/opt/My App/run" << "--flag");
+    QCOMPARE(DesktopEntryParser::execArguments("sh -c \"echo \\\"hi\\\"\""),
+             QStringList() << "sh" << "-c" << "echo \"hi\"");
+    QCOMPARE(DesktopEntryParser::execArguments("app --progress=50%%"),
+             QStringList() << "app" << "--progress=50%");
+
+    DesktopEntry entry;
+    entry.name = "Viewer";
+    entry.icon = "viewer";
+    QCOMPARE(DesktopEntryParser::execArguments("viewer %i --title=%c %k", entry, "/usr/share/applications/viewer.desktop"),
+             QStringList() << "viewer" << "--icon" << "viewer" << "--title=Viewer"
+                           << "/usr/share/applications/viewer.desktop");
+}
+
+QTEST_MAIN(TestDesktopEntryParser)
+#include "TestDesktopEntryParser.moc"
@@ -0,0 +1,80 @@
+#include <QtTest/QtTest>
+#include "../src/utils/FuzzyMatcher.hpp"
+
+class TestFuzzyMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSubsequenceMatch();
+    void testCaseInsensitive();
+    void testEmptyPattern();
+    void testBoundaryBonus();
+    void testCamelCaseBonus();
+    void testPrefersBestAlignment();
+    void testCharacterMask();
+};
+
+void TestFuzzyMatcher::testSubsequenceMatch()
+{
+    QVERIFY(FuzzyMatcher("vsc").score("Visual Studio Code") > 0);
+    QVERIFY(FuzzyMatcher("ff").score("Firefox") > 0);
+    QVERIFY(FuzzyMatcher("编辑").score("文本编辑器") > 0);
+    
+    // 字符必须按顺序出现
+    QCOMPARE(FuzzyMatcher("cv").score("Visual Studio Code"), -1);
+    QCOMPARE(FuzzyMatcher("xyz").score("Firefox"), -1);
+    QCOMPARE(FuzzyMatcher("firefoxes").score("Firefox"), -1);
+}
+
+void TestFuzzyMatcher::testCaseInsensitive()
+{
+    QCOMPARE(FuzzyMatcher("FIREFOX").score("Firefox"), FuzzyMatcher("firefox").score("Firefox"));
+    QVERIFY(FuzzyMatcher("GIMP").score("gimp") > 0);
+}
+
+void TestFuzzyMatcher::testEmptyPattern()
+{
+    FuzzyMatcher matcher("  ");
+    QVERIFY(matcher.isEmpty());
+    QCOMPARE(matcher.score("Anything"), 0);
+}
+
+void TestFuzzyMatcher::testBoundaryBonus()
+{
+    // 单词开头的匹配优于单词中间的匹配
+    QVERIFY(FuzzyMatcher("ss").score("Sound Settings") > FuzzyMatcher("ss").score("Glassware"));
+    QVERIFY(FuzzyMatcher("ff").score("Firefox") > FuzzyMatcher("ff").score("Diff Viewer"));
+    QVERIFY(FuzzyMatcher("ter").score("Terminal") > FuzzyMatcher("ter").score("Master"));
+}
+
+void TestFuzzyMatcher::testCamelCaseBonus()
+{
+    QVERIFY(FuzzyMatcher("gc").score("GoogleChrome") > FuzzyMatcher("gc").score("Gecko"));
+}
+
+void TestFuzzyMatcher::testPrefersBestAlignment()
+{
+    // "Visual"中的s更早出现，只有选择单词开头的"Studio"，
+    // 得分才会高于s只能落在单词中间的文本
+    FuzzyMatcher matcher("vsc");
+    QVERIFY(matcher.score("Visual Studio Code") > matcher.score("Visualis Code"));
+    
+    // 后面出现的单词开头也会被找到
+    QCOMPARE(FuzzyMatcher("ff").score("Off Firefox"), FuzzyMatcher("ff").score("Firefox"));
+}
+
+void TestFuzzyMatcher::testCharacterMask()
+{
+    FuzzyMatcher matcher("Vsc");
+    QCOMPARE(matcher.patternMask(), FuzzyMatcher::characterMask("vsc"));
+    
+    // 位图只能排除不可能的匹配，通过预筛选不代表一定匹配
+    QVERIFY(FuzzyMatcher::mayMatch(matcher.patternMask(), FuzzyMatcher::characterMask("Visual Studio Code")));
+    QVERIFY(FuzzyMatcher::mayMatch(matcher.patternMask(), FuzzyMatcher::characterMask("csv")));
+    QCOMPARE(matcher.score("csv"), -1);
+    QVERIFY(!FuzzyMatcher::mayMatch(matcher.patternMask(), FuzzyMatcher::characterMask("Firefox")));
+}
+
+QTEST_MAIN(TestFuzzyMatcher)
+#include "TestFuzzyMatcher.moc"
@@ -0,0 +1,16 @@
+#ifndef TESTHELPERS_H
+#define TESTHELPERS_H
+
+#include "../src/model/SoftwareItem.hpp"
+#include <QDateTime>
+
+// 测试用的软件项：创建和更新时间为当前时间；不指定路径时按id生成互不相同的路径
+inline SoftwareItem testSoftwareItem(const QString& id, const QString& name, const QString& category = "未分类",
+                                     const QString& filePath = QString(), const QString& description = QString())
+{
+    QDateTime now = QDateTime::currentDateTime();
+    return SoftwareItem(id, name, filePath.isEmpty() ? "/opt/test/" + id : filePath, category,
+                        description, QString(), now, now);
+}
+
+#endif // TESTHELPERS_H
@@ -0,0 +1,299 @@
+#include <QtTest/QtTest>
+#include "../src/utils/IconExtractor.hpp"
+#include <QTemporaryDir>
+#include <QImage>
+#include <QBuffer>
+
+class TestIconExtractor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testExtractIcon();
+    void testRenderIcon();
+    void testRequestIconDeduplicated();
+    void testSystemIconResolvedOnGuiThread();
+    void testFindThemeIconFile();
+    void testThemeIconResolvedOffThread();
+    void testExtractIconAsync();
+    void testDiskCache();
+    void testDiskCacheEviction();
+    void testDiskCacheEvictionWithinBatch();
+    void cleanupTestCase();
+
+public slots:
+    void onIconExtracted(const QString& filePath, const QIcon& icon);
+
+private:
+    QTemporaryDir* m_tempDir;
+    QString m_imagePath;
+    QStringList m_extractedPaths;
+};
+
+void TestIconExtractor::initTestCase()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    
+    // 创建一个图片文件作为图标来源
+    m_imagePath = m_tempDir->path() + "/icon.png";
+    QImage image(128, 64, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+    QVERIFY(image.save(m_imagePath));
+}
+
+void TestIconExtractor::testExtractIcon()
+{
+    IconExtractor extractor;
+    
+    QIcon icon = extractor.extractIcon(m_imagePath);
+    QVERIFY(!icon.isNull());
+    QVERIFY(!extractor.cachedIcon(m_imagePath).isNull());
+    
+    // 不存在的文件使用默认图标
+    QVERIFY(!extractor.extractIcon(m_tempDir->path() + "/missing.exe").isNull());
+}
+
+void TestIconExtractor::testRenderIcon()
+{
+    // 图片按目标尺寸等比例缩放
+    QImage image = IconExtractor::renderIcon(m_imagePath, QSize(32, 32));
+    QCOMPARE(image.size(), QSize(32, 16));
+    
+    QVERIFY(IconExtractor::renderIcon(m_tempDir->path() + "/missing.png", QSize(32, 32)).isNull());
+}
+
+void TestIconExtractor::testRequestIconDeduplicated()
+{
+    IconExtractor extractor;
+    QSignalSpy iconReadySpy(&extractor, &IconExtractor::iconReady);
+    
+    // 同一来源的多次请求只加载一次
+    QVERIFY(extractor.cachedIcon(m_imagePath).isNull());
+    extractor.requestIcon(m_imagePath, QSize(48, 48));
+    extractor.requestIcon(m_imagePath, QSize(48, 48));
+    extractor.requestIcon(m_imagePath, QSize(48, 48));
+    
+    QVERIFY(iconReadySpy.wait(5000));
+    QTest::qWait(50);
+    QCOMPARE(iconReadySpy.count(), 1);
+    QCOMPARE(iconReadySpy.first().at(0).toString(), m_imagePath);
+    QVERIFY(!extractor.cachedIcon(m_imagePath).isNull());
+    
+    // 已缓存的图标不再加载
+    extractor.requestIcon(m_imagePath, QSize(48, 48));
+    QTest::qWait(50);
+    QCOMPARE(iconReadySpy.count(), 1);
+}
+
+void TestIconExtractor::testSystemIconResolvedOnGuiThread()
+{
+    const QString toolPath = m_tempDir->path() + "/tool.sh";
+    QFile tool(toolPath);
+    QVERIFY(tool.open(QIODevice::WriteOnly));
+    tool.close();
+    
+    // 系统文件图标不在工作线程中栅格化
+    QVERIFY(IconExtractor::renderIcon(toolPath, QSize(32, 32)).isNull());
+    
+#ifdef Q_OS_WIN
+    QSKIP("Windows上的文件图标在工作线程中通过Shell解析");
+#endif
+    
+    // 请求时在GUI线程中同步解析，不再提交到线程池
+    IconExtractor extractor;
+    QSignalSpy iconReadySpy(&extractor, &IconExtractor::iconReady);
+    QVERIFY(!extractor.requestIcon(toolPath, QSize(32, 32)).isNull());
+    QVERIFY(!extractor.cachedIcon(toolPath).isNull());
+    QTest::qWait(50);
+    QCOMPARE(iconReadySpy.count(), 0);
+}
+
+void TestIconExtractor::testFindThemeIconFile()
+{
+    // 一个继承hicolor的主题，只有48x48的图标，hicolor提供32x32的图标
+    const QString themeRoot = m_tempDir->path() + "/icons";
+    QVERIFY(QDir().mkpath(themeRoot + "/testtheme/48x48/apps"));
+    QVERIFY(QDir().mkpath(themeRoot + "/hicolor/32x32/apps"));
+    QVERIFY(QDir().mkpath(m_tempDir->path() + "/pixmaps"));
+    
+    auto writeFile = [](const QString& path, const QByteArray& content) {
+        QFile file(path);
+        return file.open(QIODevice::WriteOnly) && file.write(content) == content.size();
+    };
+    QVERIFY(writeFile(themeRoot + "/testtheme/index.theme",
+                      "[Icon Theme]\nName=Test\nInherits=hicolor\nDirectories=48x48/apps\n\n"
+                      "[48x48/apps]\nSize=48\nType=Fixed\n"));
+    QVERIFY(writeFile(themeRoot + "/hicolor/index.theme",
+                      "[Icon Theme]\nName=Hicolor\nDirectories=32x32/apps\n\n"
+                      "[32x32/apps]\nSize=32\nType=Threshold\n"));
+    QImage image(48, 48, QImage::Format_ARGB32);
+    image.fill(Qt::blue);
+    QVERIFY(image.save(themeRoot + "/testtheme/48x48/apps/test-app.png"));
+    QVERIFY(image.save(themeRoot + "/hicolor/32x32/apps/test-app.png"));
+    QVERIFY(image.save(themeRoot + "/hicolor/32x32/apps/inherited-app.png"));
+    QVERIFY(image.save(m_tempDir->path() + "/pixmaps/loose-app.png"));
+    
+    IconExtractor::ThemeSearch search;
+    search.themeName = "testtheme";
+    search.searchPaths << themeRoot;
+    search.fallbackPaths << m_tempDir->path() + "/pixmaps";
+    
+    // 尺寸匹配的目录优先，当前主题没有时查找继承的主题，最后查找主题之外的目录
+    QCOMPARE(IconExtractor::findThemeIconFile("test-app", 48, search), themeRoot + "/testtheme/48x48/apps/test-app.png");
+    QCOMPARE(IconExtractor::findThemeIconFile("test-app", 32, search), themeRoot + "/hicolor/32x32/apps/test-app.png");
+    QCOMPARE(IconExtractor::findThemeIconFile("inherited-app", 48, search),
+             themeRoot + "/hicolor/32x32/apps/inherited-app.png");
+    QCOMPARE(IconExtractor::findThemeIconFile("loose-app", 48, search), m_tempDir->path() + "/pixmaps/loose-app.png");
+    QVERIFY(IconExtractor::findThemeIconFile("missing-app", 48, search).isEmpty());
+    
+    // 解码在工作线程中完成
+    QImage rendered;
+    QThread* worker = QThread::create([&rendered, search]() {
+        rendered = IconExtractor::renderSystemIcon("test-app", QSize(48, 48), search);
+    });
+    worker->start();
+    QVERIFY(worker->wait(5000));
+    delete worker;
+    QCOMPARE(rendered.size(), QSize(48, 48));
+}
+
+void TestIconExtractor::testThemeIconResolvedOffThread()
+{
+    const QStringList searchPaths = QIcon::themeSearchPaths();
+    const QString themeName = QIcon::themeName();
+    QIcon::setThemeSearchPaths(QStringList() << m_tempDir->path() + "/icons");
+    QIcon::setThemeName("testtheme");
+    
+    // 主题图标名称提交到线程池解析，请求时不阻塞
+    IconExtractor extractor;
+    QSignalSpy iconReadySpy(&extractor, &IconExtractor::iconReady);
+    QVERIFY(extractor.requestIcon("test-app", QSize(48, 48)).isNull());
+    QVERIFY(iconReadySpy.wait(5000));
+    QCOMPARE(iconReadySpy.first().at(0).toString(), QString("test-app"));
+    QVERIFY(!extractor.cachedIcon("test-app").isNull());
+    
+    QIcon::setThemeSearchPaths(searchPaths);
+    QIcon::setThemeName(themeName);
+}
+
+void TestIconExtractor::testExtractIconAsync()
+{
+    IconExtractor extractor;
+    m_extractedPaths.clear();
+    
+    extractor.extractIconAsync(m_imagePath, this, SLOT(onIconExtracted(QString,QIcon)));
+    QTRY_COMPARE(m_extractedPaths, QStringList() << m_imagePath);
+    
+    // 已缓存时同样以排队调用返回
+    extractor.extractIconAsync(m_imagePath, this, "onIconExtracted");
+    QCOMPARE(m_extractedPaths.size(), 1);
+    QTRY_COMPARE(m_extractedPaths.size(), 2);
+}
+
+void TestIconExtractor::testDiskCache()
+{
+    const QString cachePath = m_tempDir->path() + "/icon_cache.db";
+    
+    {
+        IconExtractor extractor;
+        QVERIFY(extractor.enableDiskCache(cachePath));
+        QSignalSpy iconReadySpy(&extractor, &IconExtractor::iconReady);
+        
+        QVERIFY(extractor.requestIcon(m_imagePath, QSize(32, 32)).isNull());
+        QVERIFY(iconReadySpy.wait(5000));
+    }
+    
+    // 新实例（模拟下次启动）直接从磁盘缓存同步得到图标
+    {
+        IconExtractor extractor;
+        QVERIFY(extractor.enableDiskCache(cachePath));
+        QVERIFY(extractor.diskCache()->totalBytes() > 0);
+        
+        QIcon icon = extractor.requestIcon(m_imagePath, QSize(32, 32));
+        QVERIFY(!icon.isNull());
+        QCOMPARE(icon.availableSizes().value(0), QSize(32, 16));
+        
+        // 其他尺寸未缓存
+        extractor.clearCache();
+        QVERIFY(extractor.requestIcon(m_imagePath, QSize(48, 48)).isNull());
+    }
+    
+    // 来源文件修改后缓存失效
+    QImage image(128, 128, QImage::Format_ARGB32);
+    image.fill(Qt::blue);
+    QVERIFY(image.save(m_imagePath));
+    
+    IconDiskCache cache(cachePath);
+    QVERIFY(cache.open());
+    QVERIFY(cache.find(m_imagePath, 32, IconDiskCache::stampFor(m_imagePath)).isNull());
+}
+
+void TestIconExtractor::testDiskCacheEviction()
+{
+    IconDiskCache cache(m_tempDir->path() + "/eviction.db");
+    QVERIFY(cache.open());
+    
+    QImage image(64, 64, QImage::Format_ARGB32);
+    image.fill(Qt::green);
+    QByteArray png;
+    QBuffer buffer(&png);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(image.save(&buffer, "PNG"));
+    
+    // 超出上限后淘汰最早使用的条目
+    cache.setMaxBytes(png.size() * 3);
+    for (int i = 0; i < 5; ++i) {
+        cache.insert(QString("/icons/%1.png").arg(i), 64, IconStamp(), png);
+        QVERIFY(cache.flush());
+        QTest::qWait(2);
+    }
+    
+    QVERIFY(cache.totalBytes() <= cache.maxBytes());
+    QVERIFY(cache.find("/icons/0.png", 64, IconStamp()).isNull());
+    QVERIFY(!cache.find("/icons/4.png", 64, IconStamp()).isNull());
+    
+    QVERIFY(cache.clear());
+    QCOMPARE(cache.totalBytes(), qint64(0));
+}
+
+void TestIconExtractor::testDiskCacheEvictionWithinBatch()
+{
+    IconDiskCache cache(m_tempDir->path() + "/eviction_batch.db");
+    QVERIFY(cache.open());
+    
+    QImage image(64, 64, QImage::Format_ARGB32);
+    image.fill(Qt::yellow);
+    QByteArray png;
+    QBuffer buffer(&png);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(image.save(&buffer, "PNG"));
+    
+    // 一次flush写入的条目使用时间相同，只按写入顺序淘汰到上限的90%
+    cache.setMaxBytes(png.size() * 5);
+    for (int i = 0; i < 8; ++i) {
+        cache.insert(QString("/batch/%1.png").arg(i), 64, IconStamp(), png);
+    }
+    QVERIFY(cache.flush());
+    
+    QCOMPARE(cache.totalBytes(), qint64(png.size()) * 4);
+    QVERIFY(cache.find("/batch/0.png", 64, IconStamp()).isNull());
+    QVERIFY(cache.find("/batch/3.png", 64, IconStamp()).isNull());
+    QVERIFY(!cache.find("/batch/4.png", 64, IconStamp()).isNull());
+    QVERIFY(!cache.find("/batch/7.png", 64, IconStamp()).isNull());
+}
+
+void TestIconExtractor::onIconExtracted(const QString& filePath, const QIcon& icon)
+{
+    QVERIFY(!icon.isNull());
+    m_extractedPaths << filePath;
+}
+
+void TestIconExtractor::cleanupTestCase()
+{
+    delete m_tempDir;
+}
+
+QTEST_MAIN(TestIconExtractor)
+#include "TestIconExtractor.moc"
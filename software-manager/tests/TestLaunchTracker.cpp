@@ -0,0 +1,149 @@
+#include <QtTest/QtTest>
+#include "../src/core/LaunchTracker.hpp"
+#include "../src/core/DatabaseExecutor.hpp"
+#include "TestHelpers.hpp"
+#include <QSignalSpy>
+
+class TestLaunchTracker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDecay();
+    void testFrequencyAndRecency();
+    void testPersistence();
+    void testRemovedSoftware();
+
+private:
+    static const qint64 Day = 24LL * 60 * 60 * 1000;
+};
+
+void TestLaunchTracker::testDecay()
+{
+    LaunchTracker tracker(nullptr);
+    QSignalSpy spy(&tracker, &LaunchTracker::launchRecorded);
+    const qint64 start = QDateTime::currentMSecsSinceEpoch();
+    
+    tracker.recordLaunch("app", start);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(tracker.stats("app").launchCount, 1);
+    QCOMPARE(tracker.stats("app").lastLaunched, start);
+    
+    // 每次启动贡献1，每过14天减半
+    QVERIFY(qAbs(tracker.score("app", start) - 1.0) < 1e-6);
+    QVERIFY(qAbs(tracker.score("app", start + 14 * Day) - 0.5) < 1e-6);
+    
+    tracker.recordLaunch("app", start);
+    QVERIFY(qAbs(tracker.score("app", start) - 2.0) < 1e-6);
+    
+    // 未启动过的软件
+    QCOMPARE(tracker.frecency("missing"), 0.0);
+    QCOMPARE(tracker.score("missing", start), 0.0);
+}
+
+void TestLaunchTracker::testFrequencyAndRecency()
+{
+    LaunchTracker tracker(nullptr);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    
+    // 三个月前频繁使用，不如今天用过两次
+    for (int i = 0; i < 10; ++i) {
+        tracker.recordLaunch("old", now - 90 * Day);
+    }
+    tracker.recordLaunch("recent", now);
+    tracker.recordLaunch("recent", now);
+    QVERIFY(tracker.frecency("recent") > tracker.frecency("old"));
+    
+    // 昨天用过十次，超过今天用过两次
+    for (int i = 0; i < 10; ++i) {
+        tracker.recordLaunch("frequent", now - Day);
+    }
+    QVERIFY(tracker.frecency("frequent") > tracker.frecency("recent"));
+    
+    // 排序键与当前时间无关，任何时刻的衰减得分顺序都相同
+    QVERIFY(tracker.score("frequent", now + 100 * Day) > tracker.score("recent", now + 100 * Day));
+    QVERIFY(tracker.score("recent", now + 100 * Day) > tracker.score("old", now + 100 * Day));
+}
+
+void TestLaunchTracker::testPersistence()
+{
+    DatabaseExecutor executor;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    
+    // 统计随软件项删除，测试结束时不留下记录
+    QList<SoftwareItem> items;
+    items << testSoftwareItem("launch-test-1", "Launch Test 1") << testSoftwareItem("launch-test-2", "Launch Test 2");
+    QVERIFY(executor.run([items](DatabaseManager& databaseManager) {
+        bool success = databaseManager.isDatabaseValid();
+        for (const SoftwareItem& item : items) {
+            databaseManager.removeSoftwareItem(item.getId());
+            success = databaseManager.addSoftwareItem(item) && success;
+        }
+        return success;
+    }).result());
+    
+    {
+        LaunchTracker tracker(&executor);
+        tracker.load();
+        tracker.recordLaunch("launch-test-1", now - Day);
+        tracker.recordLaunch("launch-test-2", now);
+        tracker.recordLaunch("launch-test-2", now);
+        
+        // 写入延迟进行，flush后提交给数据库线程
+        tracker.flush();
+    }
+    
+    // 加载在数据库线程中排在写入之后，结果以排队方式回到当前线程
+    LaunchTracker reloaded(&executor);
+    reloaded.load();
+    QTRY_COMPARE(reloaded.stats("launch-test-2").launchCount, 2);
+    QCOMPARE(reloaded.stats("launch-test-2").lastLaunched, now);
+    QVERIFY(reloaded.frecency("launch-test-2") > reloaded.frecency("launch-test-1"));
+    
+    QStringList frecent = executor.run([](DatabaseManager& databaseManager) {
+        return databaseManager.getFrecentSoftwareIds(1000);
+    }).result();
+    QVERIFY(frecent.indexOf("launch-test-2") >= 0);
+    QVERIFY(frecent.indexOf("launch-test-2") < frecent.indexOf("launch-test-1"));
+    QCOMPARE(executor.run([](DatabaseManager& databaseManager) {
+        return databaseManager.getFrecentSoftwareIds(1).size();
+    }).result(), 1);
+    
+    QVERIFY(executor.run([items](DatabaseManager& databaseManager) {
+        bool success = true;
+        for (const SoftwareItem& item : items) {
+            success = databaseManager.removeSoftwareItem(item.getId()) && success;
+        }
+        return success;
+    }).result());
+}
+
+void TestLaunchTracker::testRemovedSoftware()
+{
+    DatabaseExecutor executor;
+    
+    SoftwareItem item = testSoftwareItem("launch-test-removed", "Removed App");
+    QVERIFY(executor.run([item](DatabaseManager& databaseManager) {
+        databaseManager.removeSoftwareItem(item.getId());
+        return databaseManager.addSoftwareItem(item);
+    }).result());
+    
+    // 销毁时提交尚未保存的统计
+    {
+        LaunchTracker tracker(&executor);
+        tracker.recordLaunch(item.getId());
+    }
+    auto isFrecent = [&executor, item]() {
+        return executor.run([item](DatabaseManager& databaseManager) {
+            return databaseManager.getFrecentSoftwareIds(1000).contains(item.getId());
+        }).result();
+    };
+    QVERIFY(isFrecent());
+    
+    // 删除软件项时触发器一并删除启动统计
+    QVERIFY(executor.removeSoftwareItemAsync(item.getId()).result());
+    QVERIFY(!isFrecent());
+}
+
+QTEST_MAIN(TestLaunchTracker)
+#include "TestLaunchTracker.moc"
@@ -0,0 +1,227 @@
+#include <QtTest/QtTest>
+#include "../src/core/SearchIndex.hpp"
+#include "../src/core/LaunchTracker.hpp"
+#include "TestHelpers.hpp"
+#include <QElapsedTimer>
+
+class TestSearchIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSearchFields();
+    void testMultipleTerms();
+    void testShortTerms();
+    void testRanking();
+    void testIncrementalUpdates();
+    void testLargeCatalog();
+    void testFuzzySearch();
+    void testFuzzySearchLargeCatalog();
+    void testLaunchRanking();
+
+private:
+    static QStringList names(const QList<SoftwareItem>& items);
+};
+
+QStringList TestSearchIndex::names(const QList<SoftwareItem>& items)
+{
+    QStringList result;
+    for (const SoftwareItem& item : items) {
+        result << item.getName();
+    }
+    return result;
+}
+
+void TestSearchIndex::testSearchFields()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Firefox", "未分类", "/usr/share/applications/firefox.desktop", "Web Browser")
+                           << testSoftwareItem("2", "Visual Studio Code", "未分类", "/usr/share/applications/code.desktop", "Code Editor")
+                           << testSoftwareItem("3", "文本编辑器", "未分类", "/usr/share/applications/org.gnome.gedit.desktop", "编辑文本文件"));
+    QCOMPARE(index.size(), 3);
+    
+    // 名称、描述和文件名都参与匹配，不区分大小写
+    QCOMPARE(names(index.search("FIRE")), QStringList() << "Firefox");
+    QCOMPARE(names(index.search("browser")), QStringList() << "Firefox");
+    QCOMPARE(names(index.search("gedit")), QStringList() << "文本编辑器");
+    QCOMPARE(names(index.search("编辑器")), QStringList() << "文本编辑器");
+    
+    // 目录名不参与匹配
+    QVERIFY(index.search("applications").isEmpty());
+    QVERIFY(index.search("chrome").isEmpty());
+    QVERIFY(index.search("   ").isEmpty());
+}
+
+void TestSearchIndex::testMultipleTerms()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Visual Studio Code", "未分类", "/opt/code/code")
+                           << testSoftwareItem("2", "Visual Studio", "未分类", "/opt/vs/devenv.exe")
+                           << testSoftwareItem("3", "Android Studio", "未分类", "/opt/android-studio/studio.sh"));
+    
+    QCOMPARE(names(index.search("studio visual")), QStringList() << "Visual Studio" << "Visual Studio Code");
+    QCOMPARE(names(index.search("studio code")), QStringList() << "Visual Studio Code");
+    QVERIFY(index.search("studio missing").isEmpty());
+}
+
+void TestSearchIndex::testShortTerms()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "GIMP", "未分类", "/usr/bin/gimp")
+                           << testSoftwareItem("2", "VLC", "未分类", "/usr/bin/vlc")
+                           << testSoftwareItem("3", "vi", "未分类", "/usr/bin/vi"));
+    
+    // 少于三个字符的关键字逐项检查
+    QCOMPARE(names(index.search("vi")), QStringList() << "vi");
+    QCOMPARE(names(index.search("v")), QStringList() << "vi" << "VLC");
+    QCOMPARE(names(index.search("g vlc")), QStringList());
+}
+
+void TestSearchIndex::testRanking()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Terminal", "未分类", "/usr/bin/xterm", "Use the command line")
+                           << testSoftwareItem("2", "Command Prompt", "未分类", "/c/cmd.exe")
+                           << testSoftwareItem("3", "My Command Tool", "未分类", "/opt/tool"));
+    
+    // 名称前缀匹配优先，其次是名称包含，最后是描述匹配
+    QCOMPARE(names(index.search("command")),
+             QStringList() << "Command Prompt" << "My Command Tool" << "Terminal");
+    QCOMPARE(names(index.search("command", 1)), QStringList() << "Command Prompt");
+    QVERIFY(index.search("command", 0).isEmpty());
+}
+
+void TestSearchIndex::testIncrementalUpdates()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Firefox", "未分类", "/opt/firefox/firefox")
+                           << testSoftwareItem("2", "Thunderbird", "未分类", "/opt/thunderbird/thunderbird"));
+    
+    index.addSoftwareItem(testSoftwareItem("3", "Fire Tool", "未分类", "/opt/tools/fire"));
+    QCOMPARE(names(index.search("fire")), QStringList() << "Fire Tool" << "Firefox");
+    
+    // 更新后旧名称不再匹配
+    index.updateSoftwareItem(testSoftwareItem("3", "Flame Tool", "未分类", "/opt/tools/flame"));
+    QCOMPARE(names(index.search("fire")), QStringList() << "Firefox");
+    QCOMPARE(names(index.search("flame")), QStringList() << "Flame Tool");
+    QCOMPARE(index.size(), 3);
+    
+    index.removeSoftwareItem("1");
+    QVERIFY(index.search("firefox").isEmpty());
+    
+    index.removeSoftwareItemsByFilePaths(QStringList() << "/opt/thunderbird/thunderbird");
+    QVERIFY(index.search("thunder").isEmpty());
+    QCOMPARE(index.size(), 1);
+    
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    QVERIFY(index.search("flame").isEmpty());
+}
+
+void TestSearchIndex::testLargeCatalog()
+{
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 10000; ++i) {
+        items << testSoftwareItem(QString::number(i), QString("Application %1").arg(i), "未分类",
+                                  QString("/opt/apps/app%1/run").arg(i), QString("Description of tool %1").arg(i));
+    }
+    
+    SearchIndex index;
+    index.setSoftwareItems(items);
+    
+    QElapsedTimer timer;
+    timer.start();
+    QList<SoftwareItem> results = index.search("application 4242");
+    qint64 elapsed = timer.nsecsElapsed();
+    
+    QCOMPARE(names(results), QStringList() << "Application 4242");
+    qInfo() << "10000项中搜索耗时(微秒):" << elapsed / 1000;
+    
+    // 删除大量软件项后自动压缩，结果保持正确
+    for (int i = 0; i < 6000; ++i) {
+        index.removeSoftwareItem(QString::number(i));
+    }
+    QCOMPARE(index.size(), 4000);
+    QVERIFY(index.search("application 4242").isEmpty());
+    QCOMPARE(index.search("application 9999").size(), 1);
+}
+
+void TestSearchIndex::testFuzzySearch()
+{
+    SearchIndex index;
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Visual Studio Code", "未分类", "/opt/code/code")
+                           << testSoftwareItem("2", "Firefox", "未分类", "/opt/firefox/firefox")
+                           << testSoftwareItem("3", "Diff Viewer", "未分类", "/opt/diff/viewer")
+                           << testSoftwareItem("4", "Visual Studio", "未分类", "/opt/vs/devenv.exe"));
+    
+    // 缩写按顺序匹配名称中的字符
+    QCOMPARE(names(index.fuzzySearch("vsc")), QStringList() << "Visual Studio Code");
+    
+    // 单词开头的匹配排在前面
+    QCOMPARE(names(index.fuzzySearch("ff")), QStringList() << "Firefox" << "Diff Viewer");
+    QCOMPARE(names(index.fuzzySearch("ff", 1)), QStringList() << "Firefox");
+    
+    // 多个关键字都必须匹配
+    QCOMPARE(names(index.fuzzySearch("vis cod")), QStringList() << "Visual Studio Code");
+    QVERIFY(index.fuzzySearch("zzz").isEmpty());
+    QVERIFY(index.fuzzySearch("vsc", 0).isEmpty());
+    
+    // 删除后不再出现在结果中
+    index.removeSoftwareItem("1");
+    QVERIFY(index.fuzzySearch("vsc").isEmpty());
+}
+
+void TestSearchIndex::testFuzzySearchLargeCatalog()
+{
+    static const QStringList words = QStringList() << "Visual" << "Studio" << "Code" << "Fire" << "Fox"
+                                                   << "Media" << "Player" << "Office" << "Writer" << "Terminal";
+    
+    QList<SoftwareItem> items;
+    for (int i = 0; i < 20000; ++i) {
+        QString name = QString("%1 %2 %3").arg(words.at(i % words.size()), words.at((i / 10) % words.size()),
+                                               words.at((i / 100) % words.size()));
+        items << testSoftwareItem(QString::number(i), name + QString(" %1").arg(i), "未分类", QString("/opt/apps/app%1").arg(i));
+    }
+    
+    SearchIndex index;
+    index.setSoftwareItems(items);
+    
+    QElapsedTimer timer;
+    timer.start();
+    QList<SoftwareItem> results;
+    for (const QString& keyword : QStringList() << "v" << "vs" << "vsc" << "vsco") {
+        results = index.fuzzySearch(keyword, 200);
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    
+    QCOMPARE(results.size(), 200);
+    QVERIFY(results.first().getName().startsWith("Visual Studio Code"));
+    qInfo() << "20000项中每次按键的模糊搜索耗时(微秒):" << elapsed / 4 / 1000;
+}
+
+void TestSearchIndex::testLaunchRanking()
+{
+    LaunchTracker tracker(nullptr);
+    SearchIndex index;
+    index.setLaunchTracker(&tracker);
+    index.setSoftwareItems(QList<SoftwareItem>()
+                           << testSoftwareItem("1", "Code Editor", "未分类", "/opt/editor/editor")
+                           << testSoftwareItem("2", "Code Viewer", "未分类", "/opt/viewer/viewer"));
+    
+    QCOMPARE(names(index.fuzzySearch("code")), QStringList() << "Code Editor" << "Code Viewer");
+    QCOMPARE(names(index.search("code")), QStringList() << "Code Editor" << "Code Viewer");
+    
+    // 匹配程度相同时常用的软件在前
+    tracker.recordLaunch("2");
+    QCOMPARE(names(index.fuzzySearch("code")), QStringList() << "Code Viewer" << "Code Editor");
+    QCOMPARE(names(index.search("code")), QStringList() << "Code Viewer" << "Code Editor");
+}
+
+QTEST_MAIN(TestSearchIndex)
+#include "TestSearchIndex.moc"
@@ -11,6 +11,7 @@ private slots:
     void initTestCase();
     void testDefaultConstructor();
     void testFilePathConstructor();
+    void testDesktopEntryFile();
     void testGettersAndSetters();
     void testValidation();
     void testSerialization();
@@ -62,6 +63,37 @@ void TestSoftwareItem::testFilePathConstructor()
     QVERIFY(item.getUpdatedAt().isValid());
 }
 
+void TestSoftwareItem::testDesktopEntryFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    
+    // .desktop文件使用其中声明的名称、说明和分类
+    QString filePath = tempDir.path() + "/editor.desktop";
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("[Desktop Entry]\nType=Application\nName=Code Editor\n"
+               "Comment=Edit source code\nExec=editor %F\nIcon=accessories-text-editor\n"
+               "Categories=Development;IDE;\n");
+    file.close();
+    
+    SoftwareItem item(filePath);
+    QVERIFY(item.isValid());
+    QCOMPARE(item.getName(), QString("Code Editor"));
+    QCOMPARE(item.getDescription(), QString("Edit source code"));
+    QCOMPARE(item.getCategory(), QString("开发工具"));
+    QCOMPARE(item.getIconKey(), QString("accessories-text-editor"));
+    
+    // 不显示的条目不是有效的软件项
+    QString hiddenPath = tempDir.path() + "/helper.desktop";
+    QFile hiddenFile(hiddenPath);
+    QVERIFY(hiddenFile.open(QIODevice::WriteOnly));
+    hiddenFile.write("[Desktop Entry]\nType=Application\nName=Helper\nNoDisplay=true\n");
+    hiddenFile.close();
+    
+    QVERIFY(!SoftwareItem(hiddenPath).isValid());
+}
+
 void TestSoftwareItem::testGettersAndSetters()
 {
     SoftwareItem item;
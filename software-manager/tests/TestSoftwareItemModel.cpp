@@ -0,0 +1,197 @@
+#include <QtTest/QtTest>
+#include "../src/model/SoftwareItemModel.hpp"
+#include "../src/utils/IconExtractor.hpp"
+#include "TestHelpers.hpp"
+#include <QSignalSpy>
+#include <QIcon>
+
+class TestSoftwareItemModel : public QObject
+{
+    Q_OBJECT
+    
+private slots:
+    void testSetSoftwareItems();
+    void testAddSoftwareItem();
+    void testAppendSoftwareItems();
+    void testRemoveSoftwareItem();
+    void testRemoveSoftwareItemsByFilePaths();
+    void testUpdateSoftwareItem();
+    void testColumns();
+    void testDecorationRole();
+    
+private:
+    static QList<SoftwareItem> makeItems(int count);
+};
+
+QList<SoftwareItem> TestSoftwareItemModel::makeItems(int count)
+{
+    QList<SoftwareItem> items;
+    for (int i = 0; i < count; ++i) {
+        items.append(testSoftwareItem(QString("id-%1").arg(i), QString("App %1").arg(i)));
+    }
+    return items;
+}
+
+void TestSoftwareItemModel::testSetSoftwareItems()
+{
+    SoftwareItemModel model;
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    model.setSoftwareItems(makeItems(10000));
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 10000);
+    QCOMPARE(model.rowForId("id-9999"), 9999);
+    QCOMPARE(model.index(42, 0).data(Qt::DisplayRole).toString(), QString("App 42"));
+    QCOMPARE(model.index(42, 0).data(SoftwareItemModel::SoftwareIdRole).toString(), QString("id-42"));
+    QCOMPARE(model.index(42, 0).data(SoftwareItemModel::FilePathRole).toString(), QString("/opt/test/id-42"));
+    
+    model.clearAllItems();
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.rowForId("id-1"), -1);
+}
+
+void TestSoftwareItemModel::testAddSoftwareItem()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(3));
+    QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    model.addSoftwareItem(testSoftwareItem("new", "New App"));
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.first().at(1).toInt(), 3);
+    QCOMPARE(insertSpy.first().at(2).toInt(), 3);
+    QCOMPARE(model.rowForId("new"), 3);
+}
+
+void TestSoftwareItemModel::testAppendSoftwareItems()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(3));
+    QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    QList<SoftwareItem> page;
+    page << testSoftwareItem("page-1", "Page App 1") << testSoftwareItem("page-2", "Page App 2");
+    model.appendSoftwareItems(page);
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.first().at(1).toInt(), 3);
+    QCOMPARE(insertSpy.first().at(2).toInt(), 4);
+    QCOMPARE(model.rowForId("page-2"), 4);
+    QCOMPARE(model.softwareItems().size(), 5);
+    
+    // 空页不发出信号
+    model.appendSoftwareItems(QList<SoftwareItem>());
+    QCOMPARE(insertSpy.count(), 1);
+}
+
+void TestSoftwareItemModel::testRemoveSoftwareItem()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(5));
+    QSignalSpy removeSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    // 移除一项只影响一行，后面的行号随之前移
+    model.removeSoftwareItem("id-1");
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(removeSpy.first().at(1).toInt(), 1);
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.rowForId("id-1"), -1);
+    QCOMPARE(model.rowForId("id-4"), 3);
+    
+    // 不存在的ID不发出信号
+    model.removeSoftwareItem("missing");
+    QCOMPARE(removeSpy.count(), 1);
+}
+
+void TestSoftwareItemModel::testRemoveSoftwareItemsByFilePaths()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(5));
+    QSignalSpy removeSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    // 扫描删除的路径逐段移除，不重置模型
+    model.removeSoftwareItemsByFilePaths(QStringList() << "/opt/test/id-1" << "/opt/test/id-3" << "/opt/test/missing");
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(removeSpy.count(), 2);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.rowForId("id-1"), -1);
+    QCOMPARE(model.rowForId("id-3"), -1);
+    QCOMPARE(model.rowForId("id-4"), 2);
+    
+    // 相邻的行合并为一次信号，从后向前发出
+    model.setSoftwareItems(makeItems(8));
+    removeSpy.clear();
+    model.removeSoftwareItemsByFilePaths(QStringList() << "/opt/test/id-1" << "/opt/test/id-2" << "/opt/test/id-3"
+                                                       << "/opt/test/id-6");
+    QCOMPARE(removeSpy.count(), 2);
+    QCOMPARE(removeSpy.at(0).at(1).toInt(), 6);
+    QCOMPARE(removeSpy.at(0).at(2).toInt(), 6);
+    QCOMPARE(removeSpy.at(1).at(1).toInt(), 1);
+    QCOMPARE(removeSpy.at(1).at(2).toInt(), 3);
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.rowForId("id-0"), 0);
+    QCOMPARE(model.rowForId("id-4"), 1);
+    QCOMPARE(model.rowForId("id-7"), 3);
+    
+    // 图标索引随行号前移，图标到达时刷新的是新的行
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+    emit IconExtractor::instance()->iconReady("/opt/test/id-7", QIcon());
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().at(0).toModelIndex(), model.index(3, SoftwareItemModel::NameColumn));
+}
+
+void TestSoftwareItemModel::testUpdateSoftwareItem()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(5));
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+    
+    SoftwareItem item = model.softwareItemAt(2);
+    item.setName("Renamed");
+    model.updateSoftwareItem(item);
+    
+    // 只有这一行的各列发生变化
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().at(0).toModelIndex(), model.index(2, 0));
+    QCOMPARE(changedSpy.first().at(1).toModelIndex(), model.index(2, SoftwareItemModel::ColumnCount - 1));
+    QCOMPARE(model.index(2, 0).data(Qt::DisplayRole).toString(), QString("Renamed"));
+}
+
+void TestSoftwareItemModel::testColumns()
+{
+    SoftwareItemModel model;
+    SoftwareItem item = testSoftwareItem("id", "Editor");
+    item.setVersion("1.2");
+    item.setDescription("Text editor");
+    model.setSoftwareItems(QList<SoftwareItem>() << item);
+    
+    QCOMPARE(model.columnCount(), int(SoftwareItemModel::ColumnCount));
+    QCOMPARE(model.headerData(SoftwareItemModel::NameColumn, Qt::Horizontal).toString(), QString("名称"));
+    QCOMPARE(model.index(0, SoftwareItemModel::CategoryColumn).data().toString(), QString("未分类"));
+    QCOMPARE(model.index(0, SoftwareItemModel::PathColumn).data().toString(), QString("/opt/test/id"));
+    QCOMPARE(model.index(0, SoftwareItemModel::VersionColumn).data().toString(), QString("1.2"));
+    QCOMPARE(model.index(0, SoftwareItemModel::DescriptionColumn).data().toString(), QString("Text editor"));
+    
+    // 自定义角色与列无关，图标只在名称列提供
+    QCOMPARE(model.index(0, SoftwareItemModel::PathColumn).data(SoftwareItemModel::SoftwareIdRole).toString(), QString("id"));
+    QVERIFY(!model.index(0, SoftwareItemModel::PathColumn).data(Qt::DecorationRole).isValid());
+}
+
+void TestSoftwareItemModel::testDecorationRole()
+{
+    SoftwareItemModel model;
+    model.setSoftwareItems(makeItems(1));
+    
+    // 未加载的图标先返回占位图标
+    QIcon icon = qvariant_cast<QIcon>(model.index(0, 0).data(Qt::DecorationRole));
+    QVERIFY(!icon.isNull());
+}
+
+QTEST_MAIN(TestSoftwareItemModel)
+#include "TestSoftwareItemModel.moc"
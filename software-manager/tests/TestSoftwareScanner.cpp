@@ -17,6 +17,10 @@ private slots:
     void testSetScanPaths();
     void testIsCurrentlyScanning();
     void testScanSystemSoftware();
+    void testParallelScan();
+    void testIncrementalScan();
+    void testScanChangedDirectories();
+    void testHiddenDesktopEntryRemoved();
     void cleanupTestCase();
 
 private:
@@ -156,6 +160,216 @@ void TestSoftwareScanner::testScanSystemSoftware()
     // 注意：完整扫描测试需要更多设置和mock数据
 }
 
+void TestSoftwareScanner::testParallelScan()
+{
+    // 构造多层目录树，验证并行扫描结果完整且顺序确定
+    QString root = m_tempDir->path() + "/parallel_scan";
+    QStringList expectedPaths;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            QString dirPath = QString("%1/dir_%2/sub_%3").arg(root).arg(i).arg(j);
+            QVERIFY(QDir().mkpath(dirPath));
+            
+            QString filePath = dirPath + QString("/app_%1_%2.exe").arg(i).arg(j);
+            QFile file(filePath);
+            QVERIFY(file.open(QIODevice::WriteOnly));
+            file.close();
+            expectedPaths << filePath;
+        }
+    }
+    expectedPaths.sort();
+    
+    SoftwareScanner scanner;
+    scanner.setScanPaths(QStringList() << root);
+    
+    QSignalSpy scanFinishedSpy(&scanner, &SoftwareScanner::scanFinished);
+    QSignalSpy scanProgressSpy(&scanner, &SoftwareScanner::scanProgress);
+    
+    scanner.scanSystemSoftware();
+    QVERIFY(scanFinishedSpy.wait(10000));
+    
+    // 检查结果数量和顺序
+    QList<SoftwareItem> items = scanFinishedSpy.takeFirst().at(0).value<QList<SoftwareItem>>();
+    QStringList scannedPaths;
+    for (const SoftwareItem& item : items) {
+        scannedPaths << item.getFilePath();
+    }
+    QCOMPARE(scannedPaths, expectedPaths);
+    
+    // 进度应在结束前达到100%，扫描状态随后复位
+    QVERIFY(!scanProgressSpy.isEmpty());
+    QCOMPARE(scanProgressSpy.last().at(0).toInt(), 100);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+}
+
+void TestSoftwareScanner::testIncrementalScan()
+{
+    QString root = m_tempDir->path() + "/incremental_scan";
+    QVERIFY(QDir().mkpath(root + "/tools"));
+    QStringList filePaths;
+    filePaths << root + "/first.exe" << root + "/tools/second.exe";
+    for (const QString& filePath : filePaths) {
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.close();
+    }
+    
+    SoftwareScanner scanner;
+    scanner.setScanPaths(QStringList() << root);
+    
+    // 首次扫描：所有软件都是新增
+    QSignalSpy scanDeltaSpy(&scanner, &SoftwareScanner::scanDelta);
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    ScanDelta delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QCOMPARE(delta.addedItems.size(), 2);
+    QCOMPARE(delta.changedSnapshots.size(), 2);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    
+    // 把快照时间推后，模拟距上次扫描已有一段时间
+    QList<DirectorySnapshot> snapshots = scanner.directorySnapshots();
+    for (DirectorySnapshot& snapshot : snapshots) {
+        snapshot.scannedAt += 60000;
+    }
+    scanner.setDirectorySnapshots(snapshots);
+    
+    // 未变化的系统：不重新枚举任何目录，也没有变化
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QVERIFY(delta.addedItems.isEmpty());
+    QVERIFY(delta.modifiedItems.isEmpty());
+    QVERIFY(delta.removedFilePaths.isEmpty());
+    QVERIFY(delta.changedSnapshots.isEmpty());
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    
+    // 修改时间相同但目录项数量不同的目录重新枚举（修改时间精度不足时漏掉的增删）
+    snapshots = scanner.directorySnapshots();
+    for (DirectorySnapshot& snapshot : snapshots) {
+        if (snapshot.path == root + "/tools") {
+            snapshot.entryCount += 1;
+        }
+    }
+    scanner.setDirectorySnapshots(snapshots);
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QVERIFY(delta.addedItems.isEmpty());
+    QVERIFY(delta.removedFilePaths.isEmpty());
+    QCOMPARE(delta.changedSnapshots.size(), 1);
+    QCOMPARE(delta.changedSnapshots.first().path, root + "/tools");
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    
+    // 删除子目录中的软件并新增一个软件，只报告这两处变化
+    QTest::qWait(20);
+    QVERIFY(QFile::remove(root + "/tools/second.exe"));
+    QFile newFile(root + "/tools/third.exe");
+    QVERIFY(newFile.open(QIODevice::WriteOnly));
+    newFile.close();
+    
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QCOMPARE(delta.addedItems.size(), 1);
+    QCOMPARE(delta.addedItems.first().getFilePath(), root + "/tools/third.exe");
+    QCOMPARE(delta.removedFilePaths, QStringList() << root + "/tools/second.exe");
+    QCOMPARE(delta.changedSnapshots.size(), 1);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+}
+
+void TestSoftwareScanner::testScanChangedDirectories()
+{
+    QString root = m_tempDir->path() + "/changed_scan";
+    QVERIFY(QDir().mkpath(root + "/tools"));
+    QVERIFY(QDir().mkpath(root + "/games"));
+    QStringList filePaths;
+    filePaths << root + "/first.exe" << root + "/tools/second.exe" << root + "/games/third.exe";
+    for (const QString& filePath : filePaths) {
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.close();
+    }
+    
+    SoftwareScanner scanner;
+    scanner.setScanPaths(QStringList() << root);
+    
+    QSignalSpy scanDeltaSpy(&scanner, &SoftwareScanner::scanDelta);
+    QSignalSpy scanFinishedSpy(&scanner, &SoftwareScanner::scanFinished);
+    QSignalSpy softwareChangedSpy(&scanner, &SoftwareScanner::softwareChanged);
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    scanDeltaSpy.clear();
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    QCOMPARE(scanFinishedSpy.count(), 1);
+    
+    // 删除一个子目录、新建一个带软件的子目录
+    QVERIFY(QDir(root + "/tools").removeRecursively());
+    QVERIFY(QDir().mkpath(root + "/office"));
+    QFile newFile(root + "/office/fourth.exe");
+    QVERIFY(newFile.open(QIODevice::WriteOnly));
+    newFile.close();
+    
+    // 只重新扫描变化的根目录：新目录被完整扫描，未变化的子目录不再枚举
+    scanner.scanDirectories(QStringList() << root << root + "/office");
+    QVERIFY(scanDeltaSpy.wait(10000));
+    ScanDelta delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QCOMPARE(delta.addedItems.size(), 1);
+    QCOMPARE(delta.addedItems.first().getFilePath(), root + "/office/fourth.exe");
+    QVERIFY(delta.modifiedItems.isEmpty());
+    QCOMPARE(delta.removedFilePaths, QStringList() << root + "/tools/second.exe");
+    QCOMPARE(delta.removedDirectories, QStringList() << root + "/tools");
+    QCOMPARE(delta.changedSnapshots.size(), 2);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    
+    // 监视触发的扫描不报告为完整扫描
+    QCOMPARE(scanFinishedSpy.count(), 1);
+    QCOMPARE(softwareChangedSpy.count(), 1);
+    
+    QStringList snapshotPaths;
+    for (const DirectorySnapshot& snapshot : scanner.directorySnapshots()) {
+        snapshotPaths << snapshot.path;
+    }
+    snapshotPaths.sort();
+    QCOMPARE(snapshotPaths, QStringList() << root << root + "/games" << root + "/office");
+}
+
+void TestSoftwareScanner::testHiddenDesktopEntryRemoved()
+{
+#if !defined(Q_OS_UNIX) || defined(Q_OS_MAC)
+    QSKIP(".desktop文件只在Linux上扫描");
+#endif
+    QString root = m_tempDir->path() + "/hidden_desktop_scan";
+    QVERIFY(QDir().mkpath(root));
+    const QString filePath = root + "/editor.desktop";
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("[Desktop Entry]\nType=Application\nName=Editor\nExec=editor\n");
+    file.close();
+    
+    SoftwareScanner scanner;
+    scanner.setScanPaths(QStringList() << root);
+    
+    QSignalSpy scanDeltaSpy(&scanner, &SoftwareScanner::scanDelta);
+    scanner.scanSystemSoftware();
+    QVERIFY(scanDeltaSpy.wait(10000));
+    ScanDelta delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QCOMPARE(delta.addedItems.size(), 1);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+    
+    // 已收录的条目改为不显示后，重新扫描时移除它的软件项
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("[Desktop Entry]\nType=Application\nName=Editor\nExec=editor\nNoDisplay=true\n");
+    file.close();
+    
+    scanner.scanDirectories(QStringList() << root);
+    QVERIFY(scanDeltaSpy.wait(10000));
+    delta = scanDeltaSpy.takeFirst().at(0).value<ScanDelta>();
+    QVERIFY(delta.addedItems.isEmpty());
+    QVERIFY(delta.modifiedItems.isEmpty());
+    QCOMPARE(delta.removedFilePaths, QStringList() << filePath);
+    QTRY_VERIFY(!scanner.isCurrentlyScanning());
+}
+
 void TestSoftwareScanner::cleanupTestCase()
 {
     delete m_scanner;